@@ -40,6 +40,9 @@ UNIT_MULTS = {"KiB": KiB, "MiB": MiB, "GiB": GiB, "TiB": TiB, "PiB": PiB, "EiB":
 # overrides for function prefixes not matching the modules' names
 MOD_FNAME_OVERRIDES = {"mdraid": "md"}
 
+# modules whose plugins implement the bd_*_prewarm_deps() function
+PREWARM_MODULES = {"btrfs", "dm", "fs", "lvm", "mdraid", "mpath", "nvdimm", "s390", "smart", "swap"}
+
 def expand_size_constants(definitions):
     """
     Expand macros that define size constants (e.g. '#define DEFAULT_PE_SIZE (4 MiB)').
@@ -142,7 +145,7 @@ def get_arg_names(args):
 
     return [starred_name.strip("* ") for starred_name in starred_names]
 
-def get_func_boilerplate(fn_info):
+def get_func_boilerplate(fn_info, module_name):
     call_args_str = ", ".join(get_arg_names(fn_info.args))
     args_ann_unused = fn_info.args.replace(",", " G_GNUC_UNUSED,")
 
@@ -171,11 +174,41 @@ def get_func_boilerplate(fn_info):
     # (if any) initialized to the stub
     ret += "static {0.rtype} (*_{0.name}) ({0.args}) = {0.name}_stub;\n\n".format(fn_info)
 
+    # then add a trampoline used in the lazy loading mode that loads the plugin
+    # on the first call and then calls the dynamically loaded function (or the
+    # stub if the plugin or the function failed to load), the reference may be
+    # changed by another thread loading the plugin so it's accessed atomically
+    ret += ("static {0.rtype} {0.name}_lazy ({0.args}) {{\n" +
+            "    {0.rtype} (*fn) ({0.args}) = NULL;\n\n" +
+            "    if (!load_plugin_lazily (BD_PLUGIN_{2}))\n" +
+            "        return {0.name}_stub ({1});\n" +
+            "    * (gpointer*) (&fn) = g_atomic_pointer_get ((gpointer*) &_{0.name});\n" +
+            "    if (fn == {0.name}_lazy)\n" +
+            "        return {0.name}_stub ({1});\n" +
+            "    return fn ({1});\n" +
+            "}}\n\n").format(fn_info, call_args_str, module_name.upper())
+
     # then add a documented function calling the dynamically loaded one via the
-    # reference
+    # reference, with tracing enabled the call is recorded as a trace event
+    # (failed if it set an error)
+    traced_args_str = ", ".join("&l_error" if arg == "error" else arg for arg in get_arg_names(fn_info.args))
     ret += ("{0.doc}{0.rtype} {0.name} ({0.args}) {{\n" +
-            "    return _{0.name} ({1});\n" +
-            "}}\n\n\n").format(fn_info, call_args_str)
+            "    {0.rtype} (*fn) ({0.args}) = NULL;\n" +
+            "    {0.rtype} ret = {3};\n" +
+            "    GError *l_error = NULL;\n" +
+            "    guint64 task_id = 0;\n" +
+            "    gint64 start_time = 0;\n\n" +
+            "    * (gpointer*) (&fn) = g_atomic_pointer_get ((gpointer*) &_{0.name});\n" +
+            "    if (G_LIKELY (!bd_utils_get_tracing ()))\n" +
+            "        return fn ({1});\n\n" +
+            "    task_id = bd_utils_get_next_task_id ();\n" +
+            "    start_time = g_get_monotonic_time ();\n" +
+            "    ret = fn ({2});\n" +
+            "    bd_utils_trace_record (task_id, \"{4}\", \"{0.name}\", start_time, g_get_monotonic_time (), l_error ? -1 : 0);\n" +
+            "    if (l_error)\n" +
+            "        g_propagate_error (error, l_error);\n" +
+            "    return ret;\n" +
+            "}}\n\n\n").format(fn_info, call_args_str, traced_args_str, default_ret, module_name)
 
     return ret
 
@@ -196,7 +229,8 @@ def get_loading_func(fn_infos, module_name):
     ret =  'static gpointer load_{0}_from_plugin(const gchar *so_name) {{\n'.format(module_name)
     ret += '    void *handle = NULL;\n'
     ret += '    char *error = NULL;\n'
-    ret += '    gboolean (*init_fn) (void) = NULL;\n\n'
+    ret += '    gboolean (*init_fn) (void) = NULL;\n'
+    ret += '    gpointer fn = NULL;\n\n'
 
     ret += '    handle = dlopen(so_name, RTLD_LAZY | RTLD_NODELETE);\n'
     ret += '    if (!handle) {\n'
@@ -218,11 +252,12 @@ def get_loading_func(fn_infos, module_name):
     for info in fn_infos:
         # clear any previous error and load the function
         ret += '    dlerror();\n'
-        ret += '    * (void**) (&_{0.name}) = dlsym(handle, "{0.name}");\n'.format(info)
+        ret += '    fn = dlsym(handle, "{0.name}");\n'.format(info)
         ret += '    if ((error = dlerror()) != NULL) {\n'
         ret += '        bd_utils_log_format (BD_UTILS_LOG_WARNING, "failed to load {0.name}: %s", error);\n'.format(info)
-        ret += '        _{0.name} = {0.name}_stub;\n'.format(info)
-        ret += '    }\n\n'
+        ret += '        fn = (gpointer) {0.name}_stub;\n'.format(info)
+        ret += '    }\n'
+        ret += '    g_atomic_pointer_set ((gpointer*) &_{0.name}, fn);\n\n'.format(info)
 
     ret += '    return handle;\n'
     ret += '}\n\n'
@@ -236,7 +271,7 @@ def get_unloading_func(fn_infos, module_name):
 
     # revert the functions to stubs
     for info in fn_infos:
-        ret += '    _{0.name} = {0.name}_stub;\n'.format(info)
+        ret += '    g_atomic_pointer_set ((gpointer*) &_{0.name}, (gpointer) {0.name}_stub);\n'.format(info)
 
     ret += '\n'
     ret += '    dlerror();\n'
@@ -252,6 +287,31 @@ def get_unloading_func(fn_infos, module_name):
 
     return ret
 
+def get_lazy_func(fn_infos, module_name):
+    ret =  'static void set_{0}_lazy (gboolean lazy) {{\n'.format(module_name)
+    # point the functions to the trampolines loading the plugin or back to stubs
+    for info in fn_infos:
+        ret += '    g_atomic_pointer_set ((gpointer*) &_{0.name}, lazy ? (gpointer) {0.name}_lazy : (gpointer) {0.name}_stub);\n'.format(info)
+    ret += '}\n\n'
+
+    return ret
+
+def get_prewarm_func(module_name):
+    ret =  'static void prewarm_{0}_deps (gpointer handle) {{\n'.format(module_name)
+    ret += '    char *error = NULL;\n'
+    ret += '    void (*prewarm_fn) (void) = NULL;\n\n'
+
+    ret += '    dlerror();\n'
+    ret += '    * (void**) (&prewarm_fn) = dlsym(handle, "bd_{0}_prewarm_deps");\n'.format(MOD_FNAME_OVERRIDES.get(module_name, module_name))
+    ret += '    if (((error = dlerror()) != NULL) || !prewarm_fn) {\n'
+    ret += '        bd_utils_log_format (BD_UTILS_LOG_DEBUG, "failed to load the prewarm_deps() function for {0}: %s", error);\n'.format(module_name)
+    ret += '        return;\n'
+    ret += '    }\n\n'
+    ret += '    prewarm_fn();\n'
+    ret += '}\n\n'
+
+    return ret
+
 def get_fn_code(fn_info):
     ret = ("{0.doc}{0.rtype} {0.name} ({0.args}) {{\n" +
             "    {0.body}" +
@@ -286,9 +346,12 @@ def generate_source_header(api_file, out_dir, skip_patterns=None):
         for info in nonapi_fn_infos:
             src_f.write(get_fn_code(info))
         for info in api_fn_infos:
-            src_f.write(get_func_boilerplate(info))
+            src_f.write(get_func_boilerplate(info, mod_name))
         src_f.write(get_loading_func(api_fn_infos, mod_name))
         src_f.write(get_unloading_func(api_fn_infos, mod_name))
+        src_f.write(get_lazy_func(api_fn_infos, mod_name))
+        if mod_name in PREWARM_MODULES:
+            src_f.write(get_prewarm_func(mod_name))
 
     written_fns = set()
     with open(os.path.join(out_dir, mod_name + ".h"), "w") as hdr_f:
@@ -186,6 +186,19 @@ void bd_btrfs_close (void) {
     g_atomic_int_set (&avail_module_deps, 0);
 }
 
+/**
+ * bd_btrfs_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_btrfs_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+    check_module_deps (&avail_module_deps, ALL_DEPS_MASK (MODULE_DEPS_LAST), module_deps, MODULE_DEPS_LAST, &deps_check_lock, NULL);
+}
+
 
 
 /**
@@ -641,10 +654,7 @@ gboolean bd_btrfs_create_snapshot (const gchar *source, const gchar *dest, gbool
  */
 BDBtrfsDeviceInfo** bd_btrfs_list_devices (const gchar *device, GError **error) {
     const gchar *argv[5] = {"btrfs", "filesystem", "show", device, NULL};
-    gchar *output = NULL;
     gboolean success = FALSE;
-    gchar **lines = NULL;
-    gchar **line_p = NULL;
     gchar const * const pattern = "devid[ \\t]+(?P<id>\\d+)[ \\t]+" \
                                   "size[ \\t]+(?P<size>\\S+)[ \\t]+" \
                                   "used[ \\t]+(?P<used>\\S+)[ \\t]+" \
@@ -699,6 +709,22 @@ BDBtrfsDeviceInfo** bd_btrfs_list_devices (const gchar *device, GError **error)
     return (BDBtrfsDeviceInfo **) g_ptr_array_free (dev_infos, FALSE);
 }
 
+typedef struct SubvolListData {
+    GRegex *regex;
+    GPtrArray *subvol_infos;
+    gboolean got_output;
+} SubvolListData;
+
+static void process_subvol_line (const gchar *line, gpointer user_data) {
+    SubvolListData *data = (SubvolListData *) user_data;
+    GMatchInfo *match_info = NULL;
+
+    data->got_output = TRUE;
+    if (g_regex_match (data->regex, line, 0, &match_info))
+        g_ptr_array_add (data->subvol_infos, get_subvolume_info_from_match (match_info));
+    g_match_info_free (match_info);
+}
+
 /**
  * bd_btrfs_list_subvolumes:
  * @mountpoint: a mountpoint of the queried btrfs volume
@@ -715,16 +741,13 @@ BDBtrfsDeviceInfo** bd_btrfs_list_devices (const gchar *device, GError **error)
  */
 BDBtrfsSubvolumeInfo** bd_btrfs_list_subvolumes (const gchar *mountpoint, gboolean snapshots_only, GError **error) {
     const gchar *argv[8] = {"btrfs", "subvol", "list", "-a", "-p", NULL, NULL, NULL};
-    gchar *output = NULL;
     gboolean success = FALSE;
-    gchar **lines = NULL;
-    gchar **line_p = NULL;
     gchar const * const pattern = "ID\\s+(?P<id>\\d+)\\s+gen\\s+\\d+\\s+(cgen\\s+\\d+\\s+)?" \
                                   "parent\\s+(?P<parent_id>\\d+)\\s+top\\s+level\\s+\\d+\\s+" \
                                   "(otime\\s+(\\d{4}-\\d{2}-\\d{2}\\s+\\d\\d:\\d\\d:\\d\\d|-)\\s+)?"\
                                   "path\\s+(<FS_TREE>/)?(?P<path>.+)";
     GRegex *regex = NULL;
-    GMatchInfo *match_info = NULL;
+    SubvolListData data = { NULL, NULL, FALSE };
     guint64 i = 0;
     guint64 y = 0;
     guint64 next_sorted_idx = 0;
@@ -751,36 +774,26 @@ BDBtrfsSubvolumeInfo** bd_btrfs_list_subvolumes (const gchar *mountpoint, gboole
         return NULL;
     }
 
-    success = bd_utils_exec_and_capture_output (argv, NULL, &output, &l_error);
-    if (!success) {
-        g_regex_unref (regex);
-        if (g_error_matches (l_error,  BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_NOOUT)) {
-            /* no output -> no subvolumes */
-            g_clear_error (&l_error);
-            return g_new0 (BDBtrfsSubvolumeInfo*, 1);
-        } else {
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-    }
-
-    lines = g_strsplit (output, "\n", 0);
-    g_free (output);
-
     subvol_infos = g_ptr_array_new ();
-    for (line_p = lines; *line_p; line_p++) {
-        success = g_regex_match (regex, *line_p, 0, &match_info);
-        if (!success) {
-            g_match_info_free (match_info);
-            continue;
-        }
+    data.regex = regex;
+    data.subvol_infos = subvol_infos;
 
-        g_ptr_array_add (subvol_infos, get_subvolume_info_from_match (match_info));
-        g_match_info_free (match_info);
+    /* parse the lines as they come instead of waiting for the whole (potentially
+       huge) list to be captured */
+    success = bd_utils_exec_and_stream_output (argv, NULL, process_subvol_line, &data, &l_error);
+    g_regex_unref (regex);
+    if (!success) {
+        g_ptr_array_set_free_func (subvol_infos, (GDestroyNotify) bd_btrfs_subvolume_info_free);
+        g_ptr_array_free (subvol_infos, TRUE);
+        g_propagate_error (error, l_error);
+        return NULL;
     }
 
-    g_strfreev (lines);
-    g_regex_unref (regex);
+    if (!data.got_output) {
+        /* no output -> no subvolumes */
+        g_ptr_array_free (subvol_infos, TRUE);
+        return g_new0 (BDBtrfsSubvolumeInfo*, 1);
+    }
 
     if (subvol_infos->len == 0) {
         g_set_error_literal (error, BD_BTRFS_ERROR, BD_BTRFS_ERROR_PARSE, "Failed to parse information about subvolumes");
@@ -84,6 +84,7 @@ typedef enum {
  */
 gboolean bd_btrfs_init (void);
 void bd_btrfs_close (void);
+void bd_btrfs_prewarm_deps (void);
 
 gboolean bd_btrfs_is_tech_avail (BDBtrfsTech tech, guint64 mode, GError **error);
 
@@ -25,13 +25,45 @@
 
 #define DBUS_PROPS_IFACE "org.freedesktop.DBus.Properties"
 
+/* maximum number of utilities checked in parallel by check_deps() */
+#define DEPS_CHECK_MAX_THREADS 8
+
+typedef struct UtilDepCheck {
+    const UtilDep *spec;
+    /* exec settings of the thread that called check_deps() */
+    guint64 exec_timeout;
+    BDUtilsProgFunc prog_func;
+    gboolean ret;
+    GError *error;
+} UtilDepCheck;
+
+static void _check_util_dep (gpointer data, gpointer user_data G_GNUC_UNUSED) {
+    UtilDepCheck *check = (UtilDepCheck *) data;
+    guint64 orig_timeout = bd_utils_get_exec_timeout_thread ();
+    BDUtilsProgFunc orig_prog_func = bd_utils_get_prog_reporting_thread ();
+
+    /* the utility should behave the same as if it was run from the calling
+       thread, pool threads don't inherit its thread-local settings */
+    bd_utils_set_exec_timeout_thread (check->exec_timeout);
+    bd_utils_init_prog_reporting_thread (check->prog_func, NULL);
+
+    check->ret = bd_utils_check_util_version (check->spec->name, check->spec->version,
+                                              check->spec->ver_arg, check->spec->ver_regexp, &(check->error));
+
+    /* the pool's threads may be reused by other thread pools */
+    bd_utils_set_exec_timeout_thread (orig_timeout);
+    bd_utils_init_prog_reporting_thread (orig_prog_func, NULL);
+}
 
 G_GNUC_INTERNAL gboolean
 check_deps (volatile guint *avail_deps, guint req_deps, const UtilDep *deps_specs, guint l_deps, GMutex *deps_check_lock, GError **error) {
     guint i = 0;
-    gboolean ret = FALSE;
-    GError *l_error = NULL;
     guint val = 0;
+    UtilDepCheck *checks = NULL;
+    guint n_runs = 0;
+    GThreadPool *pool = NULL;
+    guint64 exec_timeout = 0;
+    BDUtilsProgFunc prog_func = NULL;
 
     val = (guint) g_atomic_int_get (avail_deps);
     if ((val & req_deps) == req_deps)
@@ -49,25 +81,54 @@ check_deps (volatile guint *avail_deps, guint req_deps, const UtilDep *deps_spec
         return TRUE;
     }
 
+    exec_timeout = bd_utils_get_exec_timeout_thread ();
+    prog_func = bd_utils_get_prog_reporting_thread ();
+
+    checks = g_new0 (UtilDepCheck, l_deps);
     for (i=0; i < l_deps; i++) {
         if (((1 << i) & req_deps) && !((1 << i) & val)) {
-            ret = bd_utils_check_util_version (deps_specs[i].name, deps_specs[i].version,
-                                               deps_specs[i].ver_arg, deps_specs[i].ver_regexp, &l_error);
-            /* if not ret and l_error -> set/prepend error */
-            if (!ret) {
-                if (error) {
-                    if (*error)
-                        g_prefix_error (error, "%s\n", l_error->message);
-                    else
-                        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_UTIL_CHECK_ERROR,
-                                     "%s", l_error->message);
-                }
-                g_clear_error (&l_error);
-            } else
-                g_atomic_int_or (avail_deps, 1 << i);
+            checks[i].spec = &(deps_specs[i]);
+            checks[i].exec_timeout = exec_timeout;
+            checks[i].prog_func = prog_func;
+            /* only checking the version requires running the utility */
+            if (deps_specs[i].version)
+                n_runs++;
         }
     }
 
+    /* running the utilities is the expensive part so let's run them in parallel
+       if there are more of them */
+    if (n_runs > 1)
+        pool = g_thread_pool_new (_check_util_dep, NULL, MIN (n_runs, DEPS_CHECK_MAX_THREADS), FALSE, NULL);
+    if (pool) {
+        for (i=0; i < l_deps; i++)
+            if (checks[i].spec && checks[i].spec->version)
+                g_thread_pool_push (pool, &(checks[i]), NULL);
+        /* wait for all the checks to finish */
+        g_thread_pool_free (pool, FALSE, TRUE);
+    }
+
+    for (i=0; i < l_deps; i++) {
+        if (!checks[i].spec)
+            continue;
+        if (!pool || !checks[i].spec->version)
+            _check_util_dep (&(checks[i]), NULL);
+
+        /* if not ret and l_error -> set/prepend error */
+        if (!checks[i].ret) {
+            if (error) {
+                if (*error)
+                    g_prefix_error (error, "%s\n", checks[i].error->message);
+                else
+                    g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_UTIL_CHECK_ERROR,
+                                 "%s", checks[i].error->message);
+            }
+            g_clear_error (&(checks[i].error));
+        } else
+            g_atomic_int_or (avail_deps, 1 << i);
+    }
+    g_free (checks);
+
     g_mutex_unlock (deps_check_lock);
     val = (guint) g_atomic_int_get (avail_deps);
     return (val & req_deps) == req_deps;
@@ -22,6 +22,9 @@
 #ifndef BD_CHECK_DEPS
 #define BD_CHECK_DEPS
 
+/* mask of all the dependencies from a list of @last dependencies */
+#define ALL_DEPS_MASK(last) ((1 << (last)) - 1)
+
 typedef struct UtilDep {
     const gchar *name;
     const gchar *version;
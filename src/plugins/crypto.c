@@ -41,6 +41,7 @@
 #endif
 
 #include "crypto.h"
+#include "probes.h"
 
 #ifdef __clang__
 #define ZERO_INIT {}
@@ -1334,7 +1335,7 @@ gboolean bd_crypto_luks_open_flags (const gchar *device, const gchar *name, BDCr
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -1350,10 +1351,10 @@ gboolean bd_crypto_luks_open_flags (const gchar *device, const gchar *name, BDCr
         crypt_flags |= CRYPT_ACTIVATE_READONLY;
 
     if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_PASSPHRASE) {
-        ret = crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT,
-                                            (const char *) context->u.passphrase.pass_data,
-                                            context->u.passphrase.data_len,
-                                            crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT,
+                                                                           (const char *) context->u.passphrase.pass_data,
+                                                                           context->u.passphrase.data_len,
+                                                                           crypt_flags));
     } else if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_KEYFILE) {
         ret = crypt_keyfile_device_read (cd, context->u.keyfile.keyfile, &key_buffer, &buf_len,
                                          context->u.keyfile.keyfile_offset, context->u.keyfile.key_size, 0);
@@ -1365,10 +1366,10 @@ gboolean bd_crypto_luks_open_flags (const gchar *device, const gchar *name, BDCr
             g_propagate_error (error, l_error);
             return FALSE;
         }
-        ret = crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT, key_buffer, buf_len, crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT, key_buffer, buf_len, crypt_flags));
         crypt_safe_free (key_buffer);
     } else if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_KEYRING)
-        ret = crypt_activate_by_keyring (cd, name, context->u.keyring.key_desc, CRYPT_ANY_SLOT, crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_keyring (cd, name, context->u.keyring.key_desc, CRYPT_ANY_SLOT, crypt_flags));
     else {
         g_set_error_literal (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_INVALID_CONTEXT,
                              "Only 'passphrase', 'key file' and 'keyring' context types are valid for LUKS open.");
@@ -1514,7 +1515,7 @@ gboolean bd_crypto_luks_add_key (const gchar *device, BDCryptoKeyslotContext *co
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -1630,7 +1631,7 @@ gboolean bd_crypto_luks_remove_key (const gchar *device, BDCryptoKeyslotContext
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -1641,9 +1642,9 @@ gboolean bd_crypto_luks_remove_key (const gchar *device, BDCryptoKeyslotContext
     }
 
     if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_PASSPHRASE) {
-        ret = crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT,
-                                            (const char *) context->u.passphrase.pass_data,
-                                            context->u.passphrase.data_len, 0);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT,
+                                                                           (const char *) context->u.passphrase.pass_data,
+                                                                           context->u.passphrase.data_len, 0));
     } else if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_KEYFILE) {
         ret = crypt_keyfile_device_read (cd, context->u.keyfile.keyfile, &key_buf, &buf_len,
                                          context->u.keyfile.keyfile_offset, context->u.keyfile.key_size, 0);
@@ -1655,7 +1656,7 @@ gboolean bd_crypto_luks_remove_key (const gchar *device, BDCryptoKeyslotContext
             g_propagate_error (error, l_error);
             return FALSE;
         }
-        ret = crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT, key_buf, buf_len, 0);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT, key_buf, buf_len, 0));
         crypt_safe_free (key_buf);
     } else {
         g_set_error_literal (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_INVALID_CONTEXT,
@@ -1727,7 +1728,7 @@ gboolean bd_crypto_luks_change_key (const gchar *device, BDCryptoKeyslotContext
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -1868,10 +1869,10 @@ gboolean bd_crypto_luks_resize (const gchar *luks_device, guint64 size, BDCrypto
 
     if (context) {
         if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_PASSPHRASE) {
-            ret = crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT,
-                                                (const char *) context->u.passphrase.pass_data,
-                                                context->u.passphrase.data_len,
-                                                cad.flags & CRYPT_ACTIVATE_KEYRING_KEY);
+            ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT,
+                                                                               (const char *) context->u.passphrase.pass_data,
+                                                                               context->u.passphrase.data_len,
+                                                                               cad.flags & CRYPT_ACTIVATE_KEYRING_KEY));
         } else if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_KEYFILE) {
             ret = crypt_keyfile_device_read (cd, context->u.keyfile.keyfile, &key_buffer, &buf_len,
                                              context->u.keyfile.keyfile_offset, context->u.keyfile.key_size, 0);
@@ -1883,8 +1884,8 @@ gboolean bd_crypto_luks_resize (const gchar *luks_device, guint64 size, BDCrypto
                 g_propagate_error (error, l_error);
                 return FALSE;
             }
-            ret = crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT, key_buffer, buf_len,
-                                                cad.flags & CRYPT_ACTIVATE_KEYRING_KEY);
+            ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, NULL, CRYPT_ANY_SLOT, key_buffer, buf_len,
+                                                                               cad.flags & CRYPT_ACTIVATE_KEYRING_KEY));
             crypt_safe_free (key_buffer);
         } else {
             g_set_error_literal (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_INVALID_CONTEXT,
@@ -2015,7 +2016,7 @@ gboolean bd_crypto_luks_resume (const gchar *luks_device, BDCryptoKeyslotContext
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -2098,7 +2099,7 @@ gboolean bd_crypto_luks_kill_slot (const gchar *device, gint slot, GError **erro
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -2154,7 +2155,7 @@ gboolean bd_crypto_luks_header_backup (const gchar *device, const gchar *backup_
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -2275,7 +2276,7 @@ gboolean bd_crypto_luks_set_label (const gchar *device, const gchar *label, cons
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device: %s", strerror_l (-ret, c_locale));
@@ -2324,7 +2325,7 @@ gboolean bd_crypto_luks_set_uuid (const gchar *device, const gchar *uuid, GError
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device: %s", strerror_l (-ret, c_locale));
@@ -2371,7 +2372,7 @@ gboolean bd_crypto_luks_convert (const gchar *device, BDCryptoLUKSVersion target
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device: %s", strerror_l (-ret, c_locale));
@@ -2432,7 +2433,7 @@ gboolean bd_crypto_luks_set_persistent_flags (const gchar *device, BDCryptoLUKSP
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device: %s", strerror_l (-ret, c_locale));
@@ -2603,7 +2604,7 @@ BDCryptoLUKSInfo* bd_crypto_luks_info (const gchar *device, GError **error) {
         cd = NULL;
         ret = crypt_init_by_name (&cd, device);
     } else {
-        ret = crypt_load (cd, CRYPT_LUKS, NULL);
+        ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
         if (ret != 0) {
             /* not a LUKS device, try init_by_name */
             crypt_free (cd);
@@ -2706,7 +2707,7 @@ BDCryptoBITLKInfo* bd_crypto_bitlk_info (const gchar *device, GError **error) {
         cd = NULL;
         ret = crypt_init_by_name (&cd, device);
     } else {
-        ret = crypt_load (cd, CRYPT_BITLK, NULL);
+        ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_BITLK, NULL));
         if (ret != 0) {
             /* not a BITLK device, try init_by_name */
             crypt_free (cd);
@@ -2758,10 +2759,10 @@ BDCryptoIntegrityInfo* bd_crypto_integrity_info (const gchar *device, GError **e
         cd = NULL;
         ret = crypt_init_by_name (&cd, device);
     } else {
-        ret = crypt_load (cd, CRYPT_LUKS, NULL);
+        ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
         if (ret != 0) {
             /* not a LUKS device, try integrity */
-            ret = crypt_load (cd, CRYPT_INTEGRITY, NULL);
+            ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_INTEGRITY, NULL));
             if (ret != 0) {
                 crypt_free (cd);
                 cd = NULL;
@@ -2833,7 +2834,7 @@ BDCryptoLUKSTokenInfo** bd_crypto_luks_token_info (const gchar *device, GError *
         cd = NULL;
         ret = crypt_init_by_name (&cd, device);
     } else {
-        ret = crypt_load (cd, CRYPT_LUKS, NULL);
+        ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
         if (ret != 0) {
             /* not a LUKS device, try init_by_name */
             crypt_free (cd);
@@ -2973,10 +2974,10 @@ gboolean bd_crypto_integrity_format (const gchar *device, const gchar *algorithm
         tmp_name = g_strdup_printf ("bd-temp-integrity-%s-%d", dev_name, g_random_int ());
         tmp_path = g_strdup_printf ("%s/%s", crypt_get_dir (), tmp_name);
 
-        ret = crypt_activate_by_volume_key (cd, tmp_name,
-                                            context ? (const char *) context->u.volume_key.volume_key : NULL,
-                                            context ? context->u.volume_key.volume_key_size : 0,
-                                            CRYPT_ACTIVATE_PRIVATE | CRYPT_ACTIVATE_NO_JOURNAL);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_volume_key (cd, tmp_name,
+                                                                           context ? (const char *) context->u.volume_key.volume_key : NULL,
+                                                                           context ? context->u.volume_key.volume_key_size : 0,
+                                                                           CRYPT_ACTIVATE_PRIVATE | CRYPT_ACTIVATE_NO_JOURNAL));
         if (ret != 0) {
             g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                          "Failed to activate the newly created integrity device for wiping: %s",
@@ -3106,7 +3107,7 @@ gboolean bd_crypto_integrity_open (const gchar *device, const gchar *name, const
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_INTEGRITY, &params);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_INTEGRITY, &params));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -3116,10 +3117,10 @@ gboolean bd_crypto_integrity_open (const gchar *device, const gchar *name, const
         return FALSE;
     }
 
-    ret = crypt_activate_by_volume_key (cd, name,
-                                        context ? (const char *) context->u.volume_key.volume_key : NULL,
-                                        context ? context->u.volume_key.volume_key_size : 0,
-                                        activate_flags);
+    ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_volume_key (cd, name,
+                                                                       context ? (const char *) context->u.volume_key.volume_key : NULL,
+                                                                       context ? context->u.volume_key.volume_key_size : 0,
+                                                                       activate_flags));
     if (ret < 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to activate device: %s", strerror_l (-ret, c_locale));
@@ -3321,7 +3322,7 @@ gboolean bd_crypto_tc_open_flags (const gchar *device, const gchar *name, BDCryp
     if (veracrypt && veracrypt_pim != 0)
         params.veracrypt_pim = veracrypt_pim;
 
-    ret = crypt_load (cd, CRYPT_TCRYPT, &params);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_TCRYPT, &params));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -3336,7 +3337,7 @@ gboolean bd_crypto_tc_open_flags (const gchar *device, const gchar *name, BDCryp
     if (flags & BD_CRYPTO_OPEN_READONLY)
         crypt_flags |= CRYPT_ACTIVATE_READONLY;
 
-    ret = crypt_activate_by_volume_key (cd, name, NULL, 0, crypt_flags);
+    ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_volume_key (cd, name, NULL, 0, crypt_flags));
     if (ret < 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to activate device: %s", strerror_l (-ret, c_locale));
@@ -3674,7 +3675,7 @@ gboolean bd_crypto_bitlk_open_flags (const gchar *device, const gchar *name, BDC
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_BITLK, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_BITLK, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -3690,10 +3691,10 @@ gboolean bd_crypto_bitlk_open_flags (const gchar *device, const gchar *name, BDC
         crypt_flags |= CRYPT_ACTIVATE_READONLY;
 
     if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_PASSPHRASE) {
-        ret = crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT,
-                                            (const char *) context->u.passphrase.pass_data,
-                                            context->u.passphrase.data_len,
-                                            crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT,
+                                                                           (const char *) context->u.passphrase.pass_data,
+                                                                           context->u.passphrase.data_len,
+                                                                           crypt_flags));
     } else if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_KEYFILE) {
         ret = crypt_keyfile_device_read (cd, context->u.keyfile.keyfile, &key_buffer, &buf_len,
                                          context->u.keyfile.keyfile_offset, context->u.keyfile.key_size, 0);
@@ -3705,7 +3706,7 @@ gboolean bd_crypto_bitlk_open_flags (const gchar *device, const gchar *name, BDC
             g_propagate_error (error, l_error);
             return FALSE;
         }
-        ret = crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT, key_buffer, buf_len, crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT, key_buffer, buf_len, crypt_flags));
         crypt_safe_free (key_buffer);
     } else {
         g_set_error_literal (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_INVALID_CONTEXT,
@@ -3812,7 +3813,7 @@ gboolean bd_crypto_fvault2_open_flags (const gchar *device, const gchar *name, B
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_FVAULT2, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_FVAULT2, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -3828,10 +3829,10 @@ gboolean bd_crypto_fvault2_open_flags (const gchar *device, const gchar *name, B
         crypt_flags |= CRYPT_ACTIVATE_READONLY;
 
     if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_PASSPHRASE) {
-        ret = crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT,
-                                            (const char *) context->u.passphrase.pass_data,
-                                            context->u.passphrase.data_len,
-                                            crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT,
+                                                                           (const char *) context->u.passphrase.pass_data,
+                                                                           context->u.passphrase.data_len,
+                                                                           crypt_flags));
     } else if (context->type == BD_CRYPTO_KEYSLOT_CONTEXT_TYPE_KEYFILE) {
         ret = crypt_keyfile_device_read (cd, context->u.keyfile.keyfile, &key_buffer, &buf_len,
                                          context->u.keyfile.keyfile_offset, context->u.keyfile.key_size, 0);
@@ -3843,7 +3844,7 @@ gboolean bd_crypto_fvault2_open_flags (const gchar *device, const gchar *name, B
             g_propagate_error (error, l_error);
             return FALSE;
         }
-        ret = crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT, key_buffer, buf_len, crypt_flags);
+        ret = BD_PROBE_CALL (crypt_activate, crypt_activate_by_passphrase (cd, name, CRYPT_ANY_SLOT, key_buffer, buf_len, crypt_flags));
         crypt_safe_free (key_buffer);
     } else {
         g_set_error_literal (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_INVALID_CONTEXT,
@@ -4008,7 +4009,7 @@ gboolean bd_crypto_opal_wipe_device (const gchar *device, BDCryptoKeyslotContext
         return FALSE;
     }
 
-    ret = crypt_load (cd, CRYPT_LUKS, NULL);
+    ret = BD_PROBE_CALL (crypt_load, crypt_load (cd, CRYPT_LUKS, NULL));
     if (ret != 0) {
         g_set_error (&l_error, BD_CRYPTO_ERROR, BD_CRYPTO_ERROR_DEVICE,
                      "Failed to load device's parameters: %s", strerror_l (-ret, c_locale));
@@ -28,6 +28,7 @@
 #include "dm.h"
 #include "check_deps.h"
 #include "dm_logging.h"
+#include "probes.h"
 
 #define DM_MIN_VERSION "1.02.93"
 
@@ -92,6 +93,18 @@ void bd_dm_close (void) {
     g_atomic_int_set (&avail_deps, 0);
 }
 
+/**
+ * bd_dm_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_dm_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_dm_is_tech_avail:
  * @tech: the queried tech
@@ -261,7 +274,7 @@ gchar* bd_dm_get_subsystem_from_name (const gchar *device_name, GError **error)
         return NULL;
     }
 
-    if (!dm_task_run (task)) {
+    if (!BD_PROBE_CALL (dm_task_run, dm_task_run (task))) {
         g_set_error_literal (error, BD_DM_ERROR, BD_DM_ERROR_TASK,
                              "Failed to run DM task");
         dm_task_destroy (task);
@@ -332,7 +345,7 @@ gboolean bd_dm_map_exists (const gchar *map_name, gboolean live_only, gboolean a
         return FALSE;
     }
 
-    dm_task_run (task_list);
+    (void) BD_PROBE_CALL (dm_task_run, dm_task_run (task_list));
     names = dm_task_get_names (task_list);
 
     if (!names || !names->dev) {
@@ -361,7 +374,7 @@ gboolean bd_dm_map_exists (const gchar *map_name, gboolean live_only, gboolean a
             dm_task_destroy (task_info);
             continue;
         }
-        if (dm_task_run (task_info) == 0) {
+        if (BD_PROBE_CALL (dm_task_run, dm_task_run (task_info)) == 0) {
             dm_task_destroy (task_info);
             continue;
         }
@@ -84,6 +84,26 @@ void bd_fs_close (void) {
     _fs_nilfs_reset_avail_deps ();
 }
 
+/**
+ * bd_fs_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_fs_prewarm_deps (void) {
+    _fs_ext_prewarm_deps ();
+    _fs_xfs_prewarm_deps ();
+    _fs_vfat_prewarm_deps ();
+    _fs_ntfs_prewarm_deps ();
+    _fs_exfat_prewarm_deps ();
+    _fs_btrfs_prewarm_deps ();
+    _fs_udf_prewarm_deps ();
+    _fs_f2fs_prewarm_deps ();
+    _fs_nilfs_prewarm_deps ();
+}
+
 /**
  * bd_fs_is_tech_avail:
  * @tech: the queried tech
@@ -20,5 +20,14 @@ void _fs_btrfs_reset_avail_deps (void);
 void _fs_udf_reset_avail_deps (void);
 void _fs_f2fs_reset_avail_deps (void);
 void _fs_nilfs_reset_avail_deps (void);
+void _fs_ext_prewarm_deps (void);
+void _fs_xfs_prewarm_deps (void);
+void _fs_vfat_prewarm_deps (void);
+void _fs_ntfs_prewarm_deps (void);
+void _fs_exfat_prewarm_deps (void);
+void _fs_btrfs_prewarm_deps (void);
+void _fs_udf_prewarm_deps (void);
+void _fs_f2fs_prewarm_deps (void);
+void _fs_nilfs_prewarm_deps (void);
 
 #endif  /* BD_FS_COMMON */
@@ -80,6 +80,11 @@ static guint64 _exfat_parse_line_val (const gchar *line) {
 
 
 
+G_GNUC_INTERNAL
+void _fs_exfat_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_fs_exfat_is_tech_avail:
  * @tech: the queried tech
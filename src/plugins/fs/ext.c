@@ -151,6 +151,11 @@ static gboolean extract_e2fsck_progress (const gchar *line, guint8 *completion)
 }
 
 
+G_GNUC_INTERNAL
+void _fs_ext_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_fs_ext_is_tech_avail:
  * @tech: the queried tech
@@ -105,6 +105,12 @@ static gboolean can_check_f2fs_version (UtilDep dep, GError **error) {
     return TRUE;
 }
 
+G_GNUC_INTERNAL
+void _fs_f2fs_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+    check_deps (&avail_shrink_deps, ALL_DEPS_MASK (SHRINK_DEPS_LAST), shrink_deps, SHRINK_DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_fs_f2fs_is_tech_avail:
  * @tech: the queried tech
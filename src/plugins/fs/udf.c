@@ -66,6 +66,11 @@ static guint32 fs_mode_util[BD_FS_MODE_LAST+1] = {
 };
 
 
+G_GNUC_INTERNAL
+void _fs_udf_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_fs_udf_is_tech_avail:
  * @tech: the queried tech
@@ -19,12 +19,17 @@
 #include <glib.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
 #include <blockdev/utils.h>
 #include <libdevmapper.h>
+#include <libudev.h>
 
 #include "lvm.h"
 #include "lvm-private.h"
 #include "check_deps.h"
+#include "probes.h"
 #include "dm_logging.h"
 #include "vdo_stats.h"
 
@@ -115,6 +120,7 @@ BDLVMVGdata* bd_lvm_vgdata_copy (BDLVMVGdata *data) {
     new_data->pv_count = data->pv_count;
     new_data->vg_tags = g_strdupv (data->vg_tags);
     new_data->exported = data->exported;
+    new_data->seqno = data->seqno;
     return new_data;
 }
 
@@ -224,6 +230,237 @@ void bd_lvm_lvdata_free (BDLVMLVdata *data) {
     g_free (data);
 }
 
+BDLVMFullReport* bd_lvm_full_report_copy (BDLVMFullReport *report) {
+    guint64 i = 0;
+
+    if (report == NULL)
+        return NULL;
+
+    BDLVMFullReport *new_report = g_new0 (BDLVMFullReport, 1);
+
+    for (i = 0; report->pvs && report->pvs[i]; i++)
+        ;
+    new_report->pvs = g_new0 (BDLVMPVdata *, i + 1);
+    for (i = 0; report->pvs && report->pvs[i]; i++)
+        new_report->pvs[i] = bd_lvm_pvdata_copy (report->pvs[i]);
+
+    for (i = 0; report->vgs && report->vgs[i]; i++)
+        ;
+    new_report->vgs = g_new0 (BDLVMVGdata *, i + 1);
+    for (i = 0; report->vgs && report->vgs[i]; i++)
+        new_report->vgs[i] = bd_lvm_vgdata_copy (report->vgs[i]);
+
+    for (i = 0; report->lvs && report->lvs[i]; i++)
+        ;
+    new_report->lvs = g_new0 (BDLVMLVdata *, i + 1);
+    for (i = 0; report->lvs && report->lvs[i]; i++)
+        new_report->lvs[i] = bd_lvm_lvdata_copy (report->lvs[i]);
+
+    return new_report;
+}
+
+void bd_lvm_full_report_free (BDLVMFullReport *report) {
+    guint64 i = 0;
+
+    if (report == NULL)
+        return;
+
+    for (i = 0; report->pvs && report->pvs[i]; i++)
+        bd_lvm_pvdata_free (report->pvs[i]);
+    g_free (report->pvs);
+    for (i = 0; report->vgs && report->vgs[i]; i++)
+        bd_lvm_vgdata_free (report->vgs[i]);
+    g_free (report->vgs);
+    for (i = 0; report->lvs && report->lvs[i]; i++)
+        bd_lvm_lvdata_free (report->lvs[i]);
+    g_free (report->lvs);
+    g_free (report);
+}
+
+BDLVMStateSnapshot* bd_lvm_state_snapshot_copy (BDLVMStateSnapshot *snapshot) {
+    if (snapshot == NULL)
+        return NULL;
+
+    g_atomic_int_inc (&snapshot->ref_count);
+    return snapshot;
+}
+
+void bd_lvm_state_snapshot_free (BDLVMStateSnapshot *snapshot) {
+    guint64 i = 0;
+
+    if (snapshot == NULL)
+        return;
+
+    if (!g_atomic_int_dec_and_test (&snapshot->ref_count))
+        return;
+
+    g_hash_table_destroy (snapshot->pvs_by_uuid);
+    g_hash_table_destroy (snapshot->pvs_by_path);
+    g_hash_table_destroy (snapshot->vgs_by_uuid);
+    g_hash_table_destroy (snapshot->vgs_by_name);
+    g_hash_table_destroy (snapshot->lvs_by_uuid);
+    g_hash_table_destroy (snapshot->lvs_by_name);
+    g_hash_table_destroy (snapshot->lvs_by_path);
+    g_hash_table_destroy (snapshot->lvs_by_pv);
+
+    for (i = 0; snapshot->pvs && snapshot->pvs[i]; i++)
+        bd_lvm_pvdata_free (snapshot->pvs[i]);
+    g_free (snapshot->pvs);
+    for (i = 0; snapshot->vgs && snapshot->vgs[i]; i++)
+        bd_lvm_vgdata_free (snapshot->vgs[i]);
+    g_free (snapshot->vgs);
+    for (i = 0; snapshot->lvs && snapshot->lvs[i]; i++)
+        bd_lvm_lvdata_free (snapshot->lvs[i]);
+    g_free (snapshot->lvs);
+    g_free (snapshot);
+}
+
+BDLVMEvent* bd_lvm_event_copy (BDLVMEvent *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMEvent *new = g_new0 (BDLVMEvent, 1);
+
+    new->type = data->type;
+    new->vg_name = g_strdup (data->vg_name);
+    new->lv_name = g_strdup (data->lv_name);
+    new->old_size = data->old_size;
+    new->new_size = data->new_size;
+
+    return new;
+}
+
+void bd_lvm_event_free (BDLVMEvent *data) {
+    if (data == NULL)
+        return;
+
+    g_free (data->vg_name);
+    g_free (data->lv_name);
+    g_free (data);
+}
+
+BDLVMWatcher* bd_lvm_watcher_copy (BDLVMWatcher *watcher) {
+    if (watcher == NULL)
+        return NULL;
+
+    g_atomic_int_inc (&watcher->ref_count);
+    return watcher;
+}
+
+void bd_lvm_watcher_free (BDLVMWatcher *watcher) {
+    if (watcher == NULL)
+        return;
+
+    if (!g_atomic_int_dec_and_test (&watcher->ref_count))
+        return;
+
+    if (watcher->priv_free)
+        watcher->priv_free (watcher->priv);
+    g_free (watcher);
+}
+
+BDLVMJob* bd_lvm_job_copy (BDLVMJob *job) {
+    if (job == NULL)
+        return NULL;
+
+    g_atomic_int_inc (&job->ref_count);
+    return job;
+}
+
+void bd_lvm_job_free (BDLVMJob *job) {
+    if (job == NULL)
+        return;
+
+    if (!g_atomic_int_dec_and_test (&job->ref_count))
+        return;
+
+    if (job->priv_free)
+        job->priv_free (job->priv);
+    g_free (job);
+}
+
+BDLVMLVSpec* bd_lvm_lvspec_copy (BDLVMLVSpec *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMLVSpec *new = g_new0 (BDLVMLVSpec, 1);
+
+    new->lv_name = g_strdup (data->lv_name);
+    new->size = data->size;
+    new->type = g_strdup (data->type);
+    new->pv_list = g_strdupv (data->pv_list);
+    new->pool_name = g_strdup (data->pool_name);
+
+    return new;
+}
+
+void bd_lvm_lvspec_free (BDLVMLVSpec *data) {
+    if (data == NULL)
+        return;
+
+    g_free (data->lv_name);
+    g_free (data->type);
+    g_strfreev (data->pv_list);
+    g_free (data->pool_name);
+    g_free (data);
+}
+
+BDLVMBatchResult* bd_lvm_batch_result_copy (BDLVMBatchResult *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMBatchResult *new = g_new0 (BDLVMBatchResult, 1);
+
+    new->lv_name = g_strdup (data->lv_name);
+    new->success = data->success;
+    new->error_message = g_strdup (data->error_message);
+
+    return new;
+}
+
+void bd_lvm_batch_result_free (BDLVMBatchResult *data) {
+    if (data == NULL)
+        return;
+
+    g_free (data->lv_name);
+    g_free (data->error_message);
+    g_free (data);
+}
+
+BDLVMDBusCacheStats* bd_lvm_dbus_cache_stats_copy (BDLVMDBusCacheStats *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMDBusCacheStats *new = g_new0 (BDLVMDBusCacheStats, 1);
+
+    new->enabled = data->enabled;
+    new->n_objects = data->n_objects;
+    new->hits = data->hits;
+    new->misses = data->misses;
+    new->stale = data->stale;
+    new->refreshes = data->refreshes;
+    new->updates = data->updates;
+
+    return new;
+}
+
+void bd_lvm_dbus_cache_stats_free (BDLVMDBusCacheStats *data) {
+    if (data == NULL)
+        return;
+    g_free (data);
+}
+
+/* result for the @lv_name LV, successful if @error is %NULL */
+BDLVMBatchResult* _lvm_batch_result_new (const gchar *lv_name, const GError *error) {
+    BDLVMBatchResult *result = g_new0 (BDLVMBatchResult, 1);
+
+    result->lv_name = g_strdup (lv_name);
+    result->success = error == NULL;
+    result->error_message = error ? g_strdup (error->message) : NULL;
+
+    return result;
+}
+
 /* Valid vdo_index_memory_size_mb values: 256, 512, 768, or any multiple of 1024 */
 void _lvm_check_vdo_index_memory (guint64 index_memory) {
     guint64 index_memory_mb = index_memory / (1024 * 1024);
@@ -287,6 +524,101 @@ void bd_lvm_cache_stats_free (BDLVMCacheStats *data) {
     g_free (data);
 }
 
+BDLVMWritecacheStats* bd_lvm_writecache_stats_copy (BDLVMWritecacheStats *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMWritecacheStats *new = g_new0 (BDLVMWritecacheStats, 1);
+
+    new->block_size = data->block_size;
+    new->cache_size = data->cache_size;
+    new->cache_used = data->cache_used;
+    new->total_blocks = data->total_blocks;
+    new->free_blocks = data->free_blocks;
+    new->writeback_blocks = data->writeback_blocks;
+    new->error = data->error;
+
+    return new;
+}
+
+void bd_lvm_writecache_stats_free (BDLVMWritecacheStats *data) {
+    g_free (data);
+}
+
+BDLVMRAIDStats* bd_lvm_raid_stats_copy (BDLVMRAIDStats *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMRAIDStats *new = g_new0 (BDLVMRAIDStats, 1);
+
+    new->raid_type = g_strdup (data->raid_type);
+    new->dev_count = data->dev_count;
+    new->dev_health = g_strdup (data->dev_health);
+    new->total_regions = data->total_regions;
+    new->insync_regions = data->insync_regions;
+    new->sync_ratio = data->sync_ratio;
+    new->sync_action = g_strdup (data->sync_action);
+    new->mismatch_count = data->mismatch_count;
+
+    return new;
+}
+
+void bd_lvm_raid_stats_free (BDLVMRAIDStats *data) {
+    if (data == NULL)
+        return;
+
+    g_free (data->raid_type);
+    g_free (data->dev_health);
+    g_free (data->sync_action);
+    g_free (data);
+}
+
+BDLVMThPoolStats* bd_lvm_thpool_stats_copy (BDLVMThPoolStats *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMThPoolStats *new = g_new0 (BDLVMThPoolStats, 1);
+
+    new->transaction_id = data->transaction_id;
+    new->block_size = data->block_size;
+    new->data_size = data->data_size;
+    new->data_used = data->data_used;
+    new->data_total_blocks = data->data_total_blocks;
+    new->data_used_blocks = data->data_used_blocks;
+    new->md_block_size = data->md_block_size;
+    new->md_size = data->md_size;
+    new->md_used = data->md_used;
+    new->md_total_blocks = data->md_total_blocks;
+    new->md_used_blocks = data->md_used_blocks;
+    new->held_md_root = data->held_md_root;
+    new->needs_check = data->needs_check;
+    new->error_if_no_space = data->error_if_no_space;
+    new->mode = data->mode;
+
+    return new;
+}
+
+void bd_lvm_thpool_stats_free (BDLVMThPoolStats *data) {
+    g_free (data);
+}
+
+BDLVMThLVStats* bd_lvm_thlv_stats_copy (BDLVMThLVStats *data) {
+    if (data == NULL)
+        return NULL;
+
+    BDLVMThLVStats *new = g_new0 (BDLVMThLVStats, 1);
+
+    new->mapped_size = data->mapped_size;
+    new->highest_mapped = data->highest_mapped;
+    new->failed = data->failed;
+
+    return new;
+}
+
+void bd_lvm_thlv_stats_free (BDLVMThLVStats *data) {
+    g_free (data);
+}
+
 /**
  * bd_lvm_is_supported_pe_size:
  * @size: size (in bytes) to test
@@ -860,9 +1192,9 @@ static gboolean _lvm_devices_enabled () {
         config_arg = g_strdup_printf ("--config=%s", global_config_str);
         args[4] = config_arg;
     }
+    g_mutex_unlock (&global_config_lock);
 
     ret = bd_utils_exec_and_capture_output (args, NULL, &output, &loc_error);
-    g_mutex_unlock (&global_config_lock);
     if (ret) {
         scanned = sscanf (output, "use_devicesfile=%u", &enabled);
         g_free (output);
@@ -1129,7 +1461,7 @@ BDLVMCacheStats* bd_lvm_cache_stats (const gchar *vg_name, const gchar *cached_l
         return NULL;
     }
 
-    if (dm_task_run (task) == 0) {
+    if (BD_PROBE_CALL (dm_task_run, dm_task_run (task)) == 0) {
         g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
                      "Failed to run the DM task for the cache map '%s': ", map_name);
         dm_task_destroy (task);
@@ -1196,3 +1528,1072 @@ BDLVMCacheStats* bd_lvm_cache_stats (const gchar *vg_name, const gchar *cached_l
 
     return ret;
 }
+
+/* runs the @task_type DM task for the @map_name map and gets the params of its
+   first target which must be @target_type, the returned task owns @params */
+static struct dm_task* _get_dm_target_params (int task_type, const gchar *map_name, const gchar *target_type,
+                                              gchar **params, GError **error) {
+    struct dm_task *task = NULL;
+    struct dm_info info;
+    guint64 start = 0;
+    guint64 length = 0;
+    gchar *type = NULL;
+
+    task = dm_task_create (task_type);
+    if (!task) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to create DM task for the map '%s'", map_name);
+        return NULL;
+    }
+
+    if (dm_task_set_name (task, map_name) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to create DM task for the map '%s'", map_name);
+        dm_task_destroy (task);
+        return NULL;
+    }
+
+    if (BD_PROBE_CALL (dm_task_run, dm_task_run (task)) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to run the DM task for the map '%s'", map_name);
+        dm_task_destroy (task);
+        return NULL;
+    }
+
+    if (dm_task_get_info (task, &info) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to get task info for the map '%s'", map_name);
+        dm_task_destroy (task);
+        return NULL;
+    }
+
+    if (!info.exists) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
+                     "The map '%s' doesn't exist", map_name);
+        dm_task_destroy (task);
+        return NULL;
+    }
+
+    dm_get_next_target (task, NULL, &start, &length, &type, params);
+    if (g_strcmp0 (type, target_type) != 0 || !*params) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "The map '%s' is not a '%s' map", map_name, target_type);
+        dm_task_destroy (task);
+        return NULL;
+    }
+
+    return task;
+}
+
+/**
+ * bd_lvm_thpool_stats:
+ * @vg_name: name of the VG containing the @pool_name thin pool
+ * @pool_name: thin pool LV to get stats for
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets the stats from the device-mapper status of the (active) thin pool
+ * directly, without running any LVM commands.
+ *
+ * Returns: stats for the @pool_name thin pool or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_THIN-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMThPoolStats* bd_lvm_thpool_stats (const gchar *vg_name, const gchar *pool_name, GError **error) {
+    struct dm_pool *pool = NULL;
+    struct dm_task *task = NULL;
+    struct dm_status_thin_pool *status = NULL;
+    gchar *map_name = NULL;
+    gchar *params = NULL;
+    guint64 block_size = 0;
+    BDLVMThPoolStats *ret = NULL;
+    GError *l_error = NULL;
+
+    pool = dm_pool_create ("bd-pool", 20);
+
+    /* the thin-pool target is in the "-tpool" layer if the pool is used by
+       active thin LVs, otherwise it may be directly in the pool LV */
+    map_name = dm_build_dm_name (pool, vg_name, pool_name, "tpool");
+    task = _get_dm_target_params (DM_DEVICE_STATUS, map_name, "thin-pool", &params, &l_error);
+    if (!task && g_error_matches (l_error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST)) {
+        g_clear_error (&l_error);
+        map_name = dm_build_dm_name (pool, vg_name, pool_name, NULL);
+        task = _get_dm_target_params (DM_DEVICE_STATUS, map_name, "thin-pool", &params, &l_error);
+    }
+    if (!task) {
+        g_propagate_prefixed_error (error, l_error, "Failed to get status of the thin pool '%s/%s': ",
+                                    vg_name, pool_name);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+
+    if (dm_get_status_thin_pool (pool, params, &status) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to parse status of the thin pool map '%s'", map_name);
+        dm_task_destroy (task);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+    dm_task_destroy (task);
+
+    /* data block size is only in the table:
+       <metadata dev> <data dev> <data block size> <low water mark> [<features>] */
+    task = _get_dm_target_params (DM_DEVICE_TABLE, map_name, "thin-pool", &params, &l_error);
+    if (!task) {
+        g_propagate_prefixed_error (error, l_error, "Failed to get table of the thin pool '%s/%s': ",
+                                    vg_name, pool_name);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+    if (sscanf (params, "%*s %*s %"G_GUINT64_FORMAT, &block_size) != 1) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to get data block size of the thin pool map '%s' from '%s'", map_name, params);
+        dm_task_destroy (task);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+    dm_task_destroy (task);
+
+    ret = g_new0 (BDLVMThPoolStats, 1);
+    ret->transaction_id = status->transaction_id;
+
+    ret->block_size = block_size * SECTOR_SIZE;
+    ret->data_total_blocks = status->total_data_blocks;
+    ret->data_used_blocks = status->used_data_blocks;
+    ret->data_size = ret->data_total_blocks * ret->block_size;
+    ret->data_used = ret->data_used_blocks * ret->block_size;
+
+    ret->md_block_size = THIN_METADATA_BLOCK_SIZE;
+    ret->md_total_blocks = status->total_metadata_blocks;
+    ret->md_used_blocks = status->used_metadata_blocks;
+    ret->md_size = ret->md_total_blocks * ret->md_block_size;
+    ret->md_used = ret->md_used_blocks * ret->md_block_size;
+
+    ret->held_md_root = status->held_metadata_root;
+    ret->needs_check = status->needs_check;
+    ret->error_if_no_space = status->error_if_no_space;
+
+    if (status->fail)
+        ret->mode = BD_LVM_THPOOL_MODE_FAIL;
+    else if (status->read_only)
+        ret->mode = BD_LVM_THPOOL_MODE_READ_ONLY;
+    else if (status->out_of_data_space)
+        ret->mode = BD_LVM_THPOOL_MODE_OUT_OF_DATA_SPACE;
+    else
+        ret->mode = BD_LVM_THPOOL_MODE_READ_WRITE;
+
+    dm_pool_destroy (pool);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_thlv_stats:
+ * @vg_name: name of the VG containing the @thlv_name thin LV
+ * @thlv_name: thin LV to get stats for
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets the stats from the device-mapper status of the (active) thin LV
+ * directly, without running any LVM commands.
+ *
+ * Returns: stats for the @thlv_name thin LV or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_THIN-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMThLVStats* bd_lvm_thlv_stats (const gchar *vg_name, const gchar *thlv_name, GError **error) {
+    struct dm_pool *pool = NULL;
+    struct dm_task *task = NULL;
+    struct dm_status_thin *status = NULL;
+    gchar *map_name = NULL;
+    gchar *params = NULL;
+    BDLVMThLVStats *ret = NULL;
+    GError *l_error = NULL;
+
+    pool = dm_pool_create ("bd-pool", 20);
+
+    map_name = dm_build_dm_name (pool, vg_name, thlv_name, NULL);
+    task = _get_dm_target_params (DM_DEVICE_STATUS, map_name, "thin", &params, &l_error);
+    if (!task) {
+        g_propagate_prefixed_error (error, l_error, "Failed to get status of the thin LV '%s/%s': ",
+                                    vg_name, thlv_name);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+
+    if (dm_get_status_thin (pool, params, &status) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to parse status of the thin map '%s'", map_name);
+        dm_task_destroy (task);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+
+    ret = g_new0 (BDLVMThLVStats, 1);
+    ret->mapped_size = status->mapped_sectors * SECTOR_SIZE;
+    ret->highest_mapped = status->mapped_sectors ? (status->highest_mapped_sector + 1) * SECTOR_SIZE : 0;
+    ret->failed = status->fail;
+
+    dm_task_destroy (task);
+    dm_pool_destroy (pool);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_writecache_stats:
+ * @vg_name: name of the VG containing the @cached_lv
+ * @cached_lv: LV cached with dm-writecache to get stats for
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets the stats from the device-mapper status of the (active) writecache
+ * directly, without running any LVM commands.
+ *
+ * Returns: stats for the @cached_lv or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_WRITECACHE-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMWritecacheStats* bd_lvm_writecache_stats (const gchar *vg_name, const gchar *cached_lv, GError **error) {
+    struct dm_pool *pool = NULL;
+    struct dm_task *task = NULL;
+    struct dm_status_writecache *status = NULL;
+    gchar *map_name = NULL;
+    gchar *params = NULL;
+    guint64 block_size = 0;
+    BDLVMWritecacheStats *ret = NULL;
+    GError *l_error = NULL;
+
+    pool = dm_pool_create ("bd-pool", 20);
+
+    map_name = dm_build_dm_name (pool, vg_name, cached_lv, NULL);
+    task = _get_dm_target_params (DM_DEVICE_STATUS, map_name, "writecache", &params, &l_error);
+    if (!task) {
+        g_propagate_prefixed_error (error, l_error, "Failed to get status of the writecache '%s/%s': ",
+                                    vg_name, cached_lv);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+
+    if (dm_get_status_writecache (pool, params, &status) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to parse status of the writecache map '%s'", map_name);
+        dm_task_destroy (task);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+    dm_task_destroy (task);
+
+    /* block size (in bytes) is only in the table:
+       <p|s> <origin dev> <cache dev> <block size> <#feature args> [<features>] */
+    task = _get_dm_target_params (DM_DEVICE_TABLE, map_name, "writecache", &params, &l_error);
+    if (!task) {
+        g_propagate_prefixed_error (error, l_error, "Failed to get table of the writecache '%s/%s': ",
+                                    vg_name, cached_lv);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+    if (sscanf (params, "%*s %*s %*s %"G_GUINT64_FORMAT, &block_size) != 1) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to get block size of the writecache map '%s' from '%s'", map_name, params);
+        dm_task_destroy (task);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+    dm_task_destroy (task);
+
+    ret = g_new0 (BDLVMWritecacheStats, 1);
+    ret->block_size = block_size;
+    ret->total_blocks = status->total_blocks;
+    ret->free_blocks = status->free_blocks;
+    ret->writeback_blocks = status->writeback_blocks;
+    ret->cache_size = ret->total_blocks * ret->block_size;
+    ret->cache_used = (ret->total_blocks - ret->free_blocks) * ret->block_size;
+    ret->error = status->error;
+
+    dm_pool_destroy (pool);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_raid_stats:
+ * @vg_name: name of the VG containing the @lv_name RAID LV
+ * @lv_name: RAID LV to get stats for
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets the stats from the device-mapper status of the (active) RAID LV
+ * directly, without running any LVM commands.
+ *
+ * Returns: stats for the @lv_name RAID LV or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMRAIDStats* bd_lvm_raid_stats (const gchar *vg_name, const gchar *lv_name, GError **error) {
+    struct dm_pool *pool = NULL;
+    struct dm_task *task = NULL;
+    struct dm_status_raid *status = NULL;
+    gchar *map_name = NULL;
+    gchar *params = NULL;
+    BDLVMRAIDStats *ret = NULL;
+    GError *l_error = NULL;
+
+    pool = dm_pool_create ("bd-pool", 20);
+
+    map_name = dm_build_dm_name (pool, vg_name, lv_name, NULL);
+    task = _get_dm_target_params (DM_DEVICE_STATUS, map_name, "raid", &params, &l_error);
+    if (!task) {
+        g_propagate_prefixed_error (error, l_error, "Failed to get status of the RAID LV '%s/%s': ",
+                                    vg_name, lv_name);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+
+    if (dm_get_status_raid (pool, params, &status) == 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
+                     "Failed to parse status of the RAID map '%s'", map_name);
+        dm_task_destroy (task);
+        dm_pool_destroy (pool);
+        return NULL;
+    }
+
+    ret = g_new0 (BDLVMRAIDStats, 1);
+    ret->raid_type = g_strdup (status->raid_type);
+    ret->dev_count = status->dev_count;
+    ret->dev_health = g_strdup (status->dev_health);
+    ret->total_regions = status->total_regions;
+    ret->insync_regions = status->insync_regions;
+    if (status->total_regions > 0)
+        ret->sync_ratio = (gdouble) status->insync_regions / (gdouble) status->total_regions;
+    /* older kernels don't report the sync action */
+    ret->sync_action = g_strdup (status->sync_action ? status->sync_action : "");
+    ret->mismatch_count = status->mismatch_count;
+
+    /* the status strings are allocated from the pool */
+    dm_task_destroy (task);
+    dm_pool_destroy (pool);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_state_snapshot_new:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets information about all PVs, VGs and LVs in the system (see
+ * bd_lvm_full_report()) and indexes it for fast lookups. Building the indices
+ * takes time linear in the number of PVs, VGs, LVs and their segments.
+ *
+ * Returns: (transfer full): a new snapshot of the LVM state or %NULL in case
+ * of error (the @error) gets populated in those cases)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMStateSnapshot* bd_lvm_state_snapshot_new (GError **error) {
+    BDLVMFullReport *report = NULL;
+    BDLVMStateSnapshot *snapshot = NULL;
+    BDLVMPVdata *pv = NULL;
+    BDLVMVGdata *vg = NULL;
+    BDLVMLVdata *lv = NULL;
+    GPtrArray *pv_lvs = NULL;
+    struct dm_pool *pool = NULL;
+    char *dm_name = NULL;
+    guint64 i = 0;
+    guint64 j = 0;
+
+    report = bd_lvm_full_report (error);
+    if (!report)
+        return NULL;
+
+    snapshot = g_new0 (BDLVMStateSnapshot, 1);
+    snapshot->ref_count = 1;
+    snapshot->pvs = report->pvs;
+    snapshot->vgs = report->vgs;
+    snapshot->lvs = report->lvs;
+    g_free (report);
+
+    /* all the keys are owned by the tables, values point to the data in the snapshot */
+    snapshot->pvs_by_uuid = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->pvs_by_path = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->vgs_by_uuid = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->vgs_by_name = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->lvs_by_uuid = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->lvs_by_name = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->lvs_by_path = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    snapshot->lvs_by_pv = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+
+    for (i = 0; snapshot->pvs[i]; i++) {
+        pv = snapshot->pvs[i];
+        if (pv->pv_uuid)
+            g_hash_table_insert (snapshot->pvs_by_uuid, g_strdup (pv->pv_uuid), pv);
+        if (pv->pv_name) {
+            g_hash_table_insert (snapshot->pvs_by_path, g_strdup (pv->pv_name), pv);
+            g_hash_table_insert (snapshot->lvs_by_pv, g_strdup (pv->pv_name), g_ptr_array_new ());
+        }
+    }
+
+    for (i = 0; snapshot->vgs[i]; i++) {
+        vg = snapshot->vgs[i];
+        if (vg->uuid)
+            g_hash_table_insert (snapshot->vgs_by_uuid, g_strdup (vg->uuid), vg);
+        if (vg->name)
+            g_hash_table_insert (snapshot->vgs_by_name, g_strdup (vg->name), vg);
+    }
+
+    /* the device-mapper names are allocated from the pool */
+    pool = dm_pool_create ("bd-pool", 20);
+    for (i = 0; snapshot->lvs[i]; i++) {
+        lv = snapshot->lvs[i];
+        if (lv->uuid)
+            g_hash_table_insert (snapshot->lvs_by_uuid, g_strdup (lv->uuid), lv);
+        if (lv->vg_name && lv->lv_name) {
+            g_hash_table_insert (snapshot->lvs_by_name, g_strdup_printf ("%s/%s", lv->vg_name, lv->lv_name), lv);
+            g_hash_table_insert (snapshot->lvs_by_path, g_strdup_printf ("/dev/%s/%s", lv->vg_name, lv->lv_name), lv);
+            dm_name = dm_build_dm_name (pool, lv->vg_name, lv->lv_name, NULL);
+            if (dm_name)
+                g_hash_table_insert (snapshot->lvs_by_path, g_strdup_printf ("/dev/mapper/%s", dm_name), lv);
+        }
+
+        for (j = 0; lv->segs && lv->segs[j]; j++) {
+            if (!lv->segs[j]->pvdev)
+                continue;
+            pv_lvs = g_hash_table_lookup (snapshot->lvs_by_pv, lv->segs[j]->pvdev);
+            if (!pv_lvs) {
+                pv_lvs = g_ptr_array_new ();
+                g_hash_table_insert (snapshot->lvs_by_pv, g_strdup (lv->segs[j]->pvdev), pv_lvs);
+            }
+            /* segments of one LV are processed together so checking the last
+               item is enough to avoid duplicates */
+            if (pv_lvs->len == 0 || g_ptr_array_index (pv_lvs, pv_lvs->len - 1) != lv)
+                g_ptr_array_add (pv_lvs, lv);
+        }
+    }
+    dm_pool_destroy (pool);
+
+    return snapshot;
+}
+
+/**
+ * bd_lvm_state_snapshot_get_pv:
+ * @snapshot: snapshot to search in
+ * @device: device path of the PV (as reported by LVM, e.g. "/dev/sda1") or its UUID
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer none): information about the @device PV in @snapshot or
+ * %NULL if not found (the @error) gets populated in those cases)
+ *
+ * Tech category: always provided/supported
+ */
+BDLVMPVdata* bd_lvm_state_snapshot_get_pv (BDLVMStateSnapshot *snapshot, const gchar *device, GError **error) {
+    BDLVMPVdata *ret = NULL;
+
+    ret = g_hash_table_lookup (snapshot->pvs_by_path, device);
+    if (!ret)
+        ret = g_hash_table_lookup (snapshot->pvs_by_uuid, device);
+    if (!ret)
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
+                     "PV '%s' not found", device);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_state_snapshot_get_vg:
+ * @snapshot: snapshot to search in
+ * @vg_name: name or UUID of the VG
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer none): information about the @vg_name VG in @snapshot or
+ * %NULL if not found (the @error) gets populated in those cases)
+ *
+ * Tech category: always provided/supported
+ */
+BDLVMVGdata* bd_lvm_state_snapshot_get_vg (BDLVMStateSnapshot *snapshot, const gchar *vg_name, GError **error) {
+    BDLVMVGdata *ret = NULL;
+
+    ret = g_hash_table_lookup (snapshot->vgs_by_name, vg_name);
+    if (!ret)
+        ret = g_hash_table_lookup (snapshot->vgs_by_uuid, vg_name);
+    if (!ret)
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
+                     "VG '%s' not found", vg_name);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_state_snapshot_get_lv:
+ * @snapshot: snapshot to search in
+ * @vg_name: (nullable): name of the VG containing the LV or %NULL if @lv_name
+ *                       is a UUID or a device path
+ * @lv_name: name of the LV, its UUID or its device path ("/dev/VG/LV" or
+ *           "/dev/mapper/VG-LV")
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer none): information about the LV in @snapshot or %NULL if
+ * not found (the @error) gets populated in those cases)
+ *
+ * Tech category: always provided/supported
+ */
+BDLVMLVdata* bd_lvm_state_snapshot_get_lv (BDLVMStateSnapshot *snapshot, const gchar *vg_name, const gchar *lv_name, GError **error) {
+    BDLVMLVdata *ret = NULL;
+    gchar *key = NULL;
+
+    if (vg_name) {
+        key = g_strdup_printf ("%s/%s", vg_name, lv_name);
+        ret = g_hash_table_lookup (snapshot->lvs_by_name, key);
+        g_free (key);
+    } else {
+        ret = g_hash_table_lookup (snapshot->lvs_by_path, lv_name);
+        if (!ret)
+            ret = g_hash_table_lookup (snapshot->lvs_by_uuid, lv_name);
+    }
+
+    if (!ret)
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
+                     "LV '%s%s%s' not found", vg_name ? vg_name : "", vg_name ? "/" : "", lv_name);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_state_snapshot_get_pv_lvs:
+ * @snapshot: snapshot to search in
+ * @device: device path of the PV (as reported by LVM, e.g. "/dev/sda1") or its UUID
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer container) (array zero-terminated=1): LVs with at least
+ * one segment on the @device PV or %NULL if @device is not a PV in @snapshot
+ * (the @error) gets populated in those cases)
+ *
+ * Tech category: always provided/supported
+ */
+BDLVMLVdata** bd_lvm_state_snapshot_get_pv_lvs (BDLVMStateSnapshot *snapshot, const gchar *device, GError **error) {
+    BDLVMPVdata *pv = NULL;
+    GPtrArray *pv_lvs = NULL;
+    BDLVMLVdata **ret = NULL;
+
+    pv = bd_lvm_state_snapshot_get_pv (snapshot, device, error);
+    if (!pv)
+        return NULL;
+
+    if (pv->pv_name)
+        pv_lvs = g_hash_table_lookup (snapshot->lvs_by_pv, pv->pv_name);
+    ret = g_new0 (BDLVMLVdata *, (pv_lvs ? pv_lvs->len : 0) + 1);
+    if (pv_lvs && pv_lvs->len > 0)
+        memcpy (ret, pv_lvs->pdata, pv_lvs->len * sizeof (BDLVMLVdata *));
+
+    return ret;
+}
+
+typedef struct LVMWatcherPriv {
+    GMutex lock;
+    struct udev *udev;
+    struct udev_monitor *monitor;
+    /* VG name -> BDLVMVGdata */
+    GHashTable *vgs;
+    /* VG name -> (LV name -> BDLVMLVdata) */
+    GHashTable *lvs;
+    /* VGs (and whether all VGs need to be rescanned) from the udev events of a
+       failed bd_lvm_watcher_process() call to be processed by the next one */
+    GHashTable *pending_vgs;
+    gboolean pending_rescan;
+} LVMWatcherPriv;
+
+/* refreshed state of a VG not applied to the cached state yet */
+typedef struct LVMWatcherVGState {
+    const gchar *vg_name;
+    BDLVMVGdata *vg;
+    GHashTable *lvs;
+} LVMWatcherVGState;
+
+static void _watcher_vg_state_free (LVMWatcherVGState *state) {
+    bd_lvm_vgdata_free (state->vg);
+    if (state->lvs)
+        g_hash_table_destroy (state->lvs);
+    g_free (state);
+}
+
+static void _watcher_priv_free (LVMWatcherPriv *priv) {
+    if (priv->monitor)
+        udev_monitor_unref (priv->monitor);
+    if (priv->udev)
+        udev_unref (priv->udev);
+    g_hash_table_destroy (priv->vgs);
+    g_hash_table_destroy (priv->lvs);
+    if (priv->pending_vgs)
+        g_hash_table_destroy (priv->pending_vgs);
+    g_mutex_clear (&priv->lock);
+    g_free (priv);
+}
+
+static GHashTable* _watcher_lvs_table_new (void) {
+    return g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) bd_lvm_lvdata_free);
+}
+
+/* adds @lvs (taking them over) to the tables of LVs of their VGs in @vg_lvs */
+static void _watcher_index_lvs (GHashTable *vg_lvs, BDLVMLVdata **lvs) {
+    BDLVMLVdata **lv_p = NULL;
+    GHashTable *table = NULL;
+
+    for (lv_p = lvs; *lv_p; lv_p++) {
+        table = g_hash_table_lookup (vg_lvs, (*lv_p)->vg_name);
+        if (!table) {
+            table = _watcher_lvs_table_new ();
+            g_hash_table_insert (vg_lvs, g_strdup ((*lv_p)->vg_name), table);
+        }
+        g_hash_table_replace (table, (*lv_p)->lv_name, *lv_p);
+    }
+}
+
+/**
+ * bd_lvm_watcher_new:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Starts watching udev events of block devices for changes of LVM PVs and
+ * device-mapper devices of LVs and gets the current list of VGs and LVs in
+ * the system. Use bd_lvm_watcher_process() to get the changes since the
+ * previous call.
+ *
+ * Returns: (transfer full): a new LVM watcher or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMWatcher* bd_lvm_watcher_new (GError **error) {
+    LVMWatcherPriv *priv = NULL;
+    BDLVMWatcher *watcher = NULL;
+    BDLVMVGdata **vgs = NULL;
+    BDLVMVGdata **vg_p = NULL;
+    BDLVMLVdata **lvs = NULL;
+
+    priv = g_new0 (LVMWatcherPriv, 1);
+    g_mutex_init (&priv->lock);
+    priv->vgs = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) bd_lvm_vgdata_free);
+    priv->lvs = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_destroy);
+
+    priv->udev = udev_new ();
+    if (!priv->udev) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                             "Failed to create udev context");
+        _watcher_priv_free (priv);
+        return NULL;
+    }
+
+    /* events processed by udev (not the raw kernel ones) so that the DM_* and
+       ID_FS_* properties are set */
+    priv->monitor = udev_monitor_new_from_netlink (priv->udev, "udev");
+    if (!priv->monitor ||
+        udev_monitor_filter_add_match_subsystem_devtype (priv->monitor, "block", NULL) < 0 ||
+        udev_monitor_enable_receiving (priv->monitor) < 0) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                             "Failed to start monitoring udev events");
+        _watcher_priv_free (priv);
+        return NULL;
+    }
+    /* LVM operations on many LVs generate bursts of events, try to make sure
+       none of them get lost before they are processed (needs privileges) */
+    udev_monitor_set_receive_buffer_size (priv->monitor, 16 * 1024 * 1024);
+
+    /* the monitor is running already so nothing happening after these reports
+       can be missed */
+    vgs = bd_lvm_vgs (error);
+    if (!vgs) {
+        _watcher_priv_free (priv);
+        return NULL;
+    }
+    lvs = bd_lvm_lvs (NULL, error);
+    if (!lvs) {
+        for (vg_p = vgs; *vg_p; vg_p++)
+            bd_lvm_vgdata_free (*vg_p);
+        g_free (vgs);
+        _watcher_priv_free (priv);
+        return NULL;
+    }
+
+    for (vg_p = vgs; *vg_p; vg_p++) {
+        g_hash_table_replace (priv->vgs, (*vg_p)->name, *vg_p);
+        g_hash_table_replace (priv->lvs, g_strdup ((*vg_p)->name), _watcher_lvs_table_new ());
+    }
+    g_free (vgs);
+    _watcher_index_lvs (priv->lvs, lvs);
+    g_free (lvs);
+
+    watcher = g_new0 (BDLVMWatcher, 1);
+    watcher->ref_count = 1;
+    watcher->priv = priv;
+    watcher->priv_free = (GDestroyNotify) _watcher_priv_free;
+
+    return watcher;
+}
+
+/**
+ * bd_lvm_watcher_get_fd:
+ * @watcher: LVM watcher to get the file descriptor of
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: file descriptor that becomes readable when there are udev events for
+ *          the @watcher to process (e.g. to be used with poll() or g_unix_fd_add())
+ *          or -1 in case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gint bd_lvm_watcher_get_fd (BDLVMWatcher *watcher, GError **error G_GNUC_UNUSED) {
+    LVMWatcherPriv *priv = watcher->priv;
+
+    return udev_monitor_get_fd (priv->monitor);
+}
+
+/* adds the VG affected by the @device uevent (if any) to @vg_names, sets
+   @rescan_vgs if the VG cannot be determined from the event (PV changes) */
+static void _watcher_handle_uevent (struct udev_device *device, GHashTable *vg_names, gboolean *rescan_vgs) {
+    const gchar *dm_uuid = NULL;
+    const gchar *vg_name = NULL;
+    const gchar *fs_type = NULL;
+
+    dm_uuid = udev_device_get_property_value (device, "DM_UUID");
+    if (dm_uuid && g_str_has_prefix (dm_uuid, "LVM-")) {
+        /* set by the LVM udev rules */
+        vg_name = udev_device_get_property_value (device, "DM_VG_NAME");
+        if (vg_name && *vg_name)
+            g_hash_table_add (vg_names, g_strdup (vg_name));
+        else
+            *rescan_vgs = TRUE;
+        return;
+    }
+
+    fs_type = udev_device_get_property_value (device, "ID_FS_TYPE");
+    if (g_strcmp0 (fs_type, "LVM2_member") == 0)
+        *rescan_vgs = TRUE;
+}
+
+static void _watcher_add_event (GPtrArray *events, BDLVMEventType type, const gchar *vg_name, const gchar *lv_name,
+                                guint64 old_size, guint64 new_size) {
+    BDLVMEvent *event = g_new0 (BDLVMEvent, 1);
+
+    event->type = type;
+    event->vg_name = g_strdup (vg_name);
+    event->lv_name = g_strdup (lv_name);
+    event->old_size = old_size;
+    event->new_size = new_size;
+    g_ptr_array_add (events, event);
+}
+
+static gboolean _lv_is_active (BDLVMLVdata *lv) {
+    return lv->attr && strlen (lv->attr) > 4 && lv->attr[4] == 'a';
+}
+
+/* compares the cached state of the @vg_name VG with @new_vg and @new_lvs
+   (%NULL if the VG is gone), adds the changes to @events and takes over
+   @new_vg and @new_lvs as the new cached state */
+static void _watcher_update_vg (LVMWatcherPriv *priv, const gchar *vg_name, BDLVMVGdata *new_vg,
+                                GHashTable *new_lvs, GPtrArray *events) {
+    BDLVMVGdata *old_vg = NULL;
+    GHashTable *old_lvs = NULL;
+    GHashTableIter iter;
+    BDLVMLVdata *old_lv = NULL;
+    BDLVMLVdata *new_lv = NULL;
+    gchar *name = NULL;
+
+    old_vg = g_hash_table_lookup (priv->vgs, vg_name);
+    old_lvs = g_hash_table_lookup (priv->lvs, vg_name);
+
+    if (!old_vg && new_vg)
+        _watcher_add_event (events, BD_LVM_EVENT_VG_ADDED, vg_name, NULL, 0, 0);
+
+    if (new_lvs) {
+        g_hash_table_iter_init (&iter, new_lvs);
+        while (g_hash_table_iter_next (&iter, (gpointer *) &name, (gpointer *) &new_lv)) {
+            old_lv = old_lvs ? g_hash_table_lookup (old_lvs, name) : NULL;
+            if (!old_lv) {
+                _watcher_add_event (events, BD_LVM_EVENT_LV_ADDED, vg_name, name, 0, new_lv->size);
+                if (_lv_is_active (new_lv))
+                    _watcher_add_event (events, BD_LVM_EVENT_LV_ACTIVATED, vg_name, name, 0, 0);
+                continue;
+            }
+            if (old_lv->size != new_lv->size)
+                _watcher_add_event (events, BD_LVM_EVENT_LV_RESIZED, vg_name, name, old_lv->size, new_lv->size);
+            if (!_lv_is_active (old_lv) && _lv_is_active (new_lv))
+                _watcher_add_event (events, BD_LVM_EVENT_LV_ACTIVATED, vg_name, name, 0, 0);
+            else if (_lv_is_active (old_lv) && !_lv_is_active (new_lv))
+                _watcher_add_event (events, BD_LVM_EVENT_LV_DEACTIVATED, vg_name, name, 0, 0);
+        }
+    }
+
+    if (old_lvs) {
+        g_hash_table_iter_init (&iter, old_lvs);
+        while (g_hash_table_iter_next (&iter, (gpointer *) &name, (gpointer *) &old_lv))
+            if (!new_lvs || !g_hash_table_contains (new_lvs, name))
+                _watcher_add_event (events, BD_LVM_EVENT_LV_REMOVED, vg_name, name, old_lv->size, 0);
+    }
+
+    if (old_vg && new_vg && old_vg->seqno != new_vg->seqno)
+        _watcher_add_event (events, BD_LVM_EVENT_VG_CHANGED, vg_name, NULL, 0, 0);
+    else if (old_vg && !new_vg)
+        _watcher_add_event (events, BD_LVM_EVENT_VG_REMOVED, vg_name, NULL, 0, 0);
+
+    if (new_vg) {
+        g_hash_table_replace (priv->lvs, g_strdup (vg_name), new_lvs);
+        g_hash_table_replace (priv->vgs, new_vg->name, new_vg);
+    } else {
+        g_hash_table_remove (priv->lvs, vg_name);
+        g_hash_table_remove (priv->vgs, vg_name);
+    }
+}
+
+/* gets the current state of the @vg_name VG with a report just for it, @vg is
+   set to %NULL if the VG doesn't exist (anymore) */
+static gboolean _watcher_refresh_vg (const gchar *vg_name, BDLVMVGdata *known_vg, BDLVMVGdata **vg,
+                                     GHashTable **lvs, GError **error) {
+    BDLVMVGdata **vgs = NULL;
+    BDLVMVGdata **vg_p = NULL;
+    BDLVMLVdata **vg_lvs = NULL;
+    BDLVMLVdata **lv_p = NULL;
+    GError *l_error = NULL;
+    gboolean exists = FALSE;
+
+    *vg = known_vg ? known_vg : bd_lvm_vginfo (vg_name, &l_error);
+    if (!*vg) {
+        /* the report for a missing VG fails so check if the VG is really gone
+           or if the report failed for some other reason */
+        vgs = bd_lvm_vgs_with_fields (BD_LVM_QUERY_FIELDS_BASIC, error);
+        if (!vgs) {
+            g_clear_error (&l_error);
+            return FALSE;
+        }
+        for (vg_p = vgs; *vg_p; vg_p++) {
+            exists = exists || g_strcmp0 ((*vg_p)->name, vg_name) == 0;
+            bd_lvm_vgdata_free (*vg_p);
+        }
+        g_free (vgs);
+
+        if (exists) {
+            g_propagate_error (error, l_error);
+            return FALSE;
+        }
+        g_clear_error (&l_error);
+        *lvs = NULL;
+        return TRUE;
+    }
+
+    vg_lvs = bd_lvm_lvs (vg_name, error);
+    if (!vg_lvs) {
+        bd_lvm_vgdata_free (*vg);
+        *vg = NULL;
+        return FALSE;
+    }
+    *lvs = _watcher_lvs_table_new ();
+    for (lv_p = vg_lvs; *lv_p; lv_p++)
+        g_hash_table_replace (*lvs, (*lv_p)->lv_name, *lv_p);
+    g_free (vg_lvs);
+
+    return TRUE;
+}
+
+/**
+ * bd_lvm_watcher_process:
+ * @watcher: LVM watcher to process the events of
+ * @timeout: how long to wait for the first udev event (in milliseconds, 0 to
+ *           not wait at all, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Processes all the pending udev events, refreshes the information only about
+ * the VGs affected by them (with targeted reports for the particular VGs) and
+ * compares it with the previous state. VG metadata sequence numbers are used to
+ * find out which VGs changed when a PV changes. If getting the information
+ * about any of the VGs fails, none of the changes are applied and the VGs are
+ * processed again by the next call.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): changes of VGs and LVs
+ *          since the previous call (empty if nothing changed) or %NULL in case
+ *          of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMEvent** bd_lvm_watcher_process (BDLVMWatcher *watcher, gint timeout, GError **error) {
+    LVMWatcherPriv *priv = watcher->priv;
+    struct pollfd pfd;
+    struct udev_device *device = NULL;
+    GHashTable *vg_names = NULL;
+    GHashTable *known_vgs = NULL;
+    GHashTableIter iter;
+    BDLVMVGdata **vgs = NULL;
+    BDLVMVGdata **vg_p = NULL;
+    BDLVMVGdata *old_vg = NULL;
+    LVMWatcherVGState *state = NULL;
+    GPtrArray *states = NULL;
+    GPtrArray *events = NULL;
+    gboolean rescan_vgs = FALSE;
+    gchar *vg_name = NULL;
+    gint ret = 0;
+    guint i = 0;
+
+    g_mutex_lock (&priv->lock);
+
+    pfd.fd = udev_monitor_get_fd (priv->monitor);
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    do
+        /* no need to wait if there are VGs left from the previous call */
+        ret = poll (&pfd, 1, priv->pending_vgs ? 0 : timeout);
+    while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                     "Failed to wait for udev events: %m");
+        g_mutex_unlock (&priv->lock);
+        return NULL;
+    }
+
+    /* multiple events for the same VG (typical for LVM operations) only
+       result in one refresh of the VG */
+    if (priv->pending_vgs) {
+        vg_names = priv->pending_vgs;
+        rescan_vgs = priv->pending_rescan;
+        priv->pending_vgs = NULL;
+        priv->pending_rescan = FALSE;
+    } else
+        vg_names = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+    while ((device = udev_monitor_receive_device (priv->monitor))) {
+        _watcher_handle_uevent (device, vg_names, &rescan_vgs);
+        udev_device_unref (device);
+    }
+
+    known_vgs = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) bd_lvm_vgdata_free);
+    if (rescan_vgs) {
+        /* a PV changed, VGs can only be identified by their metadata changes */
+        vgs = bd_lvm_vgs (error);
+        if (!vgs) {
+            g_hash_table_destroy (known_vgs);
+            /* the udev events are consumed, keep the VGs for the next call */
+            priv->pending_vgs = vg_names;
+            priv->pending_rescan = TRUE;
+            g_mutex_unlock (&priv->lock);
+            return NULL;
+        }
+        for (vg_p = vgs; *vg_p; vg_p++) {
+            old_vg = g_hash_table_lookup (priv->vgs, (*vg_p)->name);
+            if (!old_vg || old_vg->seqno != (*vg_p)->seqno || g_hash_table_contains (vg_names, (*vg_p)->name)) {
+                g_hash_table_add (vg_names, g_strdup ((*vg_p)->name));
+                g_hash_table_replace (known_vgs, (*vg_p)->name, *vg_p);
+            } else
+                bd_lvm_vgdata_free (*vg_p);
+        }
+        g_free (vgs);
+
+        /* VGs that are gone */
+        g_hash_table_iter_init (&iter, priv->vgs);
+        while (g_hash_table_iter_next (&iter, (gpointer *) &vg_name, (gpointer *) &old_vg))
+            if (!g_hash_table_contains (known_vgs, vg_name) && !g_hash_table_contains (vg_names, vg_name))
+                g_hash_table_add (vg_names, g_strdup (vg_name));
+    }
+
+    /* refresh all the VGs first so that a failure leaves the cached state
+       untouched and nothing is lost */
+    states = g_ptr_array_new_with_free_func ((GDestroyNotify) _watcher_vg_state_free);
+    g_hash_table_iter_init (&iter, vg_names);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &vg_name, NULL)) {
+        state = g_new0 (LVMWatcherVGState, 1);
+        state->vg_name = vg_name;
+        g_ptr_array_add (states, state);
+
+        state->vg = g_hash_table_lookup (known_vgs, vg_name);
+        /* ownership of the known VG is passed to the refreshed state */
+        g_hash_table_steal (known_vgs, vg_name);
+        if (!rescan_vgs || state->vg) {
+            if (!_watcher_refresh_vg (vg_name, state->vg, &(state->vg), &(state->lvs), error)) {
+                g_ptr_array_free (states, TRUE);
+                g_hash_table_destroy (known_vgs);
+                /* the udev events are consumed, keep the VGs for the next call */
+                priv->pending_vgs = vg_names;
+                priv->pending_rescan = rescan_vgs;
+                g_mutex_unlock (&priv->lock);
+                return NULL;
+            }
+        }
+        /* else not in the fresh list of VGs, i.e. gone */
+    }
+
+    events = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_event_free);
+    for (i=0; i < states->len; i++) {
+        state = g_ptr_array_index (states, i);
+        _watcher_update_vg (priv, state->vg_name, state->vg, state->lvs, events);
+        /* taken over by the cached state */
+        state->vg = NULL;
+        state->lvs = NULL;
+    }
+
+    g_ptr_array_free (states, TRUE);
+    g_hash_table_destroy (known_vgs);
+    g_hash_table_destroy (vg_names);
+    g_mutex_unlock (&priv->lock);
+
+    g_ptr_array_set_free_func (events, NULL);
+    g_ptr_array_add (events, NULL);
+    return (BDLVMEvent **) g_ptr_array_free (events, FALSE);
+}
+
+/**
+ * bd_lvm_watcher_get_vgs:
+ * @watcher: LVM watcher to get the VGs from
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer full) (array zero-terminated=1): VGs known to the @watcher
+ *          (as of the last bd_lvm_watcher_process() call) or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMVGdata** bd_lvm_watcher_get_vgs (BDLVMWatcher *watcher, GError **error G_GNUC_UNUSED) {
+    LVMWatcherPriv *priv = watcher->priv;
+    GHashTableIter iter;
+    BDLVMVGdata *vg = NULL;
+    BDLVMVGdata **ret = NULL;
+    guint i = 0;
+
+    g_mutex_lock (&priv->lock);
+    ret = g_new0 (BDLVMVGdata *, g_hash_table_size (priv->vgs) + 1);
+    g_hash_table_iter_init (&iter, priv->vgs);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &vg))
+        ret[i++] = bd_lvm_vgdata_copy (vg);
+    g_mutex_unlock (&priv->lock);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_watcher_get_lvs:
+ * @watcher: LVM watcher to get the LVs from
+ * @vg_name: (nullable): name of the VG to get LVs from or %NULL for all LVs
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer full) (array zero-terminated=1): LVs known to the @watcher
+ *          (as of the last bd_lvm_watcher_process() call) or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata** bd_lvm_watcher_get_lvs (BDLVMWatcher *watcher, const gchar *vg_name, GError **error G_GNUC_UNUSED) {
+    LVMWatcherPriv *priv = watcher->priv;
+    GHashTableIter vg_iter;
+    GHashTableIter lv_iter;
+    GHashTable *vg_lvs = NULL;
+    BDLVMLVdata *lv = NULL;
+    GPtrArray *lvs = NULL;
+
+    lvs = g_ptr_array_new ();
+
+    g_mutex_lock (&priv->lock);
+    if (vg_name) {
+        vg_lvs = g_hash_table_lookup (priv->lvs, vg_name);
+        if (vg_lvs) {
+            g_hash_table_iter_init (&lv_iter, vg_lvs);
+            while (g_hash_table_iter_next (&lv_iter, NULL, (gpointer *) &lv))
+                g_ptr_array_add (lvs, bd_lvm_lvdata_copy (lv));
+        }
+    } else {
+        g_hash_table_iter_init (&vg_iter, priv->lvs);
+        while (g_hash_table_iter_next (&vg_iter, NULL, (gpointer *) &vg_lvs)) {
+            g_hash_table_iter_init (&lv_iter, vg_lvs);
+            while (g_hash_table_iter_next (&lv_iter, NULL, (gpointer *) &lv))
+                g_ptr_array_add (lvs, bd_lvm_lvdata_copy (lv));
+        }
+    }
+    g_mutex_unlock (&priv->lock);
+
+    g_ptr_array_add (lvs, NULL);
+    return (BDLVMLVdata **) g_ptr_array_free (lvs, FALSE);
+}
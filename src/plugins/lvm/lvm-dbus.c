@@ -56,8 +56,10 @@
 #define VDO_POOL_INTF LVM_BUS_NAME".VdoPool"
 #define DBUS_PROPS_IFACE "org.freedesktop.DBus.Properties"
 #define DBUS_INTRO_IFACE "org.freedesktop.DBus.Introspectable"
+#define DBUS_OBJ_MANAGER_IFACE "org.freedesktop.DBus.ObjectManager"
 #define METHOD_CALL_TIMEOUT 5000
-#define PROGRESS_WAIT 500 * 1000 /* microseconds */
+#define JOB_WAIT_FALLBACK 5000 /* milliseconds */
+#define CACHE_DRAIN_INTERVAL 1000 /* milliseconds */
 
 
 static GDBusConnection *bus = NULL;
@@ -160,6 +162,449 @@ static const UtilFeatureDep features[FEATURES_LAST] = {
 
 static const gchar*const module_deps[MODULE_DEPS_LAST] = { "dm-vdo" };
 
+/**
+ * call_get_managed_objects:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer full): all the objects lvmdbusd manages with all their
+ *                           interfaces and properties ('a{oa{sa{sv}}}')
+ */
+static GVariant* call_get_managed_objects (GError **error) {
+    GVariant *ret = NULL;
+    GVariant *objects = NULL;
+
+    ret = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, LVM_OBJ_PREFIX, DBUS_OBJ_MANAGER_IFACE,
+                                       "GetManagedObjects", NULL, G_VARIANT_TYPE ("(a{oa{sa{sv}}})"),
+                                       G_DBUS_CALL_FLAGS_NONE, -1, NULL, error);
+    if (!ret) {
+        g_prefix_error (error, "Failed to get the objects managed by lvmdbusd: ");
+        return NULL;
+    }
+
+    objects = g_variant_get_child_value (ret, 0);
+    g_variant_unref (ret);
+
+    return objects;
+}
+
+/* Mirror of the lvmdbusd objects (see bd_lvm_set_dbus_cache()). It is filled
+   with a single GetManagedObjects call and then kept up to date based on the
+   InterfacesAdded, InterfacesRemoved and PropertiesChanged signals. The
+   signals are dispatched (from the private main context) when the cache is
+   used and every CACHE_DRAIN_INTERVAL by a background thread so that they
+   don't pile up if the cache is not used, always with the cache_lock held. */
+static GMutex cache_lock;
+static GCond cache_cond;
+static GThread *cache_drain_thread = NULL;
+static gboolean cache_enabled = FALSE;
+static gboolean cache_stale = TRUE;
+static GMainContext *cache_context = NULL;
+static guint cache_sub_ids[2] = {0, 0};
+static guint cache_n_subs = 0;
+static GHashTable *cache_objects = NULL;   /* object path -> (interface -> a{sv}) */
+static GHashTable *cache_ids = NULL;       /* LVM ID -> object path */
+static gboolean cache_ids_stale = TRUE;
+static BDLVMDBusCacheStats cache_stats;
+
+static GHashTable* cache_new_ifaces_table (void) {
+    return g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
+}
+
+static void cache_add_interfaces (const gchar *path, GVariant *ifaces) {
+    GHashTable *obj_ifaces = NULL;
+    GVariantIter iter;
+    const gchar *iface = NULL;
+    GVariant *props = NULL;
+
+    obj_ifaces = g_hash_table_lookup (cache_objects, path);
+    if (!obj_ifaces) {
+        obj_ifaces = cache_new_ifaces_table ();
+        g_hash_table_insert (cache_objects, g_strdup (path), obj_ifaces);
+    }
+
+    g_variant_iter_init (&iter, ifaces);
+    while (g_variant_iter_next (&iter, "{&s@a{sv}}", &iface, &props))
+        g_hash_table_insert (obj_ifaces, g_strdup (iface), props);
+
+    cache_ids_stale = TRUE;
+}
+
+/* returns whether the cache was changed or not */
+static gboolean cache_remove_interfaces (const gchar *path, GVariant *ifaces) {
+    GHashTable *obj_ifaces = NULL;
+    GVariantIter iter;
+    const gchar *iface = NULL;
+
+    obj_ifaces = g_hash_table_lookup (cache_objects, path);
+    if (!obj_ifaces)
+        return FALSE;
+
+    g_variant_iter_init (&iter, ifaces);
+    while (g_variant_iter_next (&iter, "&s", &iface))
+        g_hash_table_remove (obj_ifaces, iface);
+
+    if (g_hash_table_size (obj_ifaces) == 0)
+        g_hash_table_remove (cache_objects, path);
+
+    cache_ids_stale = TRUE;
+    return TRUE;
+}
+
+/* returns whether the cache was changed or not */
+static gboolean cache_update_properties (const gchar *path, const gchar *iface, GVariant *changed, GVariant *invalidated) {
+    GHashTable *obj_ifaces = NULL;
+    GVariant *props = NULL;
+    GVariantDict dict;
+    GVariantIter iter;
+    const gchar *name = NULL;
+    GVariant *value = NULL;
+
+    obj_ifaces = g_hash_table_lookup (cache_objects, path);
+    if (obj_ifaces)
+        props = g_hash_table_lookup (obj_ifaces, iface);
+    if (!props) {
+        /* an object (or interface) we don't know about, we must have missed
+           something so let's just refill the cache on the next use */
+        cache_stale = TRUE;
+        return FALSE;
+    }
+
+    g_variant_dict_init (&dict, props);
+    g_variant_iter_init (&iter, changed);
+    while (g_variant_iter_next (&iter, "{&sv}", &name, &value)) {
+        g_variant_dict_insert_value (&dict, name, value);
+        g_variant_unref (value);
+    }
+    /* we don't know the new values of the invalidated properties, they
+       will be fetched from lvmdbusd when needed */
+    g_variant_iter_init (&iter, invalidated);
+    while (g_variant_iter_next (&iter, "&s", &name))
+        g_variant_dict_remove (&dict, name);
+
+    g_hash_table_insert (obj_ifaces, g_strdup (iface), g_variant_ref_sink (g_variant_dict_end (&dict)));
+
+    if (g_strcmp0 (iface, JOB_INTF) != 0)
+        cache_ids_stale = TRUE;
+    return TRUE;
+}
+
+static void cache_signal (GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender_name G_GNUC_UNUSED,
+                          const gchar *object_path, const gchar *interface_name G_GNUC_UNUSED,
+                          const gchar *signal_name, GVariant *parameters, gpointer user_data G_GNUC_UNUSED) {
+    const gchar *path = NULL;
+    const gchar *iface = NULL;
+    GVariant *ifaces = NULL;
+    GVariant *changed = NULL;
+    GVariant *invalidated = NULL;
+    gboolean applied = FALSE;
+
+    if (!cache_objects)
+        return;
+
+    if (g_strcmp0 (signal_name, "InterfacesAdded") == 0 &&
+        g_variant_check_format_string (parameters, "(&o@a{sa{sv}})", FALSE)) {
+        g_variant_get (parameters, "(&o@a{sa{sv}})", &path, &ifaces);
+        cache_add_interfaces (path, ifaces);
+        g_variant_unref (ifaces);
+        applied = TRUE;
+    } else if (g_strcmp0 (signal_name, "InterfacesRemoved") == 0 &&
+               g_variant_check_format_string (parameters, "(&o@as)", FALSE)) {
+        g_variant_get (parameters, "(&o@as)", &path, &ifaces);
+        applied = cache_remove_interfaces (path, ifaces);
+        g_variant_unref (ifaces);
+    } else if (g_strcmp0 (signal_name, "PropertiesChanged") == 0 &&
+               g_variant_check_format_string (parameters, "(&s@a{sv}@as)", FALSE)) {
+        g_variant_get (parameters, "(&s@a{sv}@as)", &iface, &changed, &invalidated);
+        /* jobs are never answered from the cache, no need to track them */
+        if (g_strcmp0 (iface, JOB_INTF) != 0)
+            applied = cache_update_properties (object_path, iface, changed, invalidated);
+        g_variant_unref (changed);
+        g_variant_unref (invalidated);
+    }
+
+    if (applied)
+        cache_stats.updates++;
+}
+
+static void cache_signal_unsubscribed (gpointer user_data G_GNUC_UNUSED) {
+    cache_n_subs--;
+}
+
+/* must be called with cache_lock held */
+static void cache_process_signals (void) {
+    while (g_main_context_iteration (cache_context, FALSE))
+        ;
+}
+
+static gpointer cache_drain_signals (gpointer data G_GNUC_UNUSED) {
+    GThread *self = g_thread_self ();
+    gint64 deadline = 0;
+
+    g_mutex_lock (&cache_lock);
+    /* cache_disable() (or a new thread started by re-enabling the cache)
+       replaces cache_drain_thread when this thread should stop */
+    while (cache_drain_thread == self) {
+        deadline = g_get_monotonic_time () + CACHE_DRAIN_INTERVAL * G_TIME_SPAN_MILLISECOND;
+        if (!g_cond_wait_until (&cache_cond, &cache_lock, deadline) && cache_drain_thread == self)
+            cache_process_signals ();
+    }
+    g_mutex_unlock (&cache_lock);
+
+    return NULL;
+}
+
+/* must be called with cache_lock held */
+static gboolean cache_refill (GError **error) {
+    GVariant *objects = NULL;
+    GVariantIter iter;
+    const gchar *path = NULL;
+    GVariant *ifaces = NULL;
+
+    /* drop all the queued changes, the objects we get now are newer */
+    cache_process_signals ();
+
+    objects = call_get_managed_objects (error);
+    if (!objects)
+        return FALSE;
+
+    g_hash_table_remove_all (cache_objects);
+    g_variant_iter_init (&iter, objects);
+    while (g_variant_iter_next (&iter, "{&o@a{sa{sv}}}", &path, &ifaces)) {
+        cache_add_interfaces (path, ifaces);
+        g_variant_unref (ifaces);
+    }
+    g_variant_unref (objects);
+
+    cache_stale = FALSE;
+    cache_ids_stale = TRUE;
+    cache_stats.refreshes++;
+
+    return TRUE;
+}
+
+/* must be called with cache_lock held */
+static const gchar* cache_get_string_prop (const gchar *path, const gchar *iface, const gchar *property) {
+    GHashTable *obj_ifaces = NULL;
+    GVariant *props = NULL;
+    const gchar *ret = NULL;
+
+    obj_ifaces = g_hash_table_lookup (cache_objects, path);
+    if (obj_ifaces)
+        props = g_hash_table_lookup (obj_ifaces, iface);
+    if (props && !g_variant_lookup (props, property, "&s", &ret) && !g_variant_lookup (props, property, "&o", &ret))
+        ret = NULL;
+
+    return ret;
+}
+
+/* must be called with cache_lock held */
+static void cache_rebuild_ids (void) {
+    GHashTableIter iter;
+    const gchar *path = NULL;
+    GHashTable *obj_ifaces = NULL;
+    const gchar *name = NULL;
+    const gchar *uuid = NULL;
+    const gchar *vg_path = NULL;
+    const gchar *vg_name = NULL;
+    gchar *stripped = NULL;
+
+    g_hash_table_remove_all (cache_ids);
+    g_hash_table_iter_init (&iter, cache_objects);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &path, (gpointer *) &obj_ifaces)) {
+        /* objects can be looked up by their UUIDs too */
+        uuid = NULL;
+        if (g_hash_table_contains (obj_ifaces, PV_INTF)) {
+            name = cache_get_string_prop (path, PV_INTF, "Name");
+            uuid = cache_get_string_prop (path, PV_INTF, "Uuid");
+            if (name)
+                g_hash_table_insert (cache_ids, g_strdup (name), g_strdup (path));
+        } else if (g_hash_table_contains (obj_ifaces, VG_INTF)) {
+            name = cache_get_string_prop (path, VG_INTF, "Name");
+            uuid = cache_get_string_prop (path, VG_INTF, "Uuid");
+            if (name)
+                g_hash_table_insert (cache_ids, g_strdup (name), g_strdup (path));
+        } else if (g_hash_table_contains (obj_ifaces, LV_CMN_INTF)) {
+            name = cache_get_string_prop (path, LV_CMN_INTF, "Name");
+            uuid = cache_get_string_prop (path, LV_CMN_INTF, "Uuid");
+            vg_path = cache_get_string_prop (path, LV_CMN_INTF, "Vg");
+            vg_name = vg_path ? cache_get_string_prop (vg_path, VG_INTF, "Name") : NULL;
+            if (name && vg_name) {
+                g_hash_table_insert (cache_ids, g_strdup_printf ("%s/%s", vg_name, name), g_strdup (path));
+                if (name[0] == '[') {
+                    /* hidden LVs can be looked up without the brackets too */
+                    stripped = g_strstrip (g_strdelimit (g_strdup (name), "[]", ' '));
+                    g_hash_table_insert (cache_ids, g_strdup_printf ("%s/%s", vg_name, stripped), g_strdup (path));
+                    g_free (stripped);
+                }
+            }
+        }
+        if (uuid && *uuid)
+            g_hash_table_insert (cache_ids, g_strdup (uuid), g_strdup (path));
+    }
+
+    cache_ids_stale = FALSE;
+}
+
+/**
+ * cache_use: (skip)
+ *
+ * Locks the cache and brings it up to date. Returns %FALSE if the cache is not
+ * enabled or cannot be used (the lock is released in that case), %TRUE
+ * otherwise (the caller needs to release the lock).
+ */
+static gboolean cache_use (void) {
+    GError *l_error = NULL;
+
+    g_mutex_lock (&cache_lock);
+    if (!cache_enabled) {
+        g_mutex_unlock (&cache_lock);
+        return FALSE;
+    }
+
+    cache_process_signals ();
+    if (cache_stale && !cache_refill (&l_error)) {
+        bd_utils_log_format (BD_UTILS_LOG_DEBUG, "Failed to refill the LVM DBus object cache: %s", l_error->message);
+        g_clear_error (&l_error);
+        g_mutex_unlock (&cache_lock);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * cache_lookup_object_path: (skip)
+ *
+ * Returns: (transfer full): object path of @obj_id or %NULL if not found in the cache
+ */
+static gchar* cache_lookup_object_path (const gchar *obj_id) {
+    gchar *ret = NULL;
+
+    if (!cache_use ())
+        return NULL;
+
+    if (cache_ids_stale)
+        cache_rebuild_ids ();
+    ret = g_strdup (g_hash_table_lookup (cache_ids, obj_id));
+    if (ret)
+        cache_stats.hits++;
+    else
+        cache_stats.misses++;
+
+    g_mutex_unlock (&cache_lock);
+    return ret;
+}
+
+/**
+ * cache_lookup_properties: (skip)
+ *
+ * Returns: (transfer full): the @iface properties of @obj_path or %NULL if not found in the cache
+ */
+static GVariant* cache_lookup_properties (const gchar *obj_path, const gchar *iface) {
+    GHashTable *obj_ifaces = NULL;
+    GVariant *ret = NULL;
+
+    if (g_strcmp0 (iface, JOB_INTF) == 0 || !cache_use ())
+        return NULL;
+
+    obj_ifaces = g_hash_table_lookup (cache_objects, obj_path);
+    if (obj_ifaces)
+        ret = g_hash_table_lookup (obj_ifaces, iface);
+    if (ret) {
+        g_variant_ref (ret);
+        cache_stats.hits++;
+    } else
+        cache_stats.misses++;
+
+    g_mutex_unlock (&cache_lock);
+    return ret;
+}
+
+/**
+ * cache_lookup_property: (skip)
+ *
+ * Returns: (transfer full): the @iface.@property property of @obj_path or %NULL if not found in the cache
+ */
+static GVariant* cache_lookup_property (const gchar *obj_path, const gchar *iface, const gchar *property) {
+    GHashTable *obj_ifaces = NULL;
+    GVariant *props = NULL;
+    GVariant *ret = NULL;
+
+    if (g_strcmp0 (iface, JOB_INTF) == 0 || !cache_use ())
+        return NULL;
+
+    obj_ifaces = g_hash_table_lookup (cache_objects, obj_path);
+    if (obj_ifaces)
+        props = g_hash_table_lookup (obj_ifaces, iface);
+    if (props)
+        ret = g_variant_lookup_value (props, property, NULL);
+    if (ret)
+        cache_stats.hits++;
+    else
+        cache_stats.misses++;
+
+    g_mutex_unlock (&cache_lock);
+    return ret;
+}
+
+/**
+ * cache_mark_stale: (skip)
+ * @obj_path: object path lvmdbusd returned for a lookup the cache missed
+ *
+ * Called when lvmdbusd knows about an object the cache may not know about. The
+ * cache is only marked as stale if @obj_path is really missing in it (the
+ * lookup may have missed just because the object ID is not indexed).
+ */
+static void cache_mark_stale (const gchar *obj_path) {
+    g_mutex_lock (&cache_lock);
+    if (cache_enabled)
+        /* the object may be waiting in the queued signals */
+        cache_process_signals ();
+    if (cache_enabled && !g_hash_table_contains (cache_objects, obj_path)) {
+        cache_stale = TRUE;
+        cache_stats.stale++;
+    }
+    g_mutex_unlock (&cache_lock);
+}
+
+/* must be called with cache_lock held, releases it while waiting for the drain thread */
+static void cache_disable (void) {
+    guint i = 0;
+    GThread *thread = NULL;
+
+    if (!cache_enabled)
+        return;
+
+    /* the thread needs the lock to exit and it has to be gone before the
+       plugin is unloaded */
+    if (cache_drain_thread) {
+        thread = cache_drain_thread;
+        cache_drain_thread = NULL;
+        g_cond_broadcast (&cache_cond);
+        g_mutex_unlock (&cache_lock);
+        g_thread_join (thread);
+        g_mutex_lock (&cache_lock);
+        if (!cache_enabled)
+            /* disabled by another thread in the meantime */
+            return;
+    }
+
+    for (i=0; i < G_N_ELEMENTS (cache_sub_ids); i++)
+        g_dbus_connection_signal_unsubscribe (bus, cache_sub_ids[i]);
+    /* signals already queued in our context keep a reference to the
+       subscriptions, dispatch them before throwing the context away */
+    while (cache_n_subs > 0)
+        g_main_context_iteration (cache_context, TRUE);
+
+    g_main_context_unref (cache_context);
+    cache_context = NULL;
+    g_hash_table_destroy (cache_objects);
+    cache_objects = NULL;
+    g_hash_table_destroy (cache_ids);
+    cache_ids = NULL;
+    cache_enabled = FALSE;
+}
+
 /**
  * bd_lvm_init:
  *
@@ -198,6 +643,10 @@ gboolean bd_lvm_init (void) {
 void bd_lvm_close (void) {
     GError *error = NULL;
 
+    g_mutex_lock (&cache_lock);
+    cache_disable ();
+    g_mutex_unlock (&cache_lock);
+
     if (bus) {
         if (!g_dbus_connection_flush_sync (bus, NULL, &error)) {
             bd_utils_log_format (BD_UTILS_LOG_CRIT, "Failed to flush DBus connection: %s", error->message);
@@ -220,6 +669,21 @@ void bd_lvm_close (void) {
     g_atomic_int_set (&avail_module_deps, 0);
 }
 
+/**
+ * bd_lvm_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_lvm_prewarm_deps (void) {
+    check_dbus_deps (&avail_dbus_deps, ALL_DEPS_MASK (DBUS_DEPS_LAST), dbus_deps, DBUS_DEPS_LAST, &deps_check_lock, NULL);
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+    check_features (&avail_features, ALL_DEPS_MASK (FEATURES_LAST), features, FEATURES_LAST, &deps_check_lock, NULL);
+    check_module_deps (&avail_module_deps, ALL_DEPS_MASK (MODULE_DEPS_LAST), module_deps, MODULE_DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_lvm_is_tech_avail:
  * @tech: the queried tech
@@ -264,41 +728,143 @@ gboolean bd_lvm_is_tech_avail (BDLVMTech tech, guint64 mode, GError **error) {
     }
 }
 
-static gchar** get_existing_objects (const gchar *obj_prefix, GError **error) {
-    GVariant *intro_v = NULL;
-    gchar *intro_data = NULL;
-    GDBusNodeInfo *info = NULL;
-    gchar **ret = NULL;
-    GDBusNodeInfo **nodes;
-    guint64 n_nodes = 0;
-    guint64 i = 0;
+/**
+ * bd_lvm_set_shell_mode:
+ * @enabled: whether to run LVM commands in a persistent `lvm shell` process or not
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Note: lvmdbusd already runs all the commands in its own `lvm shell` process
+ *       so only disabling the shell mode is supported by this plugin.
+ *
+ * Returns: whether the shell mode was successfully enabled/disabled or not
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_set_shell_mode (gboolean enabled, GError **error) {
+    if (enabled) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_NOT_SUPPORTED,
+                             "The shell mode is not supported by the LVM DBus plugin");
+        return FALSE;
+    }
 
-    intro_v = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, obj_prefix, DBUS_INTRO_IFACE,
-                                           "Introspect", NULL, NULL, G_DBUS_CALL_FLAGS_NONE,
-                                           -1, NULL, error);
-    if (!intro_v)
-        /* no introspection data, something went wrong (error must be set) */
-        return NULL;
+    return TRUE;
+}
+
+/**
+ * bd_lvm_get_shell_mode:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether LVM commands are run in a persistent `lvm shell` process or not,
+ *          always %FALSE with this plugin, see %bd_lvm_set_shell_mode for details
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_get_shell_mode (GError **error G_GNUC_UNUSED) {
+    return FALSE;
+}
 
-    g_variant_get (intro_v, "(s)", &intro_data);
-    g_variant_unref (intro_v);
-    info = g_dbus_node_info_new_for_xml (intro_data, error);
-    g_free (intro_data);
+/**
+ * bd_lvm_set_dbus_cache:
+ * @enabled: whether to mirror the lvmdbusd objects in memory or not
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Note: With the cache enabled, all the objects lvmdbusd manages (with their
+ *       properties) are fetched at once and then kept up to date based on the
+ *       signals lvmdbusd emits when they change. Read-only queries (like
+ *       bd_lvm_lvinfo() or bd_lvm_vginfo()) are then answered from memory
+ *       without asking lvmdbusd.
+ *
+ * Returns: whether the cache was successfully enabled/disabled or not
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_set_dbus_cache (gboolean enabled, GError **error) {
+    gboolean ret = TRUE;
 
-    for (nodes = info->nodes; (*nodes); nodes++)
-        n_nodes++;
+    if (enabled && !check_dbus_deps (&avail_dbus_deps, DBUS_DEPS_LVMDBUSD_MASK, dbus_deps, DBUS_DEPS_LAST, &deps_check_lock, error))
+        return FALSE;
 
-    ret = g_new0 (gchar*, n_nodes + 1);
-    for (nodes = info->nodes, i=0; (*nodes); nodes++, i++) {
-        ret[i] = g_strdup_printf ("%s/%s", obj_prefix, ((*nodes)->path));
+    g_mutex_lock (&cache_lock);
+    if (!enabled) {
+        cache_disable ();
+        g_mutex_unlock (&cache_lock);
+        return TRUE;
+    }
+
+    if (cache_enabled) {
+        g_mutex_unlock (&cache_lock);
+        return TRUE;
     }
-    ret[i] = NULL;
 
-    g_dbus_node_info_unref (info);
+    memset (&cache_stats, 0, sizeof (cache_stats));
+    cache_objects = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_destroy);
+    cache_ids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+    /* subscribe to the signals first so that we don't miss any changes made
+       after the objects are fetched */
+    cache_context = g_main_context_new ();
+    g_main_context_push_thread_default (cache_context);
+    cache_sub_ids[0] = g_dbus_connection_signal_subscribe (bus, LVM_BUS_NAME, DBUS_OBJ_MANAGER_IFACE, NULL,
+                                                           LVM_OBJ_PREFIX, NULL, G_DBUS_SIGNAL_FLAGS_NONE,
+                                                           cache_signal, NULL, cache_signal_unsubscribed);
+    cache_sub_ids[1] = g_dbus_connection_signal_subscribe (bus, LVM_BUS_NAME, DBUS_PROPS_IFACE, "PropertiesChanged",
+                                                           NULL, NULL, G_DBUS_SIGNAL_FLAGS_NONE,
+                                                           cache_signal, NULL, cache_signal_unsubscribed);
+    cache_n_subs = G_N_ELEMENTS (cache_sub_ids);
+    g_main_context_pop_thread_default (cache_context);
+    cache_enabled = TRUE;
+
+    ret = cache_refill (error);
+    if (ret)
+        cache_drain_thread = g_thread_new ("lvm-dbus-cache", cache_drain_signals, NULL);
+    else
+        cache_disable ();
+    g_mutex_unlock (&cache_lock);
 
     return ret;
 }
 
+/**
+ * bd_lvm_get_dbus_cache:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the lvmdbusd objects are mirrored in memory or not,
+ *          see %bd_lvm_set_dbus_cache for details
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_get_dbus_cache (GError **error G_GNUC_UNUSED) {
+    gboolean ret = FALSE;
+
+    g_mutex_lock (&cache_lock);
+    ret = cache_enabled;
+    g_mutex_unlock (&cache_lock);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_get_dbus_cache_stats:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer full): statistics of the lvmdbusd objects cache (see
+ *                           %bd_lvm_set_dbus_cache) or %NULL in case of error
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+BDLVMDBusCacheStats* bd_lvm_get_dbus_cache_stats (GError **error G_GNUC_UNUSED) {
+    BDLVMDBusCacheStats *ret = NULL;
+
+    g_mutex_lock (&cache_lock);
+    if (cache_enabled)
+        cache_process_signals ();
+    ret = bd_lvm_dbus_cache_stats_copy (&cache_stats);
+    ret->enabled = cache_enabled;
+    ret->n_objects = cache_objects ? g_hash_table_size (cache_objects) : 0;
+    g_mutex_unlock (&cache_lock);
+
+    return ret;
+}
 
 /**
  * get_object_path:
@@ -318,6 +884,10 @@ static gchar* get_object_path (const gchar *obj_id, GError **error) {
         return NULL;
     }
 
+    obj_path = cache_lookup_object_path (obj_id);
+    if (obj_path)
+        return obj_path;
+
     args = g_variant_new ("(s)", obj_id);
     /* consumes (frees) the 'args' parameter */
     ret = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, MANAGER_OBJ, MANAGER_INTF,
@@ -338,6 +908,9 @@ static gchar* get_object_path (const gchar *obj_id, GError **error) {
         return NULL;
     }
 
+    /* lvmdbusd knows about an object the cache (if enabled) doesn't */
+    cache_mark_stale (obj_path);
+
     return obj_path;
 }
 
@@ -355,6 +928,10 @@ static GVariant* get_object_property (const gchar *obj_path, const gchar *iface,
     GVariant *ret = NULL;
     GVariant *real_ret = NULL;
 
+    real_ret = cache_lookup_property (obj_path, iface, property);
+    if (real_ret)
+        return real_ret;
+
     args = g_variant_new ("(ss)", iface, property);
 
     /* consumes (frees) the 'args' parameter */
@@ -461,7 +1038,7 @@ static GVariant* call_lvm_method (const gchar *obj, const gchar *intf, const gch
     if (!check_dbus_deps (&avail_dbus_deps, DBUS_DEPS_LVMDBUSD_MASK, dbus_deps, DBUS_DEPS_LAST, &deps_check_lock, error))
         return NULL;
 
-    /* don't allow global config string changes during the run */
+    /* don't allow global config string changes while copying it */
     if (lock_config)
         g_mutex_lock (&global_config_lock);
 
@@ -501,6 +1078,10 @@ static GVariant* call_lvm_method (const gchar *obj, const gchar *intf, const gch
             config_extra_params = extra_params;
     }
 
+    /* the global config is now copied into the parameters */
+    if (lock_config)
+        g_mutex_unlock (&global_config_lock);
+
     if (!config_extra_params)
         /* create an empty dictionary with the extra arguments */
         config_extra_params = g_variant_new_array (G_VARIANT_TYPE ("{sv}"), NULL, 0);
@@ -540,8 +1121,6 @@ static GVariant* call_lvm_method (const gchar *obj, const gchar *intf, const gch
     ret = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, obj, intf, method, all_params,
                                        NULL, G_DBUS_CALL_FLAGS_NONE, METHOD_CALL_TIMEOUT, NULL, error);
 
-    if (lock_config)
-         g_mutex_unlock (&global_config_lock);
     prog_msg = g_strdup_printf ("Started the '%s.%s' method on the '%s' object with the following parameters: '%s'",
                                intf, method, obj, params_str);
     g_free (params_str);
@@ -556,8 +1135,186 @@ static GVariant* call_lvm_method (const gchar *obj, const gchar *intf, const gch
     return ret;
 }
 
+typedef struct {
+    const gchar *task_path;
+    guint64 prog_id;
+    guint64 log_task_id;
+    gboolean completed;
+} JobWaitData;
+
+typedef struct {
+    JobWaitData *jobs;
+    guint n_jobs;
+    gboolean any_completed;
+    gboolean timed_out;
+    gboolean unsubscribed;
+} JobsWaitData;
+
+static void job_properties_changed (GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender_name G_GNUC_UNUSED,
+                                    const gchar *object_path, const gchar *interface_name G_GNUC_UNUSED,
+                                    const gchar *signal_name G_GNUC_UNUSED, GVariant *parameters, gpointer user_data) {
+    JobsWaitData *data = (JobsWaitData *) user_data;
+    JobWaitData *job = NULL;
+    const gchar *iface = NULL;
+    GVariant *changed = NULL;
+    gboolean completed = FALSE;
+    gdouble progress = 0.0;
+    guint i = 0;
+
+    for (i=0; !job && i < data->n_jobs; i++)
+        if (g_strcmp0 (data->jobs[i].task_path, object_path) == 0)
+            job = &(data->jobs[i]);
+
+    if (!job || !g_variant_check_format_string (parameters, "(&s@a{sv}@as)", FALSE))
+        return;
+
+    g_variant_get (parameters, "(&s@a{sv}@as)", &iface, &changed, NULL);
+    if (g_strcmp0 (iface, JOB_INTF) == 0) {
+        if (g_variant_lookup (changed, "Complete", "b", &completed) && completed) {
+            job->completed = TRUE;
+            data->any_completed = TRUE;
+        }
+        if (g_variant_lookup (changed, "Percent", "d", &progress))
+            bd_utils_report_progress (job->prog_id, (gint) progress, NULL);
+    }
+    g_variant_unref (changed);
+}
+
+static void job_wait_unsubscribed (gpointer user_data) {
+    JobsWaitData *data = (JobsWaitData *) user_data;
+
+    data->unsubscribed = TRUE;
+}
+
+static gboolean job_wait_timeout (gpointer user_data) {
+    JobsWaitData *data = (JobsWaitData *) user_data;
+
+    data->timed_out = TRUE;
+    return G_SOURCE_REMOVE;
+}
+
 /**
- * call_lvm_method_sync
+ * wait_for_jobs:
+ * @jobs: (array length=n_jobs): lvmdbusd jobs to wait for
+ * @n_jobs: number of @jobs
+ * @timeout: how long to wait (in milliseconds, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Waits for any of the @jobs to complete. The jobs' PropertiesChanged signals
+ * are used to get notified about their progress and completion, the 'Complete'
+ * property is only queried directly when the waiting starts and then every
+ * %JOB_WAIT_FALLBACK milliseconds in case a signal was missed.
+ *
+ * Returns: whether any of the @jobs completed or not (if %FALSE, either the
+ *          @timeout elapsed or @error is set), the completed jobs have their
+ *          @completed set to %TRUE
+ */
+static gboolean wait_for_jobs (JobWaitData *jobs, guint n_jobs, gint timeout, GError **error) {
+    GMainContext *context = NULL;
+    GSource *timeout_source = NULL;
+    JobsWaitData data = { jobs, n_jobs, FALSE, FALSE, FALSE };
+    GVariant *ret = NULL;
+    guint sub_id = 0;
+    gint64 deadline = -1;
+    gint64 wait_time = 0;
+    gchar *log_msg = NULL;
+    GError *l_error = NULL;
+    guint i = 0;
+
+    if (timeout >= 0)
+        deadline = g_get_monotonic_time () + (gint64) timeout * G_TIME_SPAN_MILLISECOND;
+
+    /* signals are delivered to the thread-default main context of the
+       subscribing thread, use a private one so that we don't dispatch
+       anything else the caller may have attached to their context */
+    context = g_main_context_new ();
+    g_main_context_push_thread_default (context);
+
+    /* one subscription for all the jobs, the handler finds the right one */
+    sub_id = g_dbus_connection_signal_subscribe (bus, LVM_BUS_NAME, DBUS_PROPS_IFACE, "PropertiesChanged",
+                                                 n_jobs == 1 ? jobs[0].task_path : NULL, JOB_INTF,
+                                                 G_DBUS_SIGNAL_FLAGS_NONE,
+                                                 job_properties_changed, &data, job_wait_unsubscribed);
+
+    while (!data.any_completed && !l_error) {
+        /* the jobs may have finished before we subscribed to their signals or
+           we may have missed the signal, check the property directly */
+        for (i=0; i < n_jobs && !l_error; i++) {
+            ret = get_object_property (jobs[i].task_path, JOB_INTF, "Complete", &l_error);
+            if (ret) {
+                g_variant_get (ret, "b", &(jobs[i].completed));
+                g_variant_unref (ret);
+                if (jobs[i].completed)
+                    data.any_completed = TRUE;
+            }
+        }
+        if (data.any_completed || l_error)
+            break;
+
+        wait_time = JOB_WAIT_FALLBACK;
+        if (deadline >= 0) {
+            wait_time = MIN (wait_time, (deadline - g_get_monotonic_time ()) / G_TIME_SPAN_MILLISECOND);
+            if (wait_time <= 0)
+                break;
+        }
+
+        data.timed_out = FALSE;
+        timeout_source = g_timeout_source_new ((guint) wait_time);
+        g_source_set_callback (timeout_source, job_wait_timeout, &data, NULL);
+        g_source_attach (timeout_source, context);
+
+        while (!data.any_completed && !data.timed_out)
+            g_main_context_iteration (context, TRUE);
+
+        g_source_destroy (timeout_source);
+        g_source_unref (timeout_source);
+
+        if (!data.any_completed && (deadline < 0 || g_get_monotonic_time () < deadline)) {
+            /* once per JOB_WAIT_FALLBACK */
+            for (i=0; i < n_jobs; i++) {
+                log_msg = g_strdup_printf ("Still waiting for job '%s' to finish", jobs[i].task_path);
+                bd_utils_log_task_status (jobs[i].log_task_id, log_msg);
+                g_free (log_msg);
+            }
+        }
+    }
+
+    g_dbus_connection_signal_unsubscribe (bus, sub_id);
+    /* signals already queued in our context keep a reference to the
+       subscription, dispatch them before throwing the context away */
+    while (!data.unsubscribed)
+        g_main_context_iteration (context, TRUE);
+
+    g_main_context_pop_thread_default (context);
+    g_main_context_unref (context);
+
+    if (l_error) {
+        g_propagate_error (error, l_error);
+        return FALSE;
+    }
+
+    return data.any_completed;
+}
+
+/**
+ * wait_for_job:
+ * @task_path: lvmdbusd job object path
+ * @prog_id: progress reporting ID for the job
+ * @log_task_id: task ID for the log messages
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Waits for the @task_path job to complete, see wait_for_jobs().
+ *
+ * Returns: whether the job completed or not (if %FALSE, @error is set)
+ */
+static gboolean wait_for_job (const gchar *task_path, guint64 prog_id, guint64 log_task_id, GError **error) {
+    JobWaitData job = { task_path, prog_id, log_task_id, FALSE };
+
+    return wait_for_jobs (&job, 1, -1, error);
+}
+
+/**
+ * start_lvm_method
  * @obj: lvmdbusd object path
  * @intf: interface to call @method on
  * @method: method to call
@@ -566,179 +1323,214 @@ static GVariant* call_lvm_method (const gchar *obj, const gchar *intf, const gch
  * @extra_args: extra command line argument to be passed to the LVM command
  * @lock_config: whether to lock %global_config_lock or not (if %FALSE is given, caller is responsible
  *               for holding the lock for this call)
+ * @task_path: (out): place to store the object path of the job started by @method
+ *                    or %NULL if @method finished without starting a job
+ * @log_task_id: (out): place to store the task ID for the log messages
+ * @prog_id: (out): place to store the progress reporting ID
  * @error: (out) (optional): place to store error (if any)
  *
+ * Calls the @method and if it doesn't finish right away (within the timeout
+ * given to lvmdbusd) returns the job lvmdbusd started for it.
+ *
  * Returns: whether calling the method was successful or not
  */
-static gboolean call_lvm_method_sync (const gchar *obj, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, GError **error) {
+static gboolean start_lvm_method (const gchar *obj, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config,
+                                  gchar **task_path, guint64 *log_task_id, guint64 *prog_id, GError **error) {
     GVariant *ret = NULL;
     gchar *obj_path = NULL;
-    g_autofree gchar *task_path = NULL;
-    guint64 log_task_id = 0;
-    guint64 prog_id = 0;
-    gdouble progress = 0.0;
     gchar *log_msg = NULL;
-    gboolean completed = FALSE;
-    gint64 error_code = 0;
-    gchar *error_msg = NULL;
     GError *l_error = NULL;
 
-    ret = call_lvm_method (obj, intf, method, params, extra_params, extra_args, &log_task_id, &prog_id, lock_config, &l_error);
-    bd_utils_log_task_status (log_task_id, "Done.");
+    *task_path = NULL;
+    ret = call_lvm_method (obj, intf, method, params, extra_params, extra_args, log_task_id, prog_id, lock_config, &l_error);
+    bd_utils_log_task_status (*log_task_id, "Done.");
     if (!ret) {
         if (l_error) {
             log_msg = g_strdup_printf ("Got error: %s", l_error->message);
-            bd_utils_log_task_status (log_task_id, log_msg);
-            bd_utils_report_finished (prog_id, log_msg);
+            bd_utils_log_task_status (*log_task_id, log_msg);
+            bd_utils_report_finished (*prog_id, log_msg);
             g_free (log_msg);
             g_propagate_error (error, l_error);
         } else {
-            bd_utils_log_task_status (log_task_id, "Got unknown error");
-            bd_utils_report_finished (prog_id, "Got unknown error");
+            bd_utils_log_task_status (*log_task_id, "Got unknown error");
+            bd_utils_report_finished (*prog_id, "Got unknown error");
         }
         return FALSE;
     }
     if (g_variant_check_format_string (ret, "((oo))", TRUE)) {
-        g_variant_get (ret, "((oo))", &obj_path, &task_path);
+        g_variant_get (ret, "((oo))", &obj_path, task_path);
         if (g_strcmp0 (obj_path, "/") != 0) {
             log_msg = g_strdup_printf ("Got result: %s", obj_path);
-            bd_utils_log_task_status (log_task_id, log_msg);
+            bd_utils_log_task_status (*log_task_id, log_msg);
             g_free (log_msg);
             /* got a valid result, just return */
             g_variant_unref (ret);
             g_free (obj_path);
-            bd_utils_report_finished (prog_id, "Completed");
+            g_free (*task_path);
+            *task_path = NULL;
+            bd_utils_report_finished (*prog_id, "Completed");
             return TRUE;
         } else {
             g_variant_unref (ret);
             g_free (obj_path);
-            if (g_strcmp0 (task_path, "/") == 0) {
+            if (g_strcmp0 (*task_path, "/") == 0) {
+                g_free (*task_path);
+                *task_path = NULL;
                 log_msg = g_strdup_printf ("Task finished without result and without job started");
                 g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
                              "Running '%s' method on the '%s' object failed: %s",
                              method, obj, log_msg);
-                bd_utils_log_task_status (log_task_id, log_msg);
-                bd_utils_report_finished (prog_id, log_msg);
+                bd_utils_log_task_status (*log_task_id, log_msg);
+                bd_utils_report_finished (*prog_id, log_msg);
                 g_free (log_msg);
                 return FALSE;
             }
         }
     } else if (g_variant_check_format_string (ret, "(o)", TRUE)) {
-        g_variant_get (ret, "(o)", &task_path);
-        if (g_strcmp0 (task_path, "/") != 0) {
-            g_variant_unref (ret);
-        } else {
-            bd_utils_log_task_status (log_task_id, "No result, no job started");
-            bd_utils_report_finished (prog_id, "Completed");
-            g_variant_unref (ret);
+        g_variant_get (ret, "(o)", task_path);
+        g_variant_unref (ret);
+        if (g_strcmp0 (*task_path, "/") == 0) {
+            g_free (*task_path);
+            *task_path = NULL;
+            bd_utils_log_task_status (*log_task_id, "No result, no job started");
+            bd_utils_report_finished (*prog_id, "Completed");
             return TRUE;
         }
     } else {
         g_variant_unref (ret);
-        bd_utils_log_task_status (log_task_id, "Failed to parse the returned value!");
+        bd_utils_log_task_status (*log_task_id, "Failed to parse the returned value!");
         g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
                              "Failed to parse the returned value!");
-        bd_utils_report_finished (prog_id, "Failed to parse the returned value!");
+        bd_utils_report_finished (*prog_id, "Failed to parse the returned value!");
         return FALSE;
     }
 
-    log_msg = g_strdup_printf ("Waiting for job '%s' to finish", task_path);
-    bd_utils_log_task_status (log_task_id, log_msg);
+    log_msg = g_strdup_printf ("Waiting for job '%s' to finish", *task_path);
+    bd_utils_log_task_status (*log_task_id, log_msg);
     g_free (log_msg);
 
-    ret = NULL;
-    while (!completed && !l_error) {
-        g_usleep (PROGRESS_WAIT);
-        ret = get_object_property (task_path, JOB_INTF, "Complete", &l_error);
-        if (ret) {
-            g_variant_get (ret, "b", &completed);
-            g_variant_unref (ret);
-            ret = NULL;
-        }
-        if (!completed && !l_error) {
-            /* let's report progress and wait longer */
-            ret = get_object_property (task_path, JOB_INTF, "Percent", &l_error);
-            if (ret) {
-                g_variant_get (ret, "d", &progress);
-                bd_utils_report_progress (prog_id, (gint) progress, NULL);
-                g_variant_unref (ret);
-                ret = NULL;
-            } else {
-                bd_utils_log_format (BD_UTILS_LOG_DEBUG, "Got error when getting progress: %s", l_error->message);
-                g_clear_error (&l_error);
-            }
-            log_msg = g_strdup_printf ("Still waiting for job '%s' to finish", task_path);
-            bd_utils_log_task_status (log_task_id, log_msg);
-            g_free (log_msg);
-        }
+    return TRUE;
+}
+
+/**
+ * finish_lvm_job
+ * @obj: lvmdbusd object path the job was started on
+ * @method: method that started the job
+ * @task_path: object path of the completed job
+ * @log_task_id: task ID for the log messages
+ * @prog_id: progress reporting ID
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets the result of the completed @task_path job and removes the job.
+ *
+ * Returns: whether the job finished successfully or not
+ */
+static gboolean finish_lvm_job (const gchar *obj, const gchar *method, const gchar *task_path, guint64 log_task_id, guint64 prog_id, GError **error) {
+    GVariant *ret = NULL;
+    gchar *obj_path = NULL;
+    gchar *log_msg = NULL;
+    gint64 error_code = 0;
+    gchar *error_msg = NULL;
+    GError *l_error = NULL;
 
-    }
     log_msg = g_strdup_printf ("Job '%s' finished", task_path);
     bd_utils_log_task_status (log_task_id, log_msg);
     g_free (log_msg);
 
-    obj_path = NULL;
-    if (!l_error) {
-        ret = get_object_property (task_path, JOB_INTF, "Result", &l_error);
-        if (!ret) {
-            g_prefix_error (&l_error, "Getting result after waiting for '%s' method of the '%s' object failed: ",
-                            method, obj);
-            bd_utils_report_finished (prog_id, l_error->message);
-            g_propagate_error (error, l_error);
-            return FALSE;
+    ret = get_object_property (task_path, JOB_INTF, "Result", &l_error);
+    if (!ret) {
+        g_prefix_error (&l_error, "Getting result after waiting for '%s' method of the '%s' object failed: ",
+                        method, obj);
+        bd_utils_report_finished (prog_id, l_error->message);
+        g_propagate_error (error, l_error);
+        return FALSE;
+    } else {
+        g_variant_get (ret, "o", &obj_path);
+        g_variant_unref (ret);
+        if (g_strcmp0 (obj_path, "/") != 0) {
+            log_msg = g_strdup_printf ("Got result: %s", obj_path);
+            bd_utils_log_task_status (log_task_id, log_msg);
+            g_free (log_msg);
         } else {
-            g_variant_get (ret, "o", &obj_path);
+            ret = get_object_property (task_path, JOB_INTF, "GetError", &l_error);
+            if (!ret) {
+                if (!l_error)
+                    g_set_error (&l_error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                                 "Failed to get error from '%s' method of the '%s' object",
+                                 method, obj);
+                bd_utils_report_finished (prog_id, l_error->message);
+                g_propagate_error (error, l_error);
+                g_free (obj_path);
+                return FALSE;
+            }
+            g_variant_get (ret, "(is)", &error_code, &error_msg);
             g_variant_unref (ret);
-            if (g_strcmp0 (obj_path, "/") != 0) {
-                log_msg = g_strdup_printf ("Got result: %s", obj_path);
-                bd_utils_log_task_status (log_task_id, log_msg);
-                g_free (log_msg);
-            } else {
-                ret = get_object_property (task_path, JOB_INTF, "GetError", &l_error);
-                if (!ret) {
-                    if (!l_error)
-                        g_set_error (&l_error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
-                                     "Failed to get error from '%s' method of the '%s' object",
-                                     method, obj);
-                    bd_utils_report_finished (prog_id, l_error->message);
-                    g_propagate_error (error, l_error);
-                    return FALSE;
+            if (error_code != 0) {
+                if (error_msg) {
+                    log_msg = g_strdup_printf ("Got error: %s", error_msg);
+                    bd_utils_log_task_status (log_task_id, log_msg);
+                    bd_utils_report_finished (prog_id, log_msg);
+                    g_set_error (&l_error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                                 "Running '%s' method on the '%s' object failed: %s",
+                                 method, obj, error_msg);
+                    g_free (log_msg);
+                    g_free (error_msg);
+                } else {
+                    bd_utils_log_task_status (log_task_id, "Got unknown error");
+                    bd_utils_report_finished (prog_id, "Got unknown error");
+                    g_set_error (&l_error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                                 "Got unknown error when running '%s' method on the '%s' object.",
+                                 method, obj);
                 }
-                g_variant_get (ret, "(is)", &error_code, &error_msg);
-                if (error_code != 0) {
-                    if (error_msg) {
-                        log_msg = g_strdup_printf ("Got error: %s", error_msg);
-                        bd_utils_log_task_status (log_task_id, log_msg);
-                        bd_utils_report_finished (prog_id, log_msg);
-                        g_set_error (&l_error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
-                                     "Running '%s' method on the '%s' object failed: %s",
-                                     method, obj, error_msg);
-                        g_free (log_msg);
-                        g_free (error_msg);
-                    } else {
-                        bd_utils_log_task_status (log_task_id, "Got unknown error");
-                        bd_utils_report_finished (prog_id, "Got unknown error");
-                        g_set_error (&l_error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
-                                     "Got unknown error when running '%s' method on the '%s' object.",
-                                     method, obj);
-                    }
-                    g_propagate_error (error, l_error);
-                    return FALSE;
-                } else
-                    bd_utils_log_task_status (log_task_id, "No result");
-            }
-            bd_utils_report_finished (prog_id, "Completed");
-            g_free (obj_path);
+                g_propagate_error (error, l_error);
+                g_free (obj_path);
+                return FALSE;
+            } else
+                bd_utils_log_task_status (log_task_id, "No result");
+            g_free (error_msg);
+        }
+        bd_utils_report_finished (prog_id, "Completed");
+        g_free (obj_path);
 
-            /* remove the job object and clean after ourselves */
-            ret = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, task_path, JOB_INTF, "Remove", NULL,
-                                               NULL, G_DBUS_CALL_FLAGS_NONE, METHOD_CALL_TIMEOUT, NULL, NULL);
-            if (ret)
-                g_variant_unref (ret);
+        /* remove the job object and clean after ourselves */
+        ret = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, task_path, JOB_INTF, "Remove", NULL,
+                                           NULL, G_DBUS_CALL_FLAGS_NONE, METHOD_CALL_TIMEOUT, NULL, NULL);
+        if (ret)
+            g_variant_unref (ret);
 
-            return TRUE;
-        }
-    } else {
+        return TRUE;
+    }
+}
+
+/**
+ * call_lvm_method_sync
+ * @obj: lvmdbusd object path
+ * @intf: interface to call @method on
+ * @method: method to call
+ * @params: parameters for @method
+ * @extra_params: extra parameters for @method
+ * @extra_args: extra command line argument to be passed to the LVM command
+ * @lock_config: whether to lock %global_config_lock or not (if %FALSE is given, caller is responsible
+ *               for holding the lock for this call)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether calling the method was successful or not
+ */
+static gboolean call_lvm_method_sync (const gchar *obj, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, GError **error) {
+    g_autofree gchar *task_path = NULL;
+    guint64 log_task_id = 0;
+    guint64 prog_id = 0;
+    GError *l_error = NULL;
+
+    if (!start_lvm_method (obj, intf, method, params, extra_params, extra_args, lock_config,
+                           &task_path, &log_task_id, &prog_id, error))
+        return FALSE;
+
+    if (!task_path)
+        /* finished without a job */
+        return TRUE;
+
+    if (!wait_for_job (task_path, prog_id, log_task_id, &l_error)) {
         /* some real error */
         g_prefix_error (&l_error, "Waiting for '%s' method of the '%s' object to finish failed: ",
                         method, obj);
@@ -746,6 +1538,8 @@ static gboolean call_lvm_method_sync (const gchar *obj, const gchar *intf, const
         bd_utils_report_finished (prog_id, "Completed");
         return FALSE;
     }
+
+    return finish_lvm_job (obj, method, task_path, log_task_id, prog_id, error);
 }
 
 static gboolean call_lvm_obj_method_sync (const gchar *obj_id, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, GError **error) {
@@ -771,7 +1565,125 @@ static gboolean call_thpool_method_sync (const gchar *vg_name, const gchar *pool
 static gboolean call_vdopool_method_sync (const gchar *vg_name, const gchar *pool_name, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, GError **error) {
     g_autofree gchar *obj_id = g_strdup_printf ("%s/%s", vg_name, pool_name);
 
-    return call_lvm_obj_method_sync (obj_id, VDO_POOL_INTF, method, params, extra_params, extra_args, lock_config, error);
+    return call_lvm_obj_method_sync (obj_id, VDO_POOL_INTF, method, params, extra_params, extra_args, lock_config, error);
+}
+
+/* lvmdbusd method started in the background, see start_lvm_job() */
+typedef struct {
+    /* jobs can be shared between threads, protects the state below */
+    GMutex lock;
+    gchar *obj;
+    gchar *method;
+    gchar *task_path;           /* NULL if the method finished without a job */
+    guint64 log_task_id;
+    guint64 prog_id;
+    gdouble progress;
+    gboolean finished;
+    GError *error;
+} LVMDBusJob;
+
+static void lvm_dbus_job_free (LVMDBusJob *job) {
+    GVariant *prop = NULL;
+    gboolean complete = FALSE;
+
+    if (!job->finished) {
+        /* a completed job nobody waited for still needs to be removed */
+        prop = get_object_property (job->task_path, JOB_INTF, "Complete", NULL);
+        if (prop) {
+            g_variant_get (prop, "b", &complete);
+            g_variant_unref (prop);
+        }
+        if (complete)
+            /* nobody is interested in the result anymore */
+            finish_lvm_job (job->obj, job->method, job->task_path, job->log_task_id, job->prog_id, NULL);
+        else
+            bd_utils_log_format (BD_UTILS_LOG_INFO, "Leaving the job '%s' running in lvmdbusd", job->task_path);
+    }
+
+    g_free (job->obj);
+    g_free (job->method);
+    g_free (job->task_path);
+    g_clear_error (&(job->error));
+    g_mutex_clear (&(job->lock));
+    g_free (job);
+}
+
+static void lvm_dbus_job_completed (LVMDBusJob *job) {
+    g_mutex_lock (&(job->lock));
+    /* multiple threads may have been waiting for the job, only the first one
+       gets the result and removes the lvmdbusd job */
+    if (!job->finished) {
+        job->finished = TRUE;
+        if (finish_lvm_job (job->obj, job->method, job->task_path, job->log_task_id, job->prog_id, &(job->error)))
+            job->progress = 100.0;
+    }
+    g_mutex_unlock (&(job->lock));
+}
+
+static gboolean lvm_dbus_job_is_finished (LVMDBusJob *job) {
+    gboolean finished = FALSE;
+
+    g_mutex_lock (&(job->lock));
+    finished = job->finished;
+    g_mutex_unlock (&(job->lock));
+
+    return finished;
+}
+
+static BDLVMJob* start_lvm_job (const gchar *obj, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, GError **error) {
+    LVMDBusJob *job = NULL;
+    BDLVMJob *ret = NULL;
+    gchar *task_path = NULL;
+    guint64 log_task_id = 0;
+    guint64 prog_id = 0;
+
+    if (!start_lvm_method (obj, intf, method, params, extra_params, extra_args, lock_config,
+                           &task_path, &log_task_id, &prog_id, error))
+        return NULL;
+
+    job = g_new0 (LVMDBusJob, 1);
+    g_mutex_init (&(job->lock));
+    job->obj = g_strdup (obj);
+    job->method = g_strdup (method);
+    job->task_path = task_path;
+    job->log_task_id = log_task_id;
+    job->prog_id = prog_id;
+    if (!task_path) {
+        /* finished right away */
+        job->finished = TRUE;
+        job->progress = 100.0;
+    }
+
+    ret = g_new0 (BDLVMJob, 1);
+    ret->ref_count = 1;
+    ret->priv = job;
+    ret->priv_free = (GDestroyNotify) lvm_dbus_job_free;
+
+    return ret;
+}
+
+/**
+ * run_lvm_method:
+ * @job: (out) (optional): place to store the handle of the started job or %NULL
+ *                         to wait for the @method to finish
+ *
+ * Same as call_lvm_method_sync() if @job is %NULL, otherwise only starts the
+ * @method and stores a handle for it in @job.
+ */
+static gboolean run_lvm_method (const gchar *obj, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, BDLVMJob **job, GError **error) {
+    if (!job)
+        return call_lvm_method_sync (obj, intf, method, params, extra_params, extra_args, lock_config, error);
+
+    *job = start_lvm_job (obj, intf, method, params, extra_params, extra_args, lock_config, error);
+    return *job != NULL;
+}
+
+static gboolean run_lvm_obj_method (const gchar *obj_id, const gchar *intf, const gchar *method, GVariant *params, GVariant *extra_params, const BDExtraArg **extra_args, gboolean lock_config, BDLVMJob **job, GError **error) {
+    g_autofree gchar *obj_path = get_object_path (obj_id, error);
+    if (!obj_path)
+        return FALSE;
+
+    return run_lvm_method (obj_path, intf, method, params, extra_params, extra_args, lock_config, job, error);
 }
 
 static GVariant* get_lv_property (const gchar *vg_name, const gchar *lv_name, const gchar *property, GError **error) {
@@ -791,6 +1703,10 @@ static GVariant* get_object_properties (const gchar *obj_path, const gchar *ifac
     GVariant *ret = NULL;
     GVariant *real_ret = NULL;
 
+    real_ret = cache_lookup_properties (obj_path, iface);
+    if (real_ret)
+        return real_ret;
+
     args = g_variant_new ("(s)", iface);
 
     /* consumes (frees) the 'args' parameter */
@@ -809,38 +1725,410 @@ static GVariant* get_object_properties (const gchar *obj_path, const gchar *ifac
 }
 
 static GVariant* get_lvm_object_properties (const gchar *obj_id, const gchar *iface, GError **error) {
-    GVariant *args = NULL;
     GVariant *ret = NULL;
     gchar *obj_path = NULL;
 
-    if (!obj_id || g_strcmp0 (obj_id, "") == 0) {
-        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
-                             "Invalid LVM ID specified");
+    obj_path = get_object_path (obj_id, error);
+    if (!obj_path)
+        /* error is already set */
         return NULL;
-    }
 
-    args = g_variant_new ("(s)", obj_id);
-    /* consumes (frees) the 'args' parameter */
-    ret = g_dbus_connection_call_sync (bus, LVM_BUS_NAME, MANAGER_OBJ, MANAGER_INTF,
-                                       "LookUpByLvmId", args, NULL, G_DBUS_CALL_FLAGS_NONE,
-                                       -1, NULL, error);
-    if (!ret)
+    ret = get_object_properties (obj_path, iface, error);
+    g_free (obj_path);
+    return ret;
+}
+
+
+/* objects managed by lvmdbusd, either all of them as returned by a single
+   GetManagedObjects call or only some of them fetched by get_lv_objects()
+   (objects is NULL then) */
+typedef struct {
+    GVariant *objects;          /* a{oa{sa{sv}}} */
+    GHashTable *table;          /* object path -> a{sa{sv}} */
+} LVMObjects;
+
+static void lvm_objects_free (LVMObjects *objects) {
+    if (!objects)
+        return;
+
+    g_hash_table_destroy (objects->table);
+    if (objects->objects)
+        g_variant_unref (objects->objects);
+    g_free (objects);
+}
+
+/**
+ * get_managed_objects:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets all the objects lvmdbusd manages together with all their interfaces
+ * and properties in one call using the ObjectManager interface.
+ *
+ * Returns: (transfer full): all the objects managed by lvmdbusd
+ */
+static LVMObjects* get_managed_objects (GError **error) {
+    GVariant *all_objects = NULL;
+    GVariantIter iter;
+    const gchar *path = NULL;
+    GVariant *ifaces = NULL;
+    LVMObjects *objects = NULL;
+
+    all_objects = call_get_managed_objects (error);
+    if (!all_objects)
         return NULL;
-    g_variant_get (ret, "(o)", &obj_path);
-    g_variant_unref (ret);
 
-    if (g_strcmp0 (obj_path, "/") == 0) {
+    objects = g_new0 (LVMObjects, 1);
+    objects->objects = all_objects;
+
+    objects->table = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
+    g_variant_iter_init (&iter, objects->objects);
+    while (g_variant_iter_next (&iter, "{&o@a{sa{sv}}}", &path, &ifaces))
+        g_hash_table_insert (objects->table, g_strdup (path), ifaces);
+
+    return objects;
+}
+
+/**
+ * get_managed_object_paths:
+ * @objects: objects managed by lvmdbusd
+ * @obj_prefix: object path prefix of the objects to get
+ *
+ * Returns: (transfer full): paths of the objects in @objects under @obj_prefix
+ *                           in the order lvmdbusd reported them
+ *
+ * Note: @objects needs to be the result of get_managed_objects().
+ */
+static gchar** get_managed_object_paths (LVMObjects *objects, const gchar *obj_prefix) {
+    GPtrArray *paths = NULL;
+    GVariantIter iter;
+    const gchar *path = NULL;
+    g_autofree gchar *prefix = g_strdup_printf ("%s/", obj_prefix);
+
+    paths = g_ptr_array_new ();
+    g_variant_iter_init (&iter, objects->objects);
+    while (g_variant_iter_next (&iter, "{&o@a{sa{sv}}}", &path, NULL))
+        if (g_str_has_prefix (path, prefix))
+            g_ptr_array_add (paths, g_strdup (path));
+    g_ptr_array_add (paths, NULL);
+
+    return (gchar **) g_ptr_array_free (paths, FALSE);
+}
+
+/**
+ * lookup_object_properties:
+ * @objects: (nullable): objects managed by lvmdbusd
+ * @obj_path: lvmdbusd object path
+ * @iface: interface to get the properties of
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as get_object_properties(), but uses the already fetched @objects (if
+ * given) instead of asking lvmdbusd.
+ *
+ * Returns: (transfer full): properties of @obj_path and @iface
+ */
+static GVariant* lookup_object_properties (LVMObjects *objects, const gchar *obj_path, const gchar *iface, GError **error) {
+    GVariant *ifaces = NULL;
+    GVariant *ret = NULL;
+
+    if (!objects)
+        return get_object_properties (obj_path, iface, error);
+
+    ifaces = g_hash_table_lookup (objects->table, obj_path);
+    if (ifaces)
+        ret = g_variant_lookup_value (ifaces, iface, G_VARIANT_TYPE ("a{sv}"));
+    if (!ret)
         g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
-                     "The object with LVM ID '%s' doesn't exist", obj_id);
-        g_free (obj_path);
-        return NULL;
+                     "Failed to get properties of the %s object: no such object or interface", obj_path);
+
+    return ret;
+}
+
+/**
+ * lookup_object_property:
+ * @objects: (nullable): objects managed by lvmdbusd
+ * @obj_path: lvmdbusd object path
+ * @iface: interface on @obj_path object
+ * @property: property to get from @obj_path and @iface
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as get_object_property(), but uses the already fetched @objects (if
+ * given) instead of asking lvmdbusd.
+ *
+ * Returns: (transfer full): property variant
+ */
+static GVariant* lookup_object_property (LVMObjects *objects, const gchar *obj_path, const gchar *iface, const gchar *property, GError **error) {
+    GVariant *props = NULL;
+    GVariant *ret = NULL;
+
+    if (!objects)
+        return get_object_property (obj_path, iface, property, error);
+
+    props = lookup_object_properties (objects, obj_path, iface, NULL);
+    if (props) {
+        ret = g_variant_lookup_value (props, property, NULL);
+        g_variant_unref (props);
+    }
+    if (!ret)
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
+                     "Failed to get %s property of the %s object", property, obj_path);
+
+    return ret;
+}
+
+typedef struct {
+    gchar *obj_path;
+    const gchar *iface;
+    GVariant *props;            /* a{sv} */
+    GError *error;
+    guint *n_pending;
+} PropsRequest;
+
+static void props_request_free (PropsRequest *request) {
+    g_free (request->obj_path);
+    if (request->props)
+        g_variant_unref (request->props);
+    g_clear_error (&(request->error));
+    g_free (request);
+}
+
+static void props_request_done (GObject *source_object G_GNUC_UNUSED, GAsyncResult *res, gpointer user_data) {
+    PropsRequest *request = (PropsRequest *) user_data;
+    GVariant *ret = NULL;
+
+    ret = g_dbus_connection_call_finish (bus, res, &(request->error));
+    if (ret) {
+        request->props = g_variant_get_child_value (ret, 0);
+        g_variant_unref (ret);
+    }
+    (*(request->n_pending))--;
+}
+
+static void add_props_request (GPtrArray *requests, LVMObjects *objects, const gchar *obj_path, const gchar *iface) {
+    PropsRequest *request = NULL;
+    guint i = 0;
+
+    if (!obj_path || g_strcmp0 (obj_path, "/") == 0 || g_hash_table_contains (objects->table, obj_path))
+        return;
+
+    /* the same object can be referenced multiple times (e.g. a PV with
+       multiple segments of the LV) */
+    for (i=0; i < requests->len; i++) {
+        request = g_ptr_array_index (requests, i);
+        if (g_strcmp0 (request->obj_path, obj_path) == 0 && g_strcmp0 (request->iface, iface) == 0)
+            return;
+    }
+
+    request = g_new0 (PropsRequest, 1);
+    request->obj_path = g_strdup (obj_path);
+    request->iface = iface;
+    g_ptr_array_add (requests, request);
+}
+
+static void add_prop_props_request (GPtrArray *requests, LVMObjects *objects, GVariant *props,
+                                    const gchar *property, const gchar *iface) {
+    const gchar *obj_path = NULL;
+
+    if (props && g_variant_lookup (props, property, "&o", &obj_path))
+        add_props_request (requests, objects, obj_path, iface);
+}
+
+static void lvm_objects_add_props (LVMObjects *objects, const gchar *obj_path, const gchar *iface, GVariant *props) {
+    GVariantBuilder builder;
+    GVariantIter iter;
+    GVariant *ifaces = NULL;
+    const gchar *old_iface = NULL;
+    GVariant *old_props = NULL;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+    ifaces = g_hash_table_lookup (objects->table, obj_path);
+    if (ifaces) {
+        g_variant_iter_init (&iter, ifaces);
+        while (g_variant_iter_next (&iter, "{&s@a{sv}}", &old_iface, &old_props)) {
+            if (g_strcmp0 (old_iface, iface) != 0)
+                g_variant_builder_add (&builder, "{s@a{sv}}", old_iface, old_props);
+            g_variant_unref (old_props);
+        }
+    }
+    g_variant_builder_add (&builder, "{s@a{sv}}", iface, props);
+
+    g_hash_table_insert (objects->table, g_strdup (obj_path), g_variant_ref_sink (g_variant_builder_end (&builder)));
+}
+
+/**
+ * fetch_objects_properties:
+ * @objects: objects to add the fetched properties to
+ * @requests: (element-type PropsRequest): objects and interfaces to get the properties of
+ *
+ * Gets the properties for all the @requests at once -- all the GetAll calls
+ * are sent to lvmdbusd before waiting for the first reply. Properties of the
+ * successful requests are added to @objects, errors are left in the requests.
+ */
+static void fetch_objects_properties (LVMObjects *objects, GPtrArray *requests) {
+    GMainContext *context = NULL;
+    PropsRequest *request = NULL;
+    guint n_pending = 0;
+    guint i = 0;
+
+    /* the replies are dispatched in the thread-default main context of the
+       calling thread, use a private one so that we don't dispatch anything
+       the caller may have attached to their own context */
+    context = g_main_context_new ();
+    g_main_context_push_thread_default (context);
+
+    for (i=0; i < requests->len; i++) {
+        request = g_ptr_array_index (requests, i);
+        request->n_pending = &n_pending;
+        n_pending++;
+        g_dbus_connection_call (bus, LVM_BUS_NAME, request->obj_path, DBUS_PROPS_IFACE,
+                                "GetAll", g_variant_new ("(s)", request->iface), G_VARIANT_TYPE ("(a{sv})"),
+                                G_DBUS_CALL_FLAGS_NONE, -1, NULL, props_request_done, request);
+    }
+
+    while (n_pending > 0)
+        g_main_context_iteration (context, TRUE);
+
+    g_main_context_pop_thread_default (context);
+    g_main_context_unref (context);
+
+    for (i=0; i < requests->len; i++) {
+        request = g_ptr_array_index (requests, i);
+        if (request->props)
+            lvm_objects_add_props (objects, request->obj_path, request->iface, request->props);
+    }
+}
+
+/**
+ * get_lv_pool_iface:
+ * @props: LvCommon properties of an LV
+ *
+ * Returns: (transfer none): the pool interface (ThinPool, CachePool or VdoPool)
+ *                           the LV has based on its segment type or %NULL if it
+ *                           is not a pool
+ */
+static const gchar* get_lv_pool_iface (GVariant *props) {
+    GVariant *segtypes = NULL;
+    GVariantIter iter;
+    const gchar *segtype = NULL;
+    const gchar *attr = NULL;
+    const gchar *ret = NULL;
+
+    segtypes = g_variant_lookup_value (props, "SegType", G_VARIANT_TYPE ("as"));
+    if (segtypes) {
+        g_variant_iter_init (&iter, segtypes);
+        while (!ret && g_variant_iter_next (&iter, "&s", &segtype)) {
+            if (g_strcmp0 (segtype, "thin-pool") == 0)
+                ret = THPOOL_INTF;
+            else if (g_strcmp0 (segtype, "cache-pool") == 0)
+                ret = CACHE_POOL_INTF;
+            else if (g_strcmp0 (segtype, "vdo-pool") == 0)
+                ret = VDO_POOL_INTF;
+        }
+        g_variant_unref (segtypes);
+    } else if (g_variant_lookup (props, "Attr", "&s", &attr)) {
+        /* no segment type, the first attribute tells the volume type */
+        if (attr[0] == 't')
+            ret = THPOOL_INTF;
+        else if (attr[0] == 'd')
+            ret = VDO_POOL_INTF;
     }
 
-    ret = get_object_properties (obj_path, iface, error);
-    g_free (obj_path);
     return ret;
 }
 
+/**
+ * get_lv_objects:
+ * @lv_path: lvmdbusd object path of the LV
+ * @tree: whether to get also the objects needed for the LV's segments and
+ *        data and metadata sub-LVs
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets the LV object and all the objects it references (VG, origin, pool,
+ * PVs,...) with their properties. Instead of one call at a time, the requests
+ * are sent in rounds of parallel calls -- the LV itself first and then
+ * everything it references together with its pool interface (if the LV is a
+ * pool, based on its segment type) and then the pool's data and metadata LVs.
+ *
+ * Returns: (transfer full): the @lv_path LV object and the objects it references
+ */
+static LVMObjects* get_lv_objects (const gchar *lv_path, gboolean tree, GError **error) {
+    LVMObjects *objects = NULL;
+    GPtrArray *requests = NULL;
+    PropsRequest *request = NULL;
+    GVariant *props = NULL;
+    GVariant *prop = NULL;
+    GVariantIter iter;
+    const gchar *path = NULL;
+    const gchar *pool_iface = NULL;
+
+    objects = g_new0 (LVMObjects, 1);
+    objects->table = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_variant_unref);
+
+    /* the LV itself, the other interfaces it may have depend on its type */
+    requests = g_ptr_array_new_with_free_func ((GDestroyNotify) props_request_free);
+    add_props_request (requests, objects, lv_path, LV_CMN_INTF);
+    fetch_objects_properties (objects, requests);
+
+    request = g_ptr_array_index (requests, 0);
+    if (!request->props) {
+        g_propagate_prefixed_error (error, request->error, "Failed to get properties of the %s object: ", lv_path);
+        request->error = NULL;
+        g_ptr_array_free (requests, TRUE);
+        lvm_objects_free (objects);
+        return NULL;
+    }
+    props = g_variant_ref (request->props);
+    g_ptr_array_free (requests, TRUE);
+
+    /* everything the LV references and the pool interface (if any), the LV
+       is already in objects so add_props_request() would skip it */
+    requests = g_ptr_array_new_with_free_func ((GDestroyNotify) props_request_free);
+    pool_iface = get_lv_pool_iface (props);
+    if (pool_iface) {
+        request = g_new0 (PropsRequest, 1);
+        request->obj_path = g_strdup (lv_path);
+        request->iface = pool_iface;
+        g_ptr_array_add (requests, request);
+    }
+    add_prop_props_request (requests, objects, props, "Vg", VG_INTF);
+    add_prop_props_request (requests, objects, props, "OriginLv", LV_CMN_INTF);
+    add_prop_props_request (requests, objects, props, "PoolLv", LV_CMN_INTF);
+    add_prop_props_request (requests, objects, props, "MovePv", PV_INTF);
+    if (tree) {
+        prop = g_variant_lookup_value (props, "Devices", G_VARIANT_TYPE ("a(oa(tts))"));
+        if (prop) {
+            g_variant_iter_init (&iter, prop);
+            while (g_variant_iter_next (&iter, "(&o@a(tts))", &path, NULL))
+                add_props_request (requests, objects, path, PV_INTF);
+            g_variant_unref (prop);
+        }
+        prop = g_variant_lookup_value (props, "HiddenLvs", G_VARIANT_TYPE ("ao"));
+        if (prop) {
+            g_variant_iter_init (&iter, prop);
+            while (g_variant_iter_next (&iter, "&o", &path))
+                add_props_request (requests, objects, path, LV_CMN_INTF);
+            g_variant_unref (prop);
+        }
+    }
+    g_variant_unref (props);
+
+    fetch_objects_properties (objects, requests);
+    g_ptr_array_free (requests, TRUE);
+
+    /* the pool's data and metadata LVs (unless already fetched as hidden LVs) */
+    if (pool_iface) {
+        requests = g_ptr_array_new_with_free_func ((GDestroyNotify) props_request_free);
+        prop = lookup_object_properties (objects, lv_path, pool_iface, NULL);
+        add_prop_props_request (requests, objects, prop, "DataLv", LV_CMN_INTF);
+        add_prop_props_request (requests, objects, prop, "MetaDataLv", LV_CMN_INTF);
+        if (prop)
+            g_variant_unref (prop);
+        if (requests->len > 0)
+            fetch_objects_properties (objects, requests);
+        g_ptr_array_free (requests, TRUE);
+    }
+
+    return objects;
+}
 
 static GVariant* get_pv_properties (const gchar *pv_name, GError **error) {
     gchar *obj_id = NULL;
@@ -870,18 +2158,6 @@ static GVariant* get_vg_properties (const gchar *vg_name, GError **error) {
     return ret;
 }
 
-static GVariant* get_lv_properties (const gchar *vg_name, const gchar *lv_name, GError **error) {
-    gchar *lvm_spec = NULL;
-    GVariant *ret = NULL;
-
-    lvm_spec = g_strdup_printf ("%s/%s", vg_name, lv_name);
-
-    ret = get_lvm_object_properties (lvm_spec, LV_CMN_INTF, error);
-    g_free (lvm_spec);
-
-    return ret;
-}
-
 static GVariant* get_vdo_properties (const gchar *vg_name, const gchar *pool_name, GError **error) {
     gchar *lvm_spec = NULL;
     GVariant *ret = NULL;
@@ -894,7 +2170,7 @@ static GVariant* get_vdo_properties (const gchar *vg_name, const gchar *pool_nam
     return ret;
 }
 
-static BDLVMPVdata* get_pv_data_from_props (GVariant *props, GError **error G_GNUC_UNUSED) {
+static BDLVMPVdata* get_pv_data_from_props (GVariant *props, LVMObjects *objects, GError **error G_GNUC_UNUSED) {
     BDLVMPVdata *data = g_new0 (BDLVMPVdata, 1);
     GVariantDict dict;
     gchar *path = NULL;
@@ -933,7 +2209,7 @@ static BDLVMPVdata* get_pv_data_from_props (GVariant *props, GError **error G_GN
         return data;
     }
 
-    vg_props = get_object_properties (path, VG_INTF, &l_error);
+    vg_props = lookup_object_properties (objects, path, VG_INTF, &l_error);
     g_variant_dict_clear (&dict);
     if (!vg_props) {
         if (l_error) {
@@ -980,6 +2256,7 @@ static BDLVMVGdata* get_vg_data_from_props (GVariant *props, GError **error G_GN
     g_variant_dict_lookup (&dict, "FreeCount", "t", &(data->free_count));
     g_variant_dict_lookup (&dict, "PvCount", "t", &(data->pv_count));
     g_variant_dict_lookup (&dict, "Exportable", "b", &(data->exported));
+    g_variant_dict_lookup (&dict, "Seqno", "t", &(data->seqno));
 
     value = g_variant_dict_lookup_value (&dict, "Tags", (GVariantType*) "as");
     if (value) {
@@ -997,34 +2274,32 @@ static BDLVMVGdata* get_vg_data_from_props (GVariant *props, GError **error G_GN
     return data;
 }
 
-static gchar* _lvm_data_lv_name (const gchar *vg_name, const gchar *lv_name, GError **error) {
+static gchar* _lvm_lv_name_from_path (LVMObjects *objects, const gchar *lv_path, GError **error) {
     GVariant *prop = NULL;
-    gchar *obj_id = NULL;
-    gchar *obj_path = NULL;
     gchar *ret = NULL;
-    gchar *segtype = NULL;
-
-    obj_id = g_strdup_printf ("%s/%s", vg_name, lv_name);
-    obj_path = get_object_path (obj_id, error);
-    g_free (obj_id);
-    if (!obj_path)
-        return NULL;
 
-    prop = get_lv_property (vg_name, lv_name, "SegType", error);
+    prop = lookup_object_property (objects, lv_path, LV_CMN_INTF, "Name", error);
     if (!prop)
         return NULL;
-    g_variant_get_child (prop, 0, "s", &segtype);
+
+    g_variant_get (prop, "s", &ret);
     g_variant_unref (prop);
 
+    return g_strstrip (g_strdelimit (ret, "[]", ' '));
+}
+
+static gchar* _lvm_data_lv_name (LVMObjects *objects, const gchar *lv_path, const gchar *segtype, GError **error) {
+    GVariant *prop = NULL;
+    gchar *obj_path = NULL;
+    gchar *ret = NULL;
+
     if (g_strcmp0 (segtype, "thin-pool") == 0)
-        prop = get_object_property (obj_path, THPOOL_INTF, "DataLv", NULL);
+        prop = lookup_object_property (objects, lv_path, THPOOL_INTF, "DataLv", NULL);
     else if (g_strcmp0 (segtype, "cache-pool") == 0)
-        prop = get_object_property (obj_path, CACHE_POOL_INTF, "DataLv", NULL);
+        prop = lookup_object_property (objects, lv_path, CACHE_POOL_INTF, "DataLv", NULL);
     else if (g_strcmp0 (segtype, "vdo-pool") == 0)
-        prop = get_object_property (obj_path, VDO_POOL_INTF, "DataLv", NULL);
+        prop = lookup_object_property (objects, lv_path, VDO_POOL_INTF, "DataLv", NULL);
 
-    g_free (segtype);
-    g_free (obj_path);
     if (!prop)
         return NULL;
     g_variant_get (prop, "o", &obj_path);
@@ -1035,34 +2310,20 @@ static gchar* _lvm_data_lv_name (const gchar *vg_name, const gchar *lv_name, GEr
         g_free (obj_path);
         return NULL;
     }
-    prop = get_object_property (obj_path, LV_CMN_INTF, "Name", error);
-    if (!prop) {
-        g_free (obj_path);
-        return NULL;
-    }
-
-    g_variant_get (prop, "s", &ret);
-    g_variant_unref (prop);
+    ret = _lvm_lv_name_from_path (objects, obj_path, error);
+    g_free (obj_path);
 
-    return g_strstrip (g_strdelimit (ret, "[]", ' '));
+    return ret;
 }
 
-static gchar* _lvm_metadata_lv_name (const gchar *vg_name, const gchar *lv_name, GError **error) {
+static gchar* _lvm_metadata_lv_name (LVMObjects *objects, const gchar *lv_path, GError **error) {
     GVariant *prop = NULL;
-    gchar *obj_id = NULL;
     gchar *obj_path = NULL;
     gchar *ret = NULL;
 
-    obj_id = g_strdup_printf ("%s/%s", vg_name, lv_name);
-    obj_path = get_object_path (obj_id, error);
-    g_free (obj_id);
-    if (!obj_path)
-        return NULL;
-
-    prop = get_object_property (obj_path, THPOOL_INTF, "MetaDataLv", NULL);
+    prop = lookup_object_property (objects, lv_path, THPOOL_INTF, "MetaDataLv", NULL);
     if (!prop)
-        prop = get_object_property (obj_path, CACHE_POOL_INTF, "MetaDataLv", NULL);
-    g_free (obj_path);
+        prop = lookup_object_property (objects, lv_path, CACHE_POOL_INTF, "MetaDataLv", NULL);
     if (!prop)
         return NULL;
     g_variant_get (prop, "o", &obj_path);
@@ -1073,19 +2334,13 @@ static gchar* _lvm_metadata_lv_name (const gchar *vg_name, const gchar *lv_name,
         g_free (obj_path);
         return NULL;
     }
-    prop = get_object_property (obj_path, LV_CMN_INTF, "Name", error);
-    if (!prop) {
-        g_free (obj_path);
-        return NULL;
-    }
-
-    g_variant_get (prop, "s", &ret);
-    g_variant_unref (prop);
+    ret = _lvm_lv_name_from_path (objects, obj_path, error);
+    g_free (obj_path);
 
-    return g_strstrip (g_strdelimit (ret, "[]", ' '));
+    return ret;
 }
 
-static BDLVMSEGdata** _lvm_segs (const gchar *vg_name, const gchar *lv_name, GError **error) {
+static BDLVMSEGdata** _lvm_segs (LVMObjects *objects, const gchar *lv_path, GError **error) {
     GVariant *prop = NULL;
     BDLVMSEGdata **segs;
     gsize n_segs;
@@ -1096,7 +2351,7 @@ static BDLVMSEGdata** _lvm_segs (const gchar *vg_name, const gchar *lv_name, GEr
     guint64 pv_first_pe, pv_last_pe;
     int i;
 
-    prop = get_lv_property (vg_name, lv_name, "Devices", error);
+    prop = lookup_object_property (objects, lv_path, LV_CMN_INTF, "Devices", error);
     if (!prop)
         return NULL;
 
@@ -1118,7 +2373,7 @@ static BDLVMSEGdata** _lvm_segs (const gchar *vg_name, const gchar *lv_name, GEr
     i = 0;
     g_variant_iter_init (&iter, prop);
     while (g_variant_iter_next (&iter, "(&o@a(tts))", &pv, &pv_segs)) {
-      pv_name_prop = get_object_property (pv, PV_INTF, "Name", NULL);
+      pv_name_prop = lookup_object_property (objects, pv, PV_INTF, "Name", NULL);
       if (pv_name_prop) {
         g_variant_get (pv_name_prop, "&s", &pv_name);
         g_variant_iter_init (&iter2, pv_segs);
@@ -1138,7 +2393,7 @@ static BDLVMSEGdata** _lvm_segs (const gchar *vg_name, const gchar *lv_name, GEr
     return segs;
 }
 
-static void _lvm_data_and_metadata_lvs (const gchar *vg_name, const gchar *lv_name,
+static void _lvm_data_and_metadata_lvs (LVMObjects *objects, const gchar *lv_path,
                                         gchar ***data_lvs_ret, gchar ***metadata_lvs_ret,
                                         GError **error) {
   GVariant *prop;
@@ -1150,11 +2405,10 @@ static void _lvm_data_and_metadata_lvs (const gchar *vg_name, const gchar *lv_na
   int i_metadata;
   const gchar *sublv;
   GVariant *sublv_roles_prop;
-  GVariant *sublv_name_prop;
   gchar *sublv_name;
   const gchar *role;
 
-  prop = get_lv_property (vg_name, lv_name, "HiddenLvs", error);
+  prop = lookup_object_property (objects, lv_path, LV_CMN_INTF, "HiddenLvs", error);
   if (!prop) {
     *data_lvs_ret = NULL;
     *metadata_lvs_ret = NULL;
@@ -1169,28 +2423,23 @@ static void _lvm_data_and_metadata_lvs (const gchar *vg_name, const gchar *lv_na
   i_metadata = 0;
   g_variant_iter_init (&iter, prop);
   while (g_variant_iter_next (&iter, "&o", &sublv)) {
-    sublv_roles_prop = get_object_property (sublv, LV_INTF, "Roles", NULL);
+    sublv_roles_prop = lookup_object_property (objects, sublv, LV_CMN_INTF, "Roles", NULL);
     if (sublv_roles_prop) {
-      sublv_name_prop = get_object_property (sublv, LV_INTF, "Name", NULL);
-      if (sublv_name_prop) {
-        g_variant_get (sublv_name_prop, "s", &sublv_name);
-        if (sublv_name) {
-          sublv_name = g_strstrip (g_strdelimit (sublv_name, "[]", ' '));
-          g_variant_iter_init (&iter2, sublv_roles_prop);
-          while (g_variant_iter_next (&iter2, "&s", &role)) {
-            if (g_strcmp0 (role, "image") == 0) {
-              data_lvs[i_data++] = sublv_name;
-              sublv_name = NULL;
-              break;
-            } else if (g_strcmp0 (role, "metadata") == 0) {
-              metadata_lvs[i_metadata++] = sublv_name;
-              sublv_name = NULL;
-              break;
-            }
+      sublv_name = _lvm_lv_name_from_path (objects, sublv, NULL);
+      if (sublv_name) {
+        g_variant_iter_init (&iter2, sublv_roles_prop);
+        while (g_variant_iter_next (&iter2, "&s", &role)) {
+          if (g_strcmp0 (role, "image") == 0) {
+            data_lvs[i_data++] = sublv_name;
+            sublv_name = NULL;
+            break;
+          } else if (g_strcmp0 (role, "metadata") == 0) {
+            metadata_lvs[i_metadata++] = sublv_name;
+            sublv_name = NULL;
+            break;
           }
-          g_free (sublv_name);
         }
-        g_variant_unref (sublv_name_prop);
+        g_free (sublv_name);
       }
       g_variant_unref (sublv_roles_prop);
     }
@@ -1203,7 +2452,7 @@ static void _lvm_data_and_metadata_lvs (const gchar *vg_name, const gchar *lv_na
   return;
 }
 
-static BDLVMLVdata* get_lv_data_from_props (GVariant *props, GError **error G_GNUC_UNUSED) {
+static BDLVMLVdata* get_lv_data_from_props (GVariant *props, LVMObjects *objects, GError **error G_GNUC_UNUSED) {
     BDLVMLVdata *data = g_new0 (BDLVMLVdata, 1);
     GVariantDict dict;
     GVariant *value = NULL;
@@ -1249,7 +2498,7 @@ static BDLVMLVdata* get_lv_data_from_props (GVariant *props, GError **error G_GN
 
     /* returns an object path for the VG */
     g_variant_dict_lookup (&dict, "Vg", "o", &path);
-    name = get_object_property (path, VG_INTF, "Name", NULL);
+    name = lookup_object_property (objects, path, VG_INTF, "Name", NULL);
     g_free (path);
     if (name) {
         g_variant_get (name, "s", &(data->vg_name));
@@ -1258,7 +2507,7 @@ static BDLVMLVdata* get_lv_data_from_props (GVariant *props, GError **error G_GN
 
     g_variant_dict_lookup (&dict, "OriginLv", "o", &path);
     if (g_strcmp0 (path, "/") != 0) {
-        name = get_object_property (path, LV_CMN_INTF, "Name", NULL);
+        name = lookup_object_property (objects, path, LV_CMN_INTF, "Name", NULL);
         if (name) {
             g_variant_get (name, "s", &(data->origin));
             g_variant_unref (name);
@@ -1269,7 +2518,7 @@ static BDLVMLVdata* get_lv_data_from_props (GVariant *props, GError **error G_GN
 
     g_variant_dict_lookup (&dict, "PoolLv", "o", &path);
     if (g_strcmp0 (path, "/") != 0) {
-        name = get_object_property (path, LV_CMN_INTF, "Name", NULL);
+        name = lookup_object_property (objects, path, LV_CMN_INTF, "Name", NULL);
         if (name) {
             g_variant_get (name, "s", &(data->pool_lv));
             g_variant_unref (name);
@@ -1280,7 +2529,7 @@ static BDLVMLVdata* get_lv_data_from_props (GVariant *props, GError **error G_GN
 
     g_variant_dict_lookup (&dict, "MovePv", "o", &path);
     if (path && g_strcmp0 (path, "/") != 0) {
-        name = get_object_property (path, PV_INTF, "Name", NULL);
+        name = lookup_object_property (objects, path, PV_INTF, "Name", NULL);
         if (name) {
             g_variant_get (name, "s", &(data->move_pv));
             g_variant_unref (name);
@@ -1530,22 +2779,7 @@ gboolean bd_lvm_pvremove (const gchar *device, const BDExtraArg **extra, GError
     return ret;
 }
 
-/**
- * bd_lvm_pvmove:
- * @src: the PV device to move extents off of
- * @dest: (nullable): the PV device to move extents onto or %NULL
- * @extra: (nullable) (array zero-terminated=1): extra options for the PV move
- *                                                 (just passed to LVM as is)
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the extents from the @src PV where successfully moved or not
- *
- * If @dest is %NULL, VG allocation rules are used for the extents from the @src
- * PV (see pvmove(8)).
- *
- * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
- */
-gboolean bd_lvm_pvmove (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error) {
+static gboolean _pvmove (const gchar *src, const gchar *dest, const BDExtraArg **extra, BDLVMJob **job, GError **error) {
     GVariant *prop = NULL;
     gchar *src_path = NULL;
     gchar *dest_path = NULL;
@@ -1598,12 +2832,55 @@ gboolean bd_lvm_pvmove (const gchar *src, const gchar *dest, const BDExtraArg **
     params = g_variant_builder_end (&builder);
     g_variant_builder_clear (&builder);
 
-    ret = call_lvm_method_sync (vg_obj_path, VG_INTF, "Move", params, NULL, extra, TRUE, error);
+    ret = run_lvm_method (vg_obj_path, VG_INTF, "Move", params, NULL, extra, TRUE, job, error);
+
+    g_free (src_path);
+    g_free (dest_path);
+    g_free (vg_obj_path);
+    return ret;
+}
+
+/**
+ * bd_lvm_pvmove:
+ * @src: the PV device to move extents off of
+ * @dest: (nullable): the PV device to move extents onto or %NULL
+ * @extra: (nullable) (array zero-terminated=1): extra options for the PV move
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the extents from the @src PV where successfully moved or not
+ *
+ * If @dest is %NULL, VG allocation rules are used for the extents from the @src
+ * PV (see pvmove(8)).
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_pvmove (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error) {
+    return _pvmove (src, dest, extra, NULL, error);
+}
+
+/**
+ * bd_lvm_pvmove_start:
+ * @src: the PV device to move extents off of
+ * @dest: (nullable): the PV device to move extents onto or %NULL
+ * @extra: (nullable) (array zero-terminated=1): extra options for the PV move
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_pvmove(), but doesn't wait for the extents to be moved. Use
+ * bd_lvm_job_wait() or bd_lvm_job_wait_any() to wait for the move to finish
+ * and get its result.
+ *
+ * Returns: (transfer full): a handle of the started PV move or %NULL in case
+ *                           it failed to start (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+BDLVMJob* bd_lvm_pvmove_start (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error) {
+    BDLVMJob *job = NULL;
 
-    g_free (src_path);
-    g_free (dest_path);
-    g_free (vg_obj_path);
-    return ret;
+    _pvmove (src, dest, extra, &job, error);
+    return job;
 }
 
 /**
@@ -1775,7 +3052,7 @@ BDLVMPVdata* bd_lvm_pvinfo (const gchar *device, GError **error) {
         /* the error is already populated */
         return NULL;
 
-    ret = get_pv_data_from_props (props, error);
+    ret = get_pv_data_from_props (props, NULL, error);
     g_variant_unref (props);
 
     return ret;
@@ -1790,51 +3067,58 @@ BDLVMPVdata* bd_lvm_pvinfo (const gchar *device, GError **error) {
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
  */
 BDLVMPVdata** bd_lvm_pvs (GError **error) {
-    gchar **objects = NULL;
+    LVMObjects *objects = NULL;
+    gchar **pvs = NULL;
     guint64 n_pvs = 0;
     GVariant *props = NULL;
     BDLVMPVdata **ret = NULL;
     guint64 i = 0;
-    GError *l_error = NULL;
 
-    objects = get_existing_objects (PV_OBJ_PREFIX, &l_error);
-    if (!objects) {
-        if (!l_error) {
-            /* no PVs */
-            ret = g_new0 (BDLVMPVdata*, 1);
-            ret[0] = NULL;
-            return ret;
-        } else {
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-    }
+    objects = get_managed_objects (error);
+    if (!objects)
+        return NULL;
 
-    n_pvs = g_strv_length ((gchar **) objects);
+    pvs = get_managed_object_paths (objects, PV_OBJ_PREFIX);
+    n_pvs = g_strv_length (pvs);
 
     /* now create the return value -- NULL-terminated array of BDLVMPVdata */
     ret = g_new0 (BDLVMPVdata*, n_pvs + 1);
     for (i=0; i < n_pvs; i++) {
-        props = get_object_properties (objects[i], PV_INTF, error);
+        props = lookup_object_properties (objects, pvs[i], PV_INTF, error);
         if (!props) {
-            g_strfreev (objects);
+            g_strfreev (pvs);
+            lvm_objects_free (objects);
+            for (guint64 j = 0; j < i; j++)
+                bd_lvm_pvdata_free (ret[j]);
             g_free (ret);
             return NULL;
         }
-        ret[i] = get_pv_data_from_props (props, error);
+        ret[i] = get_pv_data_from_props (props, objects, error);
         g_variant_unref (props);
-        if (!(ret[i])) {
-            g_strfreev (objects);
-            g_free (ret);
-            return NULL;
-        }
     }
     ret[i] = NULL;
 
-    g_strfreev (objects);
+    g_strfreev (pvs);
+    lvm_objects_free (objects);
     return ret;
 }
 
+/**
+ * bd_lvm_pvs_with_fields:
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_pvs(), the LVM DBus API always provides all the information
+ * so @fields are ignored.
+ *
+ * Returns: (array zero-terminated=1): information about PVs found in the system
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMPVdata** bd_lvm_pvs_with_fields (BDLVMQueryFields fields G_GNUC_UNUSED, GError **error) {
+    return bd_lvm_pvs (error);
+}
+
 /**
  * bd_lvm_vgcreate:
  * @name: name of the newly created VG
@@ -2150,51 +3434,58 @@ BDLVMVGdata* bd_lvm_vginfo (const gchar *vg_name, GError **error) {
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
  */
 BDLVMVGdata** bd_lvm_vgs (GError **error) {
-    gchar **objects = NULL;
+    LVMObjects *objects = NULL;
+    gchar **vgs = NULL;
     guint64 n_vgs = 0;
     GVariant *props = NULL;
     BDLVMVGdata **ret = NULL;
     guint64 i = 0;
-    GError *l_error = NULL;
 
-    objects = get_existing_objects (VG_OBJ_PREFIX, &l_error);
-    if (!objects) {
-        if (!l_error) {
-            /* no VGs */
-            ret = g_new0 (BDLVMVGdata*, 1);
-            ret[0] = NULL;
-            return ret;
-        } else {
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-    }
+    objects = get_managed_objects (error);
+    if (!objects)
+        return NULL;
 
-    n_vgs = g_strv_length ((gchar **) objects);
+    vgs = get_managed_object_paths (objects, VG_OBJ_PREFIX);
+    n_vgs = g_strv_length (vgs);
 
     /* now create the return value -- NULL-terminated array of BDLVMVGdata */
     ret = g_new0 (BDLVMVGdata*, n_vgs + 1);
     for (i=0; i < n_vgs; i++) {
-        props = get_object_properties (objects[i], VG_INTF, error);
+        props = lookup_object_properties (objects, vgs[i], VG_INTF, error);
         if (!props) {
-            g_strfreev (objects);
+            g_strfreev (vgs);
+            lvm_objects_free (objects);
+            for (guint64 j = 0; j < i; j++)
+                bd_lvm_vgdata_free (ret[j]);
             g_free (ret);
             return NULL;
         }
         ret[i] = get_vg_data_from_props (props, error);
         g_variant_unref (props);
-        if (!(ret[i])) {
-            g_strfreev (objects);
-            g_free (ret);
-            return NULL;
-        }
     }
     ret[i] = NULL;
 
-    g_strfreev (objects);
+    g_strfreev (vgs);
+    lvm_objects_free (objects);
     return ret;
 }
 
+/**
+ * bd_lvm_vgs_with_fields:
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_vgs(), the LVM DBus API always provides all the information
+ * so @fields are ignored.
+ *
+ * Returns: (array zero-terminated=1): information about VGs found in the system
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMVGdata** bd_lvm_vgs_with_fields (BDLVMQueryFields fields G_GNUC_UNUSED, GError **error) {
+    return bd_lvm_vgs (error);
+}
+
 /**
  * bd_lvm_lvorigin:
  * @vg_name: name of the VG containing the queried LV
@@ -2330,6 +3621,81 @@ gboolean bd_lvm_lvremove (const gchar *vg_name, const gchar *lv_name, gboolean f
     return call_lv_method_sync (vg_name, lv_name, "Remove", NULL, extra_params, extra, TRUE, error);
 }
 
+/**
+ * bd_lvm_lvcreate_many:
+ * @vg_name: name of the VG to create the new LVs in
+ * @specs: (array zero-terminated=1): specifications of the LVs to create
+ * @extra: (nullable) (array zero-terminated=1): extra options for the creation of
+ *                                                 each of the LVs (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Creates all the LVs specified by @specs, minimizing the overhead of running the
+ * LVM commands for each of them. A failure to create one of the LVs doesn't stop
+ * the creation of the others.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): results of the creation
+ *          for each of the @specs (in the same order) or %NULL in case of error
+ *          preventing the whole batch from being run
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_CREATE
+ */
+BDLVMBatchResult** bd_lvm_lvcreate_many (const gchar *vg_name, BDLVMLVSpec **specs, const BDExtraArg **extra, GError **error G_GNUC_UNUSED) {
+    GPtrArray *results = NULL;
+    BDLVMLVSpec **spec_p = NULL;
+    GError *l_error = NULL;
+
+    /* lvmdbusd has no batch methods, but it is already a persistent process
+       so there is no extra overhead for the individual calls */
+    results = g_ptr_array_new ();
+    for (spec_p = specs; spec_p && *spec_p; spec_p++) {
+        if ((*spec_p)->pool_name)
+            bd_lvm_thlvcreate (vg_name, (*spec_p)->pool_name, (*spec_p)->lv_name, (*spec_p)->size, extra, &l_error);
+        else
+            bd_lvm_lvcreate (vg_name, (*spec_p)->lv_name, (*spec_p)->size, (*spec_p)->type,
+                             (const gchar **) (*spec_p)->pv_list, extra, &l_error);
+        g_ptr_array_add (results, _lvm_batch_result_new ((*spec_p)->lv_name, l_error));
+        g_clear_error (&l_error);
+    }
+
+    g_ptr_array_add (results, NULL);
+    return (BDLVMBatchResult **) g_ptr_array_free (results, FALSE);
+}
+
+/**
+ * bd_lvm_lvremove_many:
+ * @vg_name: name of the VG containing the to-be-removed LVs
+ * @lv_names: (array zero-terminated=1): names of the to-be-removed LVs
+ * @force: whether to force removal or not
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV removal
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Removes all the @lv_names LVs, minimizing the number of LVM commands run.
+ * A failure to remove one of the LVs doesn't stop the removal of the others.
+ * LVs not existing in @vg_name are reported as failed with %BD_LVM_ERROR_NOEXIST.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): results of the removal
+ *          for each of the @lv_names (in the same order) or %NULL in case of error
+ *          preventing the whole batch from being run
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_REMOVE
+ */
+BDLVMBatchResult** bd_lvm_lvremove_many (const gchar *vg_name, const gchar **lv_names, gboolean force, const BDExtraArg **extra, GError **error G_GNUC_UNUSED) {
+    guint n_lvs = lv_names ? g_strv_length ((gchar **) lv_names) : 0;
+    BDLVMBatchResult **results = NULL;
+    GError *l_error = NULL;
+    guint i = 0;
+
+    results = g_new0 (BDLVMBatchResult *, n_lvs + 1);
+    for (i = 0; i < n_lvs; i++) {
+        bd_lvm_lvremove (vg_name, lv_names[i], force, extra, &l_error);
+        results[i] = _lvm_batch_result_new (lv_names[i], l_error);
+        g_clear_error (&l_error);
+    }
+
+    return results;
+}
+
 /**
  * bd_lvm_lvrename:
  * @vg_name: name of the VG containing the to-be-renamed LV
@@ -2351,20 +3717,8 @@ gboolean bd_lvm_lvrename (const gchar *vg_name, const gchar *lv_name, const gcha
     return call_lv_method_sync (vg_name, lv_name, "Rename", params, NULL, extra, TRUE, error);
 }
 
-/**
- * bd_lvm_lvresize:
- * @vg_name: name of the VG containing the to-be-resized LV
- * @lv_name: name of the to-be-resized LV
- * @size: the requested new size of the LV
- * @extra: (nullable) (array zero-terminated=1): extra options for the LV resize
- *                                                 (just passed to LVM as is)
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the @vg_name/@lv_name LV was successfully resized or not
- *
- * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
- */
-gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error) {
+static gboolean _lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, BDLVMJob **job, GError **error) {
+    g_autofree gchar *obj_id = NULL;
     GVariantBuilder builder;
     GVariantType *type = NULL;
     GVariant *params = NULL;
@@ -2391,7 +3745,48 @@ gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 si
       g_variant_builder_clear (&builder);
     }
 
-    return call_lv_method_sync (vg_name, lv_name, "Resize", params, extra_params, extra, TRUE, error);
+    obj_id = g_strdup_printf ("%s/%s", vg_name, lv_name);
+    return run_lvm_obj_method (obj_id, LV_INTF, "Resize", params, extra_params, extra, TRUE, job, error);
+}
+
+/**
+ * bd_lvm_lvresize:
+ * @vg_name: name of the VG containing the to-be-resized LV
+ * @lv_name: name of the to-be-resized LV
+ * @size: the requested new size of the LV
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV resize
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @vg_name/@lv_name LV was successfully resized or not
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error) {
+    return _lvresize (vg_name, lv_name, size, extra, NULL, error);
+}
+
+/**
+ * bd_lvm_lvresize_start:
+ * @vg_name: name of the VG containing the to-be-resized LV
+ * @lv_name: name of the to-be-resized LV
+ * @size: the requested new size of the LV
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV resize
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_lvresize(), but doesn't wait for the resize to finish.
+ *
+ * Returns: (transfer full): a handle of the started LV resize or %NULL in case
+ *                           it failed to start (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+BDLVMJob* bd_lvm_lvresize_start (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error) {
+    BDLVMJob *job = NULL;
+
+    _lvresize (vg_name, lv_name, size, extra, &job, error);
+    return job;
 }
 
 /**
@@ -2591,397 +3986,256 @@ gboolean bd_lvm_delete_lv_tags (const gchar *vg_name, const gchar *lv_name, cons
     return _manage_lvm_tags (obj_path, NULL, LV_INTF, tags, "TagsDel", error);
 }
 
-/**
- * bd_lvm_lvinfo:
- * @vg_name: name of the VG that contains the LV to get information about
- * @lv_name: name of the LV to get information about
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: (transfer full): information about the @vg_name/@lv_name LV or %NULL in case
- * of error (the @error) gets populated in those cases)
- *
- * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
- */
-BDLVMLVdata* bd_lvm_lvinfo (const gchar *vg_name, const gchar *lv_name, GError **error) {
+static BDLVMLVdata* get_lv_data_from_path (LVMObjects *objects, const gchar *lv_path, gboolean tree, GError **error) {
     GVariant *props = NULL;
-    BDLVMLVdata* ret = NULL;
+    BDLVMLVdata *ret = NULL;
+    GError *l_error = NULL;
 
-    props = get_lv_properties (vg_name, lv_name, error);
+    props = lookup_object_properties (objects, lv_path, LV_CMN_INTF, error);
     if (!props)
-        /* the error is already populated */
         return NULL;
 
-    ret = get_lv_data_from_props (props, error);
+    /* consumes (frees) props */
+    ret = get_lv_data_from_props (props, objects, error);
     if (!ret)
         return NULL;
 
-    if (g_strcmp0 (ret->segtype, "thin-pool") == 0 ||
-        g_strcmp0 (ret->segtype, "cache-pool") == 0) {
-        ret->data_lv = _lvm_data_lv_name (vg_name, lv_name, NULL);
-        ret->metadata_lv = _lvm_metadata_lv_name (vg_name, lv_name, NULL);
-    }
-    if (g_strcmp0 (ret->segtype, "vdo-pool") == 0) {
-        ret->data_lv = _lvm_data_lv_name (vg_name, lv_name, NULL);
-    }
-
-    return ret;
-}
-
-BDLVMLVdata* bd_lvm_lvinfo_tree (const gchar *vg_name, const gchar *lv_name, GError **error) {
-    GVariant *props = NULL;
-    BDLVMLVdata* ret = NULL;
+    if ((g_strcmp0 (ret->segtype, "thin-pool") == 0) ||
+        (g_strcmp0 (ret->segtype, "cache-pool") == 0)) {
+        ret->data_lv = _lvm_data_lv_name (objects, lv_path, ret->segtype, &l_error);
+        if (!l_error)
+            ret->metadata_lv = _lvm_metadata_lv_name (objects, lv_path, &l_error);
+    } else if (g_strcmp0 (ret->segtype, "vdo-pool") == 0)
+        ret->data_lv = _lvm_data_lv_name (objects, lv_path, ret->segtype, &l_error);
 
-    props = get_lv_properties (vg_name, lv_name, error);
-    if (!props)
-        /* the error is already populated */
-        return NULL;
+    if (tree && !l_error) {
+        ret->segs = _lvm_segs (objects, lv_path, &l_error);
+        if (!l_error)
+            _lvm_data_and_metadata_lvs (objects, lv_path, &ret->data_lvs, &ret->metadata_lvs, &l_error);
+    }
 
-    ret = get_lv_data_from_props (props, error);
-    if (!ret)
+    if (l_error) {
+        bd_lvm_lvdata_free (ret);
+        g_propagate_error (error, l_error);
         return NULL;
-
-    if (g_strcmp0 (ret->segtype, "thin-pool") == 0 ||
-        g_strcmp0 (ret->segtype, "cache-pool") == 0) {
-        ret->data_lv = _lvm_data_lv_name (vg_name, lv_name, NULL);
-        ret->metadata_lv = _lvm_metadata_lv_name (vg_name, lv_name, NULL);
-    }
-    if (g_strcmp0 (ret->segtype, "vdo-pool") == 0) {
-        ret->data_lv = _lvm_data_lv_name (vg_name, lv_name, NULL);
     }
-    ret->segs = _lvm_segs (vg_name, lv_name, NULL);
-    _lvm_data_and_metadata_lvs (vg_name, lv_name, &ret->data_lvs, &ret->metadata_lvs, NULL);
 
     return ret;
 }
 
-static gchar* get_lv_vg_name (const gchar *lv_obj_path, GError **error) {
-    GVariant *value = NULL;
-    gchar *vg_obj_path = NULL;
-    gchar *ret = NULL;
-
-    value = get_object_property (lv_obj_path, LV_CMN_INTF, "Vg", error);
-    g_variant_get (value, "o", &vg_obj_path);
-    g_variant_unref (value);
-
-    value = get_object_property (vg_obj_path, VG_INTF, "Name", error);
-    g_variant_get (value, "s", &ret);
-    g_free (vg_obj_path);
-    g_variant_unref (value);
-
-    return ret;
-}
-
-/**
- * filter_lvs_by_vg: (skip)
- *
- * Filter LVs by VG name and prepend the matching ones to the @out list.
- */
-static gboolean filter_lvs_by_vg (gchar **lvs, const gchar *vg_name, GSList **out, guint64 *n_lvs, GError **error) {
-    gchar **lv_p = NULL;
-    gchar *lv_vg_name = NULL;
-    gboolean success = TRUE;
-
-    if (!lvs)
-        /* nothing to do */
-        return TRUE;
-
-    for (lv_p=lvs; *lv_p; lv_p++) {
-        if (vg_name) {
-            lv_vg_name = get_lv_vg_name (*lv_p, error);
-            if (!lv_vg_name) {
-                g_free (*lv_p);
-                success = FALSE;
-                continue;
-            }
-
-            if (g_strcmp0 (lv_vg_name, vg_name) == 0) {
-                *out = g_slist_prepend (*out, *lv_p);
-                (*n_lvs)++;
-            } else {
-                g_free (*lv_p);
-            }
-
-            g_free (lv_vg_name);
-        } else {
-            *out = g_slist_prepend (*out, *lv_p);
-            (*n_lvs)++;
-        }
-    }
-    return success;
-}
-
-/**
- * bd_lvm_lvs:
- * @vg_name: (nullable): name of the VG to get information about LVs from
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: (array zero-terminated=1): information about LVs found in the given
- * @vg_name VG or in system if @vg_name is %NULL
- *
- * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
- */
-BDLVMLVdata** bd_lvm_lvs (const gchar *vg_name, GError **error) {
-    gchar **lvs = NULL;
-    guint64 n_lvs = 0;
-    GVariant *props = NULL;
-    BDLVMLVdata **ret = NULL;
-    guint64 j = 0;
-    GSList *matched_lvs = NULL;
-    GSList *lv = NULL;
-    gboolean success = FALSE;
+static BDLVMLVdata* get_lv_data (const gchar *vg_name, const gchar *lv_name, gboolean tree, GError **error) {
+    g_autofree gchar *lv_spec = NULL;
+    g_autofree gchar *lv_path = NULL;
+    LVMObjects *objects = NULL;
     GError *l_error = NULL;
+    BDLVMLVdata *ret = NULL;
 
-    lvs = get_existing_objects (LV_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-
-    lvs = get_existing_objects (THIN_POOL_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-
-    lvs = get_existing_objects (CACHE_POOL_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-
-    lvs = get_existing_objects (VDO_POOL_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-
-    lvs = get_existing_objects (HIDDEN_LV_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
+    lv_spec = g_strdup_printf ("%s/%s", vg_name, lv_name);
+    lv_path = get_object_path (lv_spec, error);
+    if (!lv_path)
+        /* the error is already populated */
         return NULL;
-    }
 
-    if (n_lvs == 0) {
-        /* no LVs */
-        ret = g_new0 (BDLVMLVdata*, 1);
-        ret[0] = NULL;
-        g_slist_free_full (matched_lvs, g_free);
-        return ret;
+    /* with the DBus object cache everything is already in memory, otherwise
+       get the LV and all the objects it references at once */
+    if (!bd_lvm_get_dbus_cache (NULL)) {
+        objects = get_lv_objects (lv_path, tree, error);
+        if (!objects)
+            return NULL;
     }
 
-    /* we have been prepending to the list so far, but it will be nicer if we
-       reverse it (to get back the original order) */
-    matched_lvs = g_slist_reverse (matched_lvs);
-
-    /* now create the return value -- NULL-terminated array of BDLVMLVdata */
-    ret = g_new0 (BDLVMLVdata*, n_lvs + 1);
-
-    lv = matched_lvs;
-    while (lv) {
-        props = get_object_properties (lv->data, LV_CMN_INTF, &l_error);
-        if (!props) {
-            g_slist_free_full (matched_lvs, g_free);
-            g_free (ret);
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-        ret[j] = get_lv_data_from_props (props, &l_error);
-        if (!(ret[j])) {
-            g_slist_free_full (matched_lvs, g_free);
-            for (guint64 i = 0; i < j; i++)
-                bd_lvm_lvdata_free (ret[i]);
-            g_free (ret);
-            g_propagate_error (error, l_error);
-            return NULL;
-        } else if ((g_strcmp0 (ret[j]->segtype, "thin-pool") == 0) ||
-                   (g_strcmp0 (ret[j]->segtype, "cache-pool") == 0)) {
-            ret[j]->data_lv = _lvm_data_lv_name (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-            ret[j]->metadata_lv = _lvm_metadata_lv_name (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-        } else if (g_strcmp0 (ret[j]->segtype, "vdo-pool") == 0) {
-            ret[j]->data_lv = _lvm_data_lv_name (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-        }
-        if (l_error) {
-            g_slist_free_full (matched_lvs, g_free);
-            for (guint64 i = 0; i <= j; i++)
-                bd_lvm_lvdata_free (ret[i]);
-            g_free (ret);
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-        j++;
-        lv = g_slist_next (lv);
+    ret = get_lv_data_from_path (objects, lv_path, FALSE, error);
+    if (ret && tree) {
+        /* errors when getting the tree information are not fatal here */
+        ret->segs = _lvm_segs (objects, lv_path, &l_error);
+        g_clear_error (&l_error);
+        _lvm_data_and_metadata_lvs (objects, lv_path, &ret->data_lvs, &ret->metadata_lvs, &l_error);
+        g_clear_error (&l_error);
     }
-    g_slist_free_full (matched_lvs, g_free);
 
-    ret[j] = NULL;
+    lvm_objects_free (objects);
     return ret;
 }
 
-BDLVMLVdata** bd_lvm_lvs_tree (const gchar *vg_name, GError **error) {
+/**
+ * bd_lvm_lvinfo:
+ * @vg_name: name of the VG that contains the LV to get information about
+ * @lv_name: name of the LV to get information about
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer full): information about the @vg_name/@lv_name LV or %NULL in case
+ * of error (the @error) gets populated in those cases)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata* bd_lvm_lvinfo (const gchar *vg_name, const gchar *lv_name, GError **error) {
+    return get_lv_data (vg_name, lv_name, FALSE, error);
+}
+
+BDLVMLVdata* bd_lvm_lvinfo_tree (const gchar *vg_name, const gchar *lv_name, GError **error) {
+    return get_lv_data (vg_name, lv_name, TRUE, error);
+}
+
+/**
+ * get_lvs_data: (skip)
+ *
+ * Gets information about all the LVs in the @vg_name VG (or in the system if
+ * @vg_name is %NULL) using a single GetManagedObjects call to get all the
+ * objects and their properties from lvmdbusd.
+ */
+static BDLVMLVdata** get_lvs_data (const gchar *vg_name, gboolean tree, GError **error) {
+    const gchar *obj_prefixes[] = {LV_OBJ_PREFIX, THIN_POOL_OBJ_PREFIX, CACHE_POOL_OBJ_PREFIX,
+                                   VDO_POOL_OBJ_PREFIX, HIDDEN_LV_OBJ_PREFIX, NULL};
+    const gchar **prefix_p = NULL;
+    LVMObjects *objects = NULL;
     gchar **lvs = NULL;
-    guint64 n_lvs = 0;
-    GVariant *props = NULL;
-    BDLVMLVdata **ret = NULL;
-    guint64 j = 0;
-    GSList *matched_lvs = NULL;
-    GSList *lv = NULL;
-    gboolean success = FALSE;
+    gchar **lv_p = NULL;
+    GPtrArray *ret = NULL;
+    GVariant *value = NULL;
+    gchar *vg_path = NULL;
+    gchar *lv_vg_name = NULL;
+    BDLVMLVdata *data = NULL;
     GError *l_error = NULL;
 
-    lvs = get_existing_objects (LV_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
+    objects = get_managed_objects (error);
+    if (!objects)
         return NULL;
-    }
 
-    lvs = get_existing_objects (THIN_POOL_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
+    ret = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_lvdata_free);
+    for (prefix_p=obj_prefixes; *prefix_p && !l_error; prefix_p++) {
+        lvs = get_managed_object_paths (objects, *prefix_p);
+        for (lv_p=lvs; *lv_p && !l_error; lv_p++) {
+            if (vg_name) {
+                value = lookup_object_property (objects, *lv_p, LV_CMN_INTF, "Vg", &l_error);
+                if (!value)
+                    break;
+                g_variant_get (value, "o", &vg_path);
+                g_variant_unref (value);
+
+                value = lookup_object_property (objects, vg_path, VG_INTF, "Name", &l_error);
+                g_free (vg_path);
+                if (!value)
+                    break;
+                g_variant_get (value, "s", &lv_vg_name);
+                g_variant_unref (value);
+
+                if (g_strcmp0 (lv_vg_name, vg_name) != 0) {
+                    g_free (lv_vg_name);
+                    continue;
+                }
+                g_free (lv_vg_name);
+            }
 
-    lvs = get_existing_objects (CACHE_POOL_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
+            data = get_lv_data_from_path (objects, *lv_p, tree, &l_error);
+            if (data)
+                g_ptr_array_add (ret, data);
+        }
+        g_strfreev (lvs);
     }
+    lvm_objects_free (objects);
 
-    lvs = get_existing_objects (VDO_POOL_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
+    if (l_error) {
+        g_ptr_array_free (ret, TRUE);
         g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
         return NULL;
     }
 
-    lvs = get_existing_objects (HIDDEN_LV_OBJ_PREFIX, &l_error);
-    if (!lvs && l_error) {
-        g_propagate_error (error, l_error);
-        g_slist_free_full (matched_lvs, g_free);
-        return NULL;
-    }
-    success = filter_lvs_by_vg (lvs, vg_name, &matched_lvs, &n_lvs, error);
-    g_free (lvs);
-    if (!success) {
-        g_slist_free_full (matched_lvs, g_free);
+    g_ptr_array_add (ret, NULL);
+    return (BDLVMLVdata **) g_ptr_array_free (ret, FALSE);
+}
+
+/**
+ * bd_lvm_lvs:
+ * @vg_name: (nullable): name of the VG to get information about LVs from
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (array zero-terminated=1): information about LVs found in the given
+ * @vg_name VG or in system if @vg_name is %NULL
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata** bd_lvm_lvs (const gchar *vg_name, GError **error) {
+    return get_lvs_data (vg_name, FALSE, error);
+}
+
+/**
+ * bd_lvm_lvs_with_fields:
+ * @vg_name: (nullable): name of the VG to get information about LVs from
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_lvs(), the LVM DBus API always provides all the information
+ * so @fields are ignored.
+ *
+ * Returns: (array zero-terminated=1): information about LVs found in the given
+ * @vg_name VG or in system if @vg_name is %NULL
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata** bd_lvm_lvs_with_fields (const gchar *vg_name, BDLVMQueryFields fields G_GNUC_UNUSED, GError **error) {
+    return bd_lvm_lvs (vg_name, error);
+}
+
+BDLVMLVdata** bd_lvm_lvs_tree (const gchar *vg_name, GError **error) {
+    return get_lvs_data (vg_name, TRUE, error);
+}
+
+/**
+ * bd_lvm_lvs_tree_with_fields:
+ * @vg_name: (nullable): name of the VG to get information about LVs from
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_lvs_tree(), the LVM DBus API always provides all the information
+ * so @fields are ignored.
+ *
+ * Returns: (array zero-terminated=1): information about LVs found in the given
+ * @vg_name VG or in system if @vg_name is %NULL.
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata** bd_lvm_lvs_tree_with_fields (const gchar *vg_name, BDLVMQueryFields fields G_GNUC_UNUSED, GError **error) {
+    return bd_lvm_lvs_tree (vg_name, error);
+}
+
+/**
+ * bd_lvm_full_report:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets information about all PVs, VGs and LVs (including their segments) in
+ * the system at once. This is much cheaper than calling bd_lvm_pvs(),
+ * bd_lvm_vgs() and bd_lvm_lvs_tree() one after another because the devices are
+ * scanned only once.
+ *
+ * Returns: (transfer full): information about PVs, VGs and LVs found in the
+ * system or %NULL in case of error (the @error) gets populated in those cases)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMFullReport* bd_lvm_full_report (GError **error) {
+    BDLVMFullReport *ret = NULL;
+
+    /* lvmdbusd keeps its own (already scanned) state so there are no extra
+       device scans to save here, just gather everything from the objects */
+    ret = g_new0 (BDLVMFullReport, 1);
+    ret->pvs = bd_lvm_pvs (error);
+    if (!ret->pvs) {
+        bd_lvm_full_report_free (ret);
         return NULL;
     }
 
-    if (n_lvs == 0) {
-        /* no LVs */
-        ret = g_new0 (BDLVMLVdata*, 1);
-        ret[0] = NULL;
-        g_slist_free_full (matched_lvs, g_free);
-        return ret;
+    ret->vgs = bd_lvm_vgs (error);
+    if (!ret->vgs) {
+        bd_lvm_full_report_free (ret);
+        return NULL;
     }
 
-    /* we have been prepending to the list so far, but it will be nicer if we
-       reverse it (to get back the original order) */
-    matched_lvs = g_slist_reverse (matched_lvs);
-
-    /* now create the return value -- NULL-terminated array of BDLVMLVdata */
-    ret = g_new0 (BDLVMLVdata*, n_lvs + 1);
-
-    lv = matched_lvs;
-    while (lv) {
-        props = get_object_properties (lv->data, LV_CMN_INTF, &l_error);
-        if (!props) {
-            g_slist_free_full (matched_lvs, g_free);
-            g_free (ret);
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-        ret[j] = get_lv_data_from_props (props, &l_error);
-        if (!(ret[j])) {
-            g_slist_free_full (matched_lvs, g_free);
-            for (guint64 i = 0; i < j; i++)
-                bd_lvm_lvdata_free (ret[i]);
-            g_free (ret);
-            g_propagate_error (error, l_error);
-            return NULL;
-        } else if ((g_strcmp0 (ret[j]->segtype, "thin-pool") == 0) ||
-                   (g_strcmp0 (ret[j]->segtype, "cache-pool") == 0)) {
-            ret[j]->data_lv = _lvm_data_lv_name (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-            ret[j]->metadata_lv = _lvm_metadata_lv_name (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-        } else if (g_strcmp0 (ret[j]->segtype, "vdo-pool") == 0) {
-            ret[j]->data_lv = _lvm_data_lv_name (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-        }
-        ret[j]->segs = _lvm_segs (ret[j]->vg_name, ret[j]->lv_name, &l_error);
-        _lvm_data_and_metadata_lvs (ret[j]->vg_name, ret[j]->lv_name, &ret[j]->data_lvs, &ret[j]->metadata_lvs,
-                                    &l_error);
-        if (l_error) {
-            g_slist_free_full (matched_lvs, g_free);
-            for (guint64 i = 0; i <= j; i++)
-                bd_lvm_lvdata_free (ret[i]);
-            g_free (ret);
-            g_propagate_error (error, l_error);
-            return NULL;
-        }
-        j++;
-        lv = g_slist_next (lv);
+    ret->lvs = bd_lvm_lvs_tree (NULL, error);
+    if (!ret->lvs) {
+        bd_lvm_full_report_free (ret);
+        return NULL;
     }
-    g_slist_free_full (matched_lvs, g_free);
 
-    ret[j] = NULL;
     return ret;
 }
 
@@ -3937,29 +5191,10 @@ gboolean bd_lvm_vdo_pool_resize (const gchar *vg_name, const gchar *pool_name, g
     return bd_lvm_lvresize (vg_name, pool_name, size, extra, error);
 }
 
-/**
- * bd_lvm_vdo_pool_convert:
- * @vg_name: name of the VG that contains @pool_lv
- * @pool_lv: name of the LV that should become the new VDO pool LV
- * @name: (nullable): name for the VDO LV or %NULL for default name
- * @virtual_size: virtual size for the new VDO LV
- * @extra: (nullable) (array zero-terminated=1): extra options for the VDO pool creation
- *                                                 (just passed to LVM as is)
- * @error: (out) (optional): place to store error (if any)
- *
- * Converts the @pool_lv into a new VDO pool LV in the @vg_name VG and creates a new
- * @name VDO LV with size @virtual_size.
- *
- * Note: All data on @pool_lv will be irreversibly destroyed.
- *
- * Returns: whether the new VDO pool LV was successfully created from @pool_lv and or not
- *
- * Tech category: %BD_LVM_TECH_VDO-%BD_LVM_TECH_MODE_CREATE&%BD_LVM_TECH_MODE_MODIFY
- */
-gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name,
-                                  guint64 virtual_size, guint64 index_memory, gboolean compression,
-                                  gboolean deduplication, BDLVMVDOWritePolicy write_policy,
-                                  const BDExtraArg **extra, GError **error) {
+static gboolean _vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name,
+                                   guint64 virtual_size, guint64 index_memory, gboolean compression,
+                                   gboolean deduplication, BDLVMVDOWritePolicy write_policy,
+                                   const BDExtraArg **extra, BDLVMJob **job, GError **error) {
     GVariantBuilder builder;
     GVariant *params = NULL;
     GVariant *extra_params = NULL;
@@ -4015,7 +5250,7 @@ gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, co
         global_config_str = g_strdup_printf ("%s allocation {vdo_write_policy=\"%s\"}", old_config ? old_config : "",
                                                                                         write_policy_str);
 
-    ret = call_lvm_obj_method_sync (vg_name, VG_VDO_INTF, "CreateVdoPool", params, extra_params, extra, FALSE, error);
+    ret = run_lvm_obj_method (vg_name, VG_VDO_INTF, "CreateVdoPool", params, extra_params, extra, FALSE, job, error);
 
     g_free (global_config_str);
     global_config_str = old_config;
@@ -4024,6 +5259,67 @@ gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, co
     return ret;
 }
 
+/**
+ * bd_lvm_vdo_pool_convert:
+ * @vg_name: name of the VG that contains @pool_lv
+ * @pool_lv: name of the LV that should become the new VDO pool LV
+ * @name: (nullable): name for the VDO LV or %NULL for default name
+ * @virtual_size: virtual size for the new VDO LV
+ * @extra: (nullable) (array zero-terminated=1): extra options for the VDO pool creation
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Converts the @pool_lv into a new VDO pool LV in the @vg_name VG and creates a new
+ * @name VDO LV with size @virtual_size.
+ *
+ * Note: All data on @pool_lv will be irreversibly destroyed.
+ *
+ * Returns: whether the new VDO pool LV was successfully created from @pool_lv and or not
+ *
+ * Tech category: %BD_LVM_TECH_VDO-%BD_LVM_TECH_MODE_CREATE&%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name,
+                                  guint64 virtual_size, guint64 index_memory, gboolean compression,
+                                  gboolean deduplication, BDLVMVDOWritePolicy write_policy,
+                                  const BDExtraArg **extra, GError **error) {
+    return _vdo_pool_convert (vg_name, pool_lv, name, virtual_size, index_memory, compression, deduplication,
+                              write_policy, extra, NULL, error);
+}
+
+/**
+ * bd_lvm_vdo_pool_convert_start:
+ * @vg_name: name of the VG that contains @pool_lv
+ * @pool_lv: name of the LV that should become the new VDO pool LV
+ * @name: (nullable): name for the VDO LV or %NULL for default name
+ * @virtual_size: virtual size for the new VDO LV
+ * @index_memory: amount of index memory (in bytes) or 0 for default
+ * @compression: whether to enable compression or not
+ * @deduplication: whether to enable deduplication or not
+ * @write_policy: write policy for the volume
+ * @extra: (nullable) (array zero-terminated=1): extra options for the VDO pool creation
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_vdo_pool_convert(), but doesn't wait for the conversion to finish.
+ *
+ * Note: All data on @pool_lv will be irreversibly destroyed.
+ *
+ * Returns: (transfer full): a handle of the started conversion or %NULL in case
+ *                           it failed to start (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_VDO-%BD_LVM_TECH_MODE_CREATE&%BD_LVM_TECH_MODE_MODIFY
+ */
+BDLVMJob* bd_lvm_vdo_pool_convert_start (const gchar *vg_name, const gchar *pool_lv, const gchar *name,
+                                         guint64 virtual_size, guint64 index_memory, gboolean compression,
+                                         gboolean deduplication, BDLVMVDOWritePolicy write_policy,
+                                         const BDExtraArg **extra, GError **error) {
+    BDLVMJob *job = NULL;
+
+    _vdo_pool_convert (vg_name, pool_lv, name, virtual_size, index_memory, compression, deduplication,
+                       write_policy, extra, &job, error);
+    return job;
+}
+
 /**
  * bd_lvm_vdolvpoolname:
  * @vg_name: name of the VG containing the queried VDO LV
@@ -4070,6 +5366,161 @@ gchar* bd_lvm_vdolvpoolname (const gchar *vg_name, const gchar *lv_name, GError
     return ret;
 }
 
+/**
+ * bd_lvm_job_get_progress:
+ * @job: LVM job to get the progress of
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: progress of the @job in percents as reported by lvmdbusd or -1 in
+ *          case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gdouble bd_lvm_job_get_progress (BDLVMJob *job, GError **error) {
+    LVMDBusJob *dbus_job = (LVMDBusJob *) job->priv;
+    GVariant *prop = NULL;
+    gdouble progress = 0;
+
+    g_mutex_lock (&(dbus_job->lock));
+    if (dbus_job->finished) {
+        progress = dbus_job->progress;
+        g_mutex_unlock (&(dbus_job->lock));
+        return progress;
+    }
+
+    prop = get_object_property (dbus_job->task_path, JOB_INTF, "Percent", error);
+    if (!prop) {
+        g_mutex_unlock (&(dbus_job->lock));
+        return -1;
+    }
+    g_variant_get (prop, "d", &progress);
+    g_variant_unref (prop);
+    dbus_job->progress = progress;
+    g_mutex_unlock (&(dbus_job->lock));
+
+    return progress;
+}
+
+/**
+ * bd_lvm_job_wait:
+ * @job: LVM job to wait for
+ * @timeout: how long to wait for the @job to finish (in milliseconds, 0 to
+ *           not wait at all, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: %TRUE if the @job finished successfully, %FALSE if it failed (@error
+ *          is set to the error of the operation in that case) or if it didn't
+ *          finish in @timeout (@error is not set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gboolean bd_lvm_job_wait (BDLVMJob *job, gint timeout, GError **error) {
+    LVMDBusJob *dbus_job = (LVMDBusJob *) job->priv;
+    BDLVMJob *jobs[2] = {job, NULL};
+    gboolean ret = TRUE;
+
+    if (bd_lvm_job_wait_any (jobs, timeout, error) != 0)
+        return FALSE;
+
+    g_mutex_lock (&(dbus_job->lock));
+    if (dbus_job->error) {
+        g_propagate_error (error, g_error_copy (dbus_job->error));
+        ret = FALSE;
+    }
+    g_mutex_unlock (&(dbus_job->lock));
+
+    return ret;
+}
+
+/**
+ * bd_lvm_job_wait_any:
+ * @jobs: (array zero-terminated=1): LVM jobs to wait for
+ * @timeout: how long to wait for any of the @jobs to finish (in milliseconds,
+ *           0 to not wait at all, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Waits for any of the @jobs to finish. Jobs that already finished count too
+ * so the finished jobs should be removed from @jobs before the next call. Use
+ * bd_lvm_job_wait() with @timeout 0 to get the result of the finished job.
+ *
+ * All the lvmdbusd jobs are watched at once using the signals lvmdbusd emits
+ * when they change.
+ *
+ * Returns: index of a finished job in @jobs or -1 if none of them finished in
+ *          @timeout or in case of error (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gint bd_lvm_job_wait_any (BDLVMJob **jobs, gint timeout, GError **error) {
+    LVMDBusJob *dbus_job = NULL;
+    JobWaitData *wait_data = NULL;
+    guint n_jobs = 0;
+    gint ret = -1;
+    guint i = 0;
+    GError *l_error = NULL;
+
+    for (n_jobs=0; jobs && jobs[n_jobs]; n_jobs++) {
+        dbus_job = (LVMDBusJob *) jobs[n_jobs]->priv;
+        if (lvm_dbus_job_is_finished (dbus_job))
+            return n_jobs;
+    }
+
+    if (n_jobs == 0) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                             "No jobs to wait for");
+        return -1;
+    }
+
+    wait_data = g_new0 (JobWaitData, n_jobs);
+    for (i=0; i < n_jobs; i++) {
+        dbus_job = (LVMDBusJob *) jobs[i]->priv;
+        wait_data[i].task_path = dbus_job->task_path;
+        wait_data[i].prog_id = dbus_job->prog_id;
+        wait_data[i].log_task_id = dbus_job->log_task_id;
+    }
+
+    if (wait_for_jobs (wait_data, n_jobs, timeout, &l_error)) {
+        for (i=0; i < n_jobs; i++) {
+            if (!wait_data[i].completed)
+                continue;
+            lvm_dbus_job_completed ((LVMDBusJob *) jobs[i]->priv);
+            if (ret < 0)
+                ret = i;
+        }
+    } else if (l_error) {
+        /* another thread may have finished (and removed) one of the jobs */
+        for (i=0; ret < 0 && i < n_jobs; i++)
+            if (lvm_dbus_job_is_finished ((LVMDBusJob *) jobs[i]->priv))
+                ret = i;
+        if (ret >= 0)
+            g_clear_error (&l_error);
+        else {
+            g_prefix_error (&l_error, "Waiting for the jobs to finish failed: ");
+            g_propagate_error (error, l_error);
+        }
+    }
+
+    g_free (wait_data);
+    return ret;
+}
+
+/**
+ * bd_lvm_job_cancel:
+ * @job: LVM job to cancel
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the cancellation was successfully requested or not, always
+ *          %FALSE with this plugin because lvmdbusd doesn't support cancelling
+ *          its jobs
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_job_cancel (BDLVMJob *job G_GNUC_UNUSED, GError **error) {
+    g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_NOT_SUPPORTED,
+                         "Cancelling jobs is not supported by lvmdbusd");
+    return FALSE;
+}
+
 
 
 
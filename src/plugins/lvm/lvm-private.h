@@ -2,6 +2,7 @@
 #define BD_LVM_PRIVATE
 
 #define SECTOR_SIZE 512
+#define THIN_METADATA_BLOCK_SIZE 4096
 #define DEFAULT_PE_SIZE (4 MiB)
 #define USE_DEFAULT_PE_SIZE 0
 #define RESOLVE_PE_SIZE(size) ((size) == USE_DEFAULT_PE_SIZE ? DEFAULT_PE_SIZE : (size))
@@ -15,5 +16,6 @@ extern gchar *global_config_str;
 extern gchar *global_devices_str;
 
 void _lvm_check_vdo_index_memory (guint64 index_memory);
+BDLVMBatchResult* _lvm_batch_result_new (const gchar *lv_name, const GError *error);
 
 #endif /* BD_LVM_PRIVATE */
@@ -0,0 +1,770 @@
+/*
+ * Copyright (C) 2025  Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define _GNU_SOURCE
+#include <glib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <blockdev/utils.h>
+#include <json-glib/json-glib.h>
+
+#include "lvm-shell.h"
+
+/* Instead of spawning a new `lvm` process (paying for its startup, config
+ * parsing,...) for every command, the commands can be passed to a single
+ * long-running `lvm shell` process. Reports and the command log are read
+ * from the shell's `LVM_REPORT_FD` in the JSON format, the standard output
+ * is only used to detect the prompt marking the end of a command. */
+
+#define LVM_SHELL_PROMPT "lvm> "
+
+/* FD the shell writes reports (and the command log) to */
+#define LVM_SHELL_REPORT_FD 3
+
+/* lvm shell refuses command lines with this many (or more) arguments */
+#define LVM_SHELL_MAX_ARGS 64
+
+/* buffer size in bytes used to read from the shell's outputs */
+#define LVM_SHELL_BUF_SIZE 64*1024
+
+/* time (in milliseconds) the shell gets to exit once its input is closed */
+#define LVM_SHELL_EXIT_TIMEOUT 1000
+
+/* return code of a successfully processed LVM command (ECMD_PROCESSED) */
+#define LVM_RET_CODE_OK 1
+/* return code of a failed LVM command (ECMD_FAILED) */
+#define LVM_RET_CODE_FAILED 5
+
+struct LVMShell {
+    GPid pid;
+    /* the shell's run as logged by bd_utils_spawn_with_fds() */
+    guint64 task_id;
+    gint64 start_time;
+    gint in_fd;
+    gint out_fd;
+    gint err_fd;
+    gint report_fd;
+};
+
+static volatile gint shell_enabled = 0;
+static GMutex shell_lock;
+static LVMShell *shell = NULL;
+
+static void shell_stop (LVMShell *sh) {
+    gint status = 0;
+    gint exit_code = -1;
+    pid_t ret = 0;
+    guint i = 0;
+
+    /* the shell exits once its input is closed, closing the outputs makes
+       sure it doesn't get stuck writing to them */
+    close (sh->in_fd);
+    close (sh->out_fd);
+    close (sh->err_fd);
+    close (sh->report_fd);
+
+    for (i = 0; i < LVM_SHELL_EXIT_TIMEOUT / 10; i++) {
+        ret = waitpid (sh->pid, &status, WNOHANG);
+        if (ret != 0)
+            break;
+        g_usleep (10 * G_TIME_SPAN_MILLISECOND);
+    }
+    if (ret == 0) {
+        kill (sh->pid, SIGKILL);
+        ret = waitpid (sh->pid, &status, 0);
+    }
+    if (ret > 0 && WIFEXITED (status))
+        exit_code = WEXITSTATUS (status);
+    bd_utils_exec_log_done (sh->task_id, "lvm", sh->start_time, exit_code, 0);
+
+    bd_utils_log_format (BD_UTILS_LOG_DEBUG, "Stopped lvm shell [%d]", sh->pid);
+    g_free (sh);
+}
+
+static gboolean shell_alive (LVMShell *sh) {
+    gint status = 0;
+
+    return waitpid (sh->pid, &status, WNOHANG) == 0;
+}
+
+/**
+ * shell_read_response: (skip)
+ * @sh: the shell to read the response from
+ * @report: (nullable): place to append the report output to
+ * @err: (nullable): place to append the standard error output to
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Reads the outputs of @sh until the prompt appears on its standard output.
+ * The shell writes the report and error output of a command before printing
+ * the prompt so the rest of them is already waiting in the pipes at that point.
+ *
+ * Returns: whether the response was successfully read or not
+ */
+static gboolean shell_read_response (LVMShell *sh, GString *report, GString *err, GError **error) {
+    struct pollfd fds[3];
+    GString *targets[3];
+    GString *out = g_string_new (NULL);
+    g_autofree gchar *buf = g_new (gchar, LVM_SHELL_BUF_SIZE);
+    guint64 timeout = bd_utils_get_exec_timeout_thread ();
+    gint64 deadline = 0;
+    gint poll_timeout = -1;
+    gboolean prompt = FALSE;
+    gssize n_read = 0;
+    gint ret = 0;
+    guint i = 0;
+
+    if (timeout > 0)
+        deadline = g_get_monotonic_time () + (gint64) timeout * G_TIME_SPAN_MILLISECOND;
+
+    fds[0].fd = sh->out_fd;
+    fds[1].fd = sh->report_fd;
+    fds[2].fd = sh->err_fd;
+    targets[0] = out;
+    targets[1] = report;
+    targets[2] = err;
+    for (i = 0; i < 3; i++)
+        fds[i].events = POLLIN;
+
+    while (!prompt) {
+        if (deadline > 0) {
+            poll_timeout = (gint) ((deadline - g_get_monotonic_time ()) / G_TIME_SPAN_MILLISECOND);
+            if (poll_timeout < 0)
+                poll_timeout = 0;
+        }
+
+        ret = poll (fds, 3, poll_timeout);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Failed to read output of the lvm shell: %s", g_strerror (errno));
+            g_string_free (out, TRUE);
+            return FALSE;
+        } else if (ret == 0) {
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_TIMEOUT,
+                         "The lvm shell didn't finish the command within %"G_GUINT64_FORMAT" ms", timeout);
+            g_string_free (out, TRUE);
+            return FALSE;
+        }
+
+        for (i = 0; i < 3; i++) {
+            if (fds[i].fd < 0 || !(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            n_read = read (fds[i].fd, buf, LVM_SHELL_BUF_SIZE);
+            if (n_read < 0 && (errno == EINTR || errno == EAGAIN))
+                continue;
+            if (n_read <= 0) {
+                if (i == 0) {
+                    g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                                 "The lvm shell exited unexpectedly");
+                    g_string_free (out, TRUE);
+                    return FALSE;
+                }
+                /* negative FDs are ignored by poll() */
+                fds[i].fd = -1;
+                continue;
+            }
+            if (targets[i])
+                g_string_append_len (targets[i], buf, n_read);
+        }
+
+        prompt = g_str_has_suffix (out->str, LVM_SHELL_PROMPT);
+    }
+    g_string_free (out, TRUE);
+
+    /* the FDs are non-blocking, just read whatever is left */
+    for (i = 1; i < 3; i++) {
+        while (fds[i].fd >= 0 && (n_read = read (fds[i].fd, buf, LVM_SHELL_BUF_SIZE)) != 0) {
+            if (n_read < 0) {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            if (targets[i])
+                g_string_append_len (targets[i], buf, n_read);
+        }
+    }
+
+    return TRUE;
+}
+
+static void _close_pipe (gint fds[2]) {
+    if (fds[0] >= 0)
+        close (fds[0]);
+    if (fds[1] >= 0)
+        close (fds[1]);
+}
+
+static LVMShell* shell_start (GError **error) {
+    gint in_sock[2] = {-1, -1};
+    gint out_pipe[2] = {-1, -1};
+    gint err_pipe[2] = {-1, -1};
+    gint report_pipe[2] = {-1, -1};
+    const gchar *argv[] = {"lvm", "shell", NULL};
+    g_autofree gchar *report_fd_var = NULL;
+    const gchar *env_vars[2] = {NULL, NULL};
+    gint child_fds[LVM_SHELL_REPORT_FD + 1];
+    GPid pid = 0;
+    guint64 task_id = 0;
+    gint64 start_time = 0;
+    gboolean success = FALSE;
+    gint ret = 0;
+    LVMShell *sh = NULL;
+
+    /* the input is a socket so that writing to a dead shell can use MSG_NOSIGNAL
+       instead of getting us killed by SIGPIPE */
+    if (socketpair (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, in_sock) != 0 ||
+        pipe2 (out_pipe, O_CLOEXEC) != 0 || pipe2 (err_pipe, O_CLOEXEC) != 0 ||
+        pipe2 (report_pipe, O_CLOEXEC) != 0) {
+        ret = errno;
+        _close_pipe (in_sock);
+        _close_pipe (out_pipe);
+        _close_pipe (err_pipe);
+        _close_pipe (report_pipe);
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Failed to create pipes for the lvm shell: %s", g_strerror (ret));
+        return NULL;
+    }
+
+    child_fds[STDIN_FILENO] = in_sock[1];
+    child_fds[STDOUT_FILENO] = out_pipe[1];
+    child_fds[STDERR_FILENO] = err_pipe[1];
+    child_fds[LVM_SHELL_REPORT_FD] = report_pipe[1];
+
+    report_fd_var = g_strdup_printf ("LVM_REPORT_FD=%d", LVM_SHELL_REPORT_FD);
+    env_vars[0] = report_fd_var;
+
+    success = bd_utils_spawn_with_fds (argv, env_vars, child_fds, LVM_SHELL_REPORT_FD + 1, FALSE,
+                                       &pid, &task_id, &start_time, error);
+
+    /* the child ends are not needed in this process */
+    close (in_sock[1]);
+    close (out_pipe[1]);
+    close (err_pipe[1]);
+    close (report_pipe[1]);
+
+    if (!success) {
+        close (in_sock[0]);
+        close (out_pipe[0]);
+        close (err_pipe[0]);
+        close (report_pipe[0]);
+        g_prefix_error (error, "Failed to start the lvm shell: ");
+        return NULL;
+    }
+
+    sh = g_new0 (LVMShell, 1);
+    sh->pid = pid;
+    sh->task_id = task_id;
+    sh->start_time = start_time;
+    sh->in_fd = in_sock[0];
+    sh->out_fd = out_pipe[0];
+    sh->err_fd = err_pipe[0];
+    sh->report_fd = report_pipe[0];
+    fcntl (sh->out_fd, F_SETFL, fcntl (sh->out_fd, F_GETFL) | O_NONBLOCK);
+    fcntl (sh->err_fd, F_SETFL, fcntl (sh->err_fd, F_GETFL) | O_NONBLOCK);
+    fcntl (sh->report_fd, F_SETFL, fcntl (sh->report_fd, F_GETFL) | O_NONBLOCK);
+
+    /* wait for the first prompt */
+    if (!shell_read_response (sh, NULL, NULL, error)) {
+        g_prefix_error (error, "Failed to start the lvm shell: ");
+        shell_stop (sh);
+        return NULL;
+    }
+
+    bd_utils_log_format (BD_UTILS_LOG_DEBUG, "Started lvm shell [%d]", pid);
+    return sh;
+}
+
+static gboolean shell_write_line (LVMShell *sh, const gchar *line, GError **error) {
+    gsize len = strlen (line);
+    gsize written = 0;
+    gssize ret = 0;
+
+    while (written < len) {
+        ret = send (sh->in_fd, line + written, len - written, MSG_NOSIGNAL);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Failed to pass the command to the lvm shell: %s", g_strerror (errno));
+            return FALSE;
+        }
+        written += ret;
+    }
+
+    return TRUE;
+}
+
+/* lvm shell splits the command line on whitespace and only supports quoting
+   whole arguments (with ' or ") without any escaping */
+static gchar* shell_quote_arg (const gchar *arg) {
+    if (*arg != '\0' && !strpbrk (arg, " \t\n\v\f\r'\"#"))
+        return g_strdup (arg);
+    if (strchr (arg, '\n'))
+        return NULL;
+    if (!strchr (arg, '\''))
+        return g_strdup_printf ("'%s'", arg);
+    if (!strchr (arg, '"'))
+        return g_strdup_printf ("\"%s\"", arg);
+
+    return NULL;
+}
+
+static const gchar* shell_get_report_format (const gchar **argv, const BDExtraArg **extra) {
+    const BDExtraArg **extra_p = NULL;
+    const gchar **arg_p = NULL;
+
+    for (arg_p = argv; *arg_p; arg_p++) {
+        if (g_strcmp0 (*arg_p, "--reportformat") == 0)
+            return *(arg_p + 1);
+        if (g_str_has_prefix (*arg_p, "--reportformat="))
+            return *arg_p + strlen ("--reportformat=");
+    }
+    for (extra_p = extra; extra_p && *extra_p; extra_p++) {
+        if (g_strcmp0 ((*extra_p)->opt, "--reportformat") == 0)
+            return (*extra_p)->val;
+    }
+
+    return NULL;
+}
+
+/**
+ * shell_build_line: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ *
+ * Returns: (transfer full): command line for the lvm shell (ending with a newline)
+ *                           or %NULL if @argv and @extra cannot be passed to the shell
+ */
+static gchar* shell_build_line (const gchar **argv, const BDExtraArg **extra) {
+    GPtrArray *args = g_ptr_array_new_with_free_func (g_free);
+    const BDExtraArg **extra_p = NULL;
+    const gchar **arg_p = NULL;
+    gchar *quoted = NULL;
+    gchar *line = NULL;
+    gchar *ret = NULL;
+
+    /* skip "lvm" */
+    for (arg_p = argv + 1; *arg_p; arg_p++) {
+        quoted = shell_quote_arg (*arg_p);
+        if (!quoted) {
+            g_ptr_array_free (args, TRUE);
+            return NULL;
+        }
+        g_ptr_array_add (args, quoted);
+    }
+    for (extra_p = extra; extra_p && *extra_p; extra_p++) {
+        if ((*extra_p)->opt && (g_strcmp0 ((*extra_p)->opt, "") != 0)) {
+            quoted = shell_quote_arg ((*extra_p)->opt);
+            if (!quoted) {
+                g_ptr_array_free (args, TRUE);
+                return NULL;
+            }
+            g_ptr_array_add (args, quoted);
+        }
+        if ((*extra_p)->val && (g_strcmp0 ((*extra_p)->val, "") != 0)) {
+            quoted = shell_quote_arg ((*extra_p)->val);
+            if (!quoted) {
+                g_ptr_array_free (args, TRUE);
+                return NULL;
+            }
+            g_ptr_array_add (args, quoted);
+        }
+    }
+
+    /* the command log (including the return code) is only reported together
+       with the other reports in the JSON format */
+    if (!shell_get_report_format (argv, extra)) {
+        g_ptr_array_add (args, g_strdup ("--reportformat"));
+        g_ptr_array_add (args, g_strdup ("json_std"));
+    }
+
+    if (args->len >= LVM_SHELL_MAX_ARGS) {
+        g_ptr_array_free (args, TRUE);
+        return NULL;
+    }
+
+    g_ptr_array_add (args, NULL);
+    line = g_strjoinv (" ", (gchar **) args->pdata);
+    ret = g_strconcat (line, "\n", NULL);
+    g_ptr_array_free (args, TRUE);
+    g_free (line);
+
+    return ret;
+}
+
+/**
+ * shell_get_ret_code: (skip)
+ * @report: JSON report (including the command log) from the shell
+ * @messages: (out): error messages from the command log (if any)
+ *
+ * Returns: return code of the command from the command log or -1 if it
+ *          couldn't be determined
+ */
+static gint shell_get_ret_code (const gchar *report, gchar **messages) {
+    JsonParser *parser = NULL;
+    GString *msgs = NULL;
+    JsonNode *root = NULL;
+    JsonArray *log = NULL;
+    JsonObject *entry = NULL;
+    JsonNode *node = NULL;
+    gint ret_code = -1;
+    guint len = 0;
+    guint i = 0;
+
+    *messages = NULL;
+
+    parser = json_parser_new ();
+    if (!json_parser_load_from_data (parser, report, -1, NULL)) {
+        g_object_unref (parser);
+        return -1;
+    }
+
+    root = json_parser_get_root (parser);
+    if (!root || !JSON_NODE_HOLDS_OBJECT (root) || !json_object_has_member (json_node_get_object (root), "log")) {
+        g_object_unref (parser);
+        return -1;
+    }
+
+    msgs = g_string_new (NULL);
+    log = json_object_get_array_member (json_node_get_object (root), "log");
+    len = log ? json_array_get_length (log) : 0;
+    for (i = 0; i < len; i++) {
+        entry = json_array_get_object_element (log, i);
+        if (!entry)
+            continue;
+        if (g_strcmp0 (json_object_get_string_member_with_default (entry, "log_type", NULL), "error") == 0) {
+            if (msgs->len > 0)
+                g_string_append_c (msgs, '\n');
+            g_string_append (msgs, json_object_get_string_member_with_default (entry, "log_message", ""));
+        }
+
+        /* the last entry has the return code of the whole command, "json_std"
+           reports it as a number, "json" as a string */
+        node = json_object_get_member (entry, "log_ret_code");
+        if (node && json_node_get_value_type (node) == G_TYPE_STRING)
+            ret_code = atoi (json_node_get_string (node));
+        else if (node)
+            ret_code = (gint) json_node_get_int (node);
+    }
+
+    *messages = g_string_free (msgs, msgs->len == 0);
+    g_object_unref (parser);
+
+    return ret_code;
+}
+
+/**
+ * lvm_shell_set_enabled: (skip)
+ * @enabled: whether the commands should be passed to a persistent lvm shell or not
+ *
+ * The shell itself is started lazily by the first command that uses it (and
+ * restarted the same way if it dies). Disabling stops the running shell.
+ */
+void lvm_shell_set_enabled (gboolean enabled) {
+    g_atomic_int_set (&shell_enabled, enabled ? 1 : 0);
+
+    if (!enabled)
+        lvm_shell_stop ();
+}
+
+/**
+ * lvm_shell_stop: (skip)
+ *
+ * Stops the running shell (if any). If the shell mode is enabled, a new shell
+ * is started by the next command that uses it.
+ */
+void lvm_shell_stop (void) {
+    g_mutex_lock (&shell_lock);
+    if (shell) {
+        shell_stop (shell);
+        shell = NULL;
+    }
+    g_mutex_unlock (&shell_lock);
+}
+
+/**
+ * lvm_shell_get_enabled: (skip)
+ *
+ * Returns: whether the commands are passed to a persistent lvm shell or not
+ */
+gboolean lvm_shell_get_enabled (void) {
+    return g_atomic_int_get (&shell_enabled) == 1;
+}
+
+/**
+ * lvm_shell_usable: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @capture: whether the report (output) of the command is needed
+ *
+ * Returns: whether @argv and @extra should be run by lvm_shell_run() or not,
+ *          if %FALSE, the command needs to be run as a separate process
+ */
+gboolean lvm_shell_usable (const gchar **argv, const BDExtraArg **extra, gboolean capture) {
+    if (!lvm_shell_get_enabled ())
+        return FALSE;
+
+    return lvm_shell_can_run (argv, extra, capture);
+}
+
+/**
+ * lvm_shell_can_run: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @capture: whether the report (output) of the command is needed
+ *
+ * Same as lvm_shell_usable(), but regardless of the shell mode being enabled
+ * or not (for batches of commands run with lvm_shell_run_private()).
+ *
+ * Returns: whether @argv and @extra can be run by lvm_shell_run() or not
+ */
+gboolean lvm_shell_can_run (const gchar **argv, const BDExtraArg **extra, gboolean capture) {
+    g_autofree gchar *line = NULL;
+    const gchar *format = NULL;
+
+    /* only reports go to the report FD, other output is mixed with the prompt */
+    if (capture) {
+        format = shell_get_report_format (argv, extra);
+        if (!format || !g_str_has_prefix (format, "json"))
+            return FALSE;
+    }
+
+    line = shell_build_line (argv, extra);
+    return line != NULL;
+}
+
+/**
+ * shell_pass_command: (skip)
+ * @sh: (inout): the shell to pass the command to (started if %NULL or dead)
+ * @line: command line for the shell
+ * @report_data: place to append the report output of the command to
+ * @err_data: place to append the standard error output of the command to
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * If the shell dies before it gets the command, it is restarted and the
+ * command is passed to the new one. @sh is set to %NULL if there is no usable
+ * shell after the command.
+ *
+ * Returns: whether the command was passed to the shell and its response read or not
+ */
+static gboolean shell_pass_command (LVMShell **sh, const gchar *line, GString *report_data, GString *err_data, GError **error) {
+    GError *l_error = NULL;
+    guint attempt = 0;
+
+    for (attempt = 0; attempt < 2; attempt++) {
+        g_clear_error (&l_error);
+        if (*sh && !shell_alive (*sh)) {
+            shell_stop (*sh);
+            *sh = NULL;
+        }
+        if (!*sh) {
+            *sh = shell_start (error);
+            if (!*sh)
+                return FALSE;
+        }
+        if (shell_write_line (*sh, line, &l_error))
+            break;
+        shell_stop (*sh);
+        *sh = NULL;
+    }
+    if (!*sh) {
+        g_propagate_error (error, l_error);
+        return FALSE;
+    }
+
+    if (!shell_read_response (*sh, report_data, err_data, error)) {
+        /* state of the shell is unknown, a new one is started for the next command */
+        shell_stop (*sh);
+        *sh = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+/**
+ * shell_run: (skip)
+ * @sh: (inout): the shell to run the command in (started if %NULL or dead)
+ * @lock: (nullable): lock protecting @sh (if any)
+ * @busy: (out) (optional): place to store whether the command was not run
+ *        because @lock was held by another command, if %NULL, the command
+ *        waits for @lock instead
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @report: (out) (optional): place to store the JSON report of the command to
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the command was successfully run or not
+ */
+static gboolean shell_run (LVMShell **sh, GMutex *lock, gboolean *busy, const gchar **argv,
+                           const BDExtraArg **extra, gchar **report, GError **error) {
+    g_autofree gchar *line = NULL;
+    g_autofree gchar *messages = NULL;
+    GString *report_data = NULL;
+    GString *err_data = NULL;
+    guint64 task_id = 0;
+    gint64 start_time = 0;
+    gint ret_code = 0;
+    gint exit_code = 0;
+    gboolean success = FALSE;
+
+    line = shell_build_line (argv, extra);
+    if (!line) {
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "The command cannot be passed to the lvm shell");
+        return FALSE;
+    }
+
+    if (busy)
+        *busy = FALSE;
+    if (lock && busy) {
+        if (!g_mutex_trylock (lock)) {
+            *busy = TRUE;
+            return FALSE;
+        }
+    } else if (lock)
+        g_mutex_lock (lock);
+
+    report_data = g_string_new (NULL);
+    err_data = g_string_new (NULL);
+
+    task_id = bd_utils_exec_log_running (argv, &start_time);
+    bd_utils_log_format (BD_UTILS_LOG_INFO, "[%"G_GUINT64_FORMAT"] Running in lvm shell: %.*s",
+                         task_id, (gint) strlen (line) - 1, line);
+
+    success = shell_pass_command (sh, line, report_data, err_data, error);
+
+    if (lock)
+        g_mutex_unlock (lock);
+
+    if (!success) {
+        bd_utils_exec_log_done (task_id, argv[0], start_time, -1, report_data->len + err_data->len);
+        g_string_free (report_data, TRUE);
+        g_string_free (err_data, TRUE);
+        return FALSE;
+    }
+
+    ret_code = shell_get_ret_code (report_data->str, &messages);
+    if (ret_code < 0)
+        /* no command log, only errors are reported on the standard error output then */
+        ret_code = err_data->len > 0 ? LVM_RET_CODE_FAILED : LVM_RET_CODE_OK;
+    exit_code = ret_code == LVM_RET_CODE_OK ? 0 : ret_code;
+
+    bd_utils_exec_log_done (task_id, argv[0], start_time, exit_code, report_data->len + err_data->len);
+
+    if (exit_code != 0) {
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Process reported exit code %d: %s", exit_code,
+                     messages ? messages : err_data->str);
+        g_string_free (report_data, TRUE);
+        g_string_free (err_data, TRUE);
+        return FALSE;
+    }
+
+    if (report && report_data->len == 0) {
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_NOOUT,
+                     "Process didn't provide any data on standard output. "
+                     "Error output: %s", err_data->str);
+        g_string_free (report_data, TRUE);
+        g_string_free (err_data, TRUE);
+        return FALSE;
+    }
+
+    if (report)
+        *report = g_string_free (report_data, FALSE);
+    else
+        g_string_free (report_data, TRUE);
+    g_string_free (err_data, TRUE);
+
+    return TRUE;
+}
+
+/**
+ * lvm_shell_run: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @report: (out) (optional): place to store the JSON report of the command to
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Runs @argv with @extra in the persistent lvm shell, starting the shell first
+ * if it's not running. If the shell dies before it gets the command, it is
+ * restarted and the command is passed to the new one.
+ *
+ * Returns: whether the command was successfully run or not
+ */
+gboolean lvm_shell_run (const gchar **argv, const BDExtraArg **extra, gchar **report, GError **error) {
+    return shell_run (&shell, &shell_lock, NULL, argv, extra, report, error);
+}
+
+/**
+ * lvm_shell_run_report: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @report: (out): place to store the JSON report of the command to
+ * @busy: (out): place to store whether the shell was busy running another command
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as lvm_shell_run(), but for read-only reports that don't need to wait
+ * for the shell. If the shell is running another command, the report is not
+ * run, %FALSE is returned with @busy set to %TRUE (and @error not set) and the
+ * caller is expected to run it as a separate process instead.
+ *
+ * Returns: whether the command was successfully run or not
+ */
+gboolean lvm_shell_run_report (const gchar **argv, const BDExtraArg **extra, gchar **report, gboolean *busy, GError **error) {
+    return shell_run (&shell, &shell_lock, busy, argv, extra, report, error);
+}
+
+/**
+ * lvm_shell_run_private: (skip)
+ * @sh: (inout): private shell to run the command in, started if %NULL
+ * @argv: (array zero-terminated=1): the argv array for the call (including "lvm")
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @report: (out) (optional): place to store the JSON report of the command to
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as lvm_shell_run(), but runs the command in a shell owned by the caller
+ * (e.g. for a batch of commands) instead of the shared one. The caller is
+ * responsible for not using @sh from multiple threads at the same time and for
+ * stopping it with lvm_shell_free().
+ *
+ * Returns: whether the command was successfully run or not
+ */
+gboolean lvm_shell_run_private (LVMShell **sh, const gchar **argv, const BDExtraArg **extra, gchar **report, GError **error) {
+    return shell_run (sh, NULL, NULL, argv, extra, report, error);
+}
+
+/**
+ * lvm_shell_free: (skip)
+ * @sh: (nullable): private shell to stop
+ *
+ * Stops the shell started by lvm_shell_run_private() (if any).
+ */
+void lvm_shell_free (LVMShell *sh) {
+    if (sh)
+        shell_stop (sh);
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2025 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <blockdev/utils.h>
+
+#ifndef BD_LVM_SHELL
+#define BD_LVM_SHELL
+
+typedef struct LVMShell LVMShell;
+
+void lvm_shell_set_enabled (gboolean enabled);
+gboolean lvm_shell_get_enabled (void);
+void lvm_shell_stop (void);
+
+gboolean lvm_shell_usable (const gchar **argv, const BDExtraArg **extra, gboolean capture);
+gboolean lvm_shell_can_run (const gchar **argv, const BDExtraArg **extra, gboolean capture);
+gboolean lvm_shell_run (const gchar **argv, const BDExtraArg **extra, gchar **report, GError **error);
+gboolean lvm_shell_run_report (const gchar **argv, const BDExtraArg **extra, gchar **report, gboolean *busy, GError **error);
+
+gboolean lvm_shell_run_private (LVMShell **sh, const gchar **argv, const BDExtraArg **extra, gchar **report, GError **error);
+void lvm_shell_free (LVMShell *sh);
+
+#endif  /* BD_LVM_SHELL */
@@ -17,16 +17,23 @@
  * Author: Vratislav Podzimek <vpodzime@redhat.com>
  */
 
+#define _GNU_SOURCE
 #include <glib.h>
 #include <math.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
 #include <blockdev/utils.h>
 #include <libdevmapper.h>
 #include <json-glib/json-glib.h>
 
 #include "lvm.h"
 #include "lvm-private.h"
+#include "lvm-shell.h"
 #include "check_deps.h"
 #include "dm_logging.h"
 #include "vdo_stats.h"
@@ -112,6 +119,8 @@ gboolean bd_lvm_init (void) {
  *
  */
 void bd_lvm_close (void) {
+    lvm_shell_set_enabled (FALSE);
+
     dm_log_with_errno_init (NULL);
     dm_log_init_verbose (0);
 
@@ -122,6 +131,20 @@ void bd_lvm_close (void) {
     g_atomic_int_set (&avail_module_deps, 0);
 }
 
+/**
+ * bd_lvm_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_lvm_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+    check_features (&avail_features, ALL_DEPS_MASK (FEATURES_LAST), features, FEATURES_LAST, &deps_check_lock, NULL);
+    check_module_deps (&avail_module_deps, ALL_DEPS_MASK (MODULE_DEPS_LAST), module_deps, MODULE_DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_lvm_is_tech_avail:
  * @tech: the queried tech
@@ -164,19 +187,107 @@ gboolean bd_lvm_is_tech_avail (BDLVMTech tech, guint64 mode, GError **error) {
     }
 }
 
-static gboolean call_lvm_and_report_error (const gchar **args, const BDExtraArg **extra, gboolean lock_config, GError **error) {
-    gboolean success = FALSE;
-    guint i = 0;
-    guint args_length = g_strv_length ((gchar **) args);
-    g_autofree gchar *config_arg = NULL;
-    g_autofree gchar *devices_arg = NULL;
+/**
+ * bd_lvm_set_shell_mode:
+ * @enabled: whether to run LVM commands in a persistent `lvm shell` process or not
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Note: In the shell mode, commands (and JSON reports) are passed to a single
+ *       long-running `lvm shell` process instead of running a new `lvm` process
+ *       for every operation. The shell is started on the first use and restarted
+ *       automatically if it dies. Commands that cannot be passed to the shell
+ *       (or need non-JSON output) still run as separate processes.
+ *
+ * Returns: whether the shell mode was successfully enabled/disabled or not
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_set_shell_mode (gboolean enabled, GError **error) {
+    if (enabled && !check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+        return FALSE;
 
-    if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+    lvm_shell_set_enabled (enabled);
+    return TRUE;
+}
+
+/**
+ * bd_lvm_get_shell_mode:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether LVM commands are run in a persistent `lvm shell` process or not,
+ *          see %bd_lvm_set_shell_mode for details
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_get_shell_mode (GError **error G_GNUC_UNUSED) {
+    return lvm_shell_get_enabled ();
+}
+
+/**
+ * bd_lvm_set_dbus_cache:
+ * @enabled: whether to mirror the lvmdbusd objects in memory or not
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Note: The cache only makes sense with lvmdbusd so only disabling it is
+ *       supported by this plugin.
+ *
+ * Returns: whether the cache was successfully enabled/disabled or not
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_set_dbus_cache (gboolean enabled, GError **error) {
+    if (enabled) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_NOT_SUPPORTED,
+                             "The DBus object cache is only supported by the LVM DBus plugin");
         return FALSE;
+    }
 
-    /* don't allow global config string changes during the run */
-    if (lock_config)
-        g_mutex_lock (&global_config_lock);
+    return TRUE;
+}
+
+/**
+ * bd_lvm_get_dbus_cache:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the lvmdbusd objects are mirrored in memory or not,
+ *          always %FALSE with this plugin, see %bd_lvm_set_dbus_cache for details
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+gboolean bd_lvm_get_dbus_cache (GError **error G_GNUC_UNUSED) {
+    return FALSE;
+}
+
+/**
+ * bd_lvm_get_dbus_cache_stats:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: (transfer full): statistics of the lvmdbusd objects cache, always
+ *                           empty (and disabled) with this plugin
+ *
+ * Tech category: %BD_LVM_TECH_GLOB_CONF no mode (it is ignored)
+ */
+BDLVMDBusCacheStats* bd_lvm_get_dbus_cache_stats (GError **error G_GNUC_UNUSED) {
+    return g_new0 (BDLVMDBusCacheStats, 1);
+}
+
+/**
+ * build_lvm_argv:
+ * @args: LVM command arguments
+ * @lock_config: whether to lock %global_config_lock or not (if %FALSE is given, caller is responsible
+ *               for holding the lock for this call)
+ * @config_arg: (out): place to store the "--config" argument (if any, to be freed by the caller)
+ * @devices_arg: (out): place to store the "--devices" argument (if any, to be freed by the caller)
+ *
+ * The global config and devices are only copied into the arguments under the
+ * lock, the lock is not held while the LVM command is running so that
+ * independent commands can run in parallel.
+ *
+ * Returns: (transfer container): argv to run @args with "lvm" and the global config
+ */
+static const gchar** build_lvm_argv (const gchar **args, gboolean lock_config, gchar **config_arg, gchar **devices_arg) {
+    guint i = 0;
+    guint args_length = g_strv_length ((gchar **) args);
 
     /* allocate enough space for the args plus "lvm", "--config", "--devices" and NULL */
     const gchar **argv = g_new0 (const gchar*, args_length + 4);
@@ -185,19 +296,40 @@ static gboolean call_lvm_and_report_error (const gchar **args, const BDExtraArg
     argv[0] = "lvm";
     for (i=0; i < args_length; i++)
         argv[i+1] = args[i];
+
+    /* take a snapshot of the global config */
+    if (lock_config)
+        g_mutex_lock (&global_config_lock);
     if (global_config_str) {
-        config_arg = g_strdup_printf ("--config=%s", global_config_str);
-        argv[++args_length] = config_arg;
+        *config_arg = g_strdup_printf ("--config=%s", global_config_str);
+        argv[++args_length] = *config_arg;
     }
     if (global_devices_str) {
-        devices_arg = g_strdup_printf ("--devices=%s", global_devices_str);
-        argv[++args_length] = devices_arg;
+        *devices_arg = g_strdup_printf ("--devices=%s", global_devices_str);
+        argv[++args_length] = *devices_arg;
     }
-    argv[++args_length] = NULL;
-
-    success = bd_utils_exec_and_report_error (argv, extra, error);
     if (lock_config)
         g_mutex_unlock (&global_config_lock);
+    argv[++args_length] = NULL;
+
+    return argv;
+}
+
+static gboolean call_lvm_and_report_error (const gchar **args, const BDExtraArg **extra, gboolean lock_config, GError **error) {
+    gboolean success = FALSE;
+    const gchar **argv = NULL;
+    g_autofree gchar *config_arg = NULL;
+    g_autofree gchar *devices_arg = NULL;
+
+    if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+        return FALSE;
+
+    argv = build_lvm_argv (args, lock_config, &config_arg, &devices_arg);
+
+    if (lvm_shell_usable (argv, extra, FALSE))
+        success = lvm_shell_run (argv, extra, NULL, error);
+    else
+        success = bd_utils_exec_and_report_error (argv, extra, error);
     g_free (argv);
 
     return success;
@@ -205,36 +337,24 @@ static gboolean call_lvm_and_report_error (const gchar **args, const BDExtraArg
 
 static gboolean call_lvm_and_capture_output (const gchar **args, const BDExtraArg **extra, gchar **output, GError **error) {
     gboolean success = FALSE;
-    guint i = 0;
-    guint args_length = g_strv_length ((gchar **) args);
+    const gchar **argv = NULL;
     g_autofree gchar *config_arg = NULL;
     g_autofree gchar *devices_arg = NULL;
+    gboolean use_shell = FALSE;
+    gboolean shell_busy = FALSE;
 
     if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
         return FALSE;
 
-    /* don't allow global config string changes during the run */
-    g_mutex_lock (&global_config_lock);
-
-    /* allocate enough space for the args plus "lvm", "--config", "--devices" and NULL */
-    const gchar **argv = g_new0 (const gchar*, args_length + 4);
-
-    /* construct argv from args with "lvm" prepended */
-    argv[0] = "lvm";
-    for (i=0; i < args_length; i++)
-        argv[i+1] = args[i];
-    if (global_config_str) {
-        config_arg = g_strdup_printf ("--config=%s", global_config_str);
-        argv[++args_length] = config_arg;
-    }
-    if (global_devices_str) {
-        devices_arg = g_strdup_printf ("--devices=%s", global_devices_str);
-        argv[++args_length] = devices_arg;
-    }
-    argv[++args_length] = NULL;
+    argv = build_lvm_argv (args, TRUE, &config_arg, &devices_arg);
 
-    success = bd_utils_exec_and_capture_output (argv, extra, output, error);
-    g_mutex_unlock (&global_config_lock);
+    /* reports don't wait for the shell running another command, they are run
+       as separate processes then */
+    use_shell = lvm_shell_usable (argv, extra, TRUE);
+    if (use_shell)
+        success = lvm_shell_run_report (argv, extra, output, &shell_busy, error);
+    if (!use_shell || shell_busy)
+        success = bd_utils_exec_and_capture_output (argv, extra, output, error);
     g_free (argv);
 
     return success;
@@ -242,39 +362,433 @@ static gboolean call_lvm_and_capture_output (const gchar **args, const BDExtraAr
 
 static gboolean call_lvm_and_report_progress (const gchar **args, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, gint *proc_status, GError **error) {
     gboolean success = FALSE;
-    guint i = 0;
-    guint args_length = g_strv_length ((gchar **) args);
+    const gchar **argv = NULL;
     g_autofree gchar *config_arg = NULL;
     g_autofree gchar *devices_arg = NULL;
 
     if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
         return FALSE;
 
-    /* don't allow global config string changes during the run */
-    g_mutex_lock (&global_config_lock);
+    argv = build_lvm_argv (args, TRUE, &config_arg, &devices_arg);
 
-    /* allocate enough space for the args plus "lvm", "--config", "--devices" and NULL */
-    const gchar **argv = g_new0 (const gchar*, args_length + 4);
+    success = bd_utils_exec_and_report_progress (argv, extra, prog_extract, proc_status, error);
+    g_free (argv);
 
-    /* construct argv from args with "lvm" prepended */
-    argv[0] = "lvm";
-    for (i=0; i < args_length; i++)
-        argv[i+1] = args[i];
-    if (global_config_str) {
-        config_arg = g_strdup_printf ("--config=%s", global_config_str);
-        argv[++args_length] = config_arg;
+    return success;
+}
+
+/* maximum time (in milliseconds) spent in a single poll() waiting for jobs */
+#define LVM_JOB_POLL_INTERVAL 500
+/* time (in milliseconds) a timed out job gets to exit after SIGTERM before it's killed */
+#define LVM_JOB_KILL_GRACE_PERIOD 5000
+
+/* lvm process running in the background, see start_lvm_job() */
+typedef struct {
+    /* jobs can be shared between threads, protects the FDs and the state below */
+    GMutex lock;
+    gchar *cmd;
+    gchar **cancel_args;        /* LVM command aborting the operation or NULL to interrupt the process */
+    GPid pid;
+    gint out_fd;
+    gint err_fd;
+    GString *out_line;          /* incomplete last line of the output */
+    GString *err_data;
+    BDUtilsProgExtract prog_extract;
+    guint8 progress;
+    guint64 task_id;
+    gint64 start_time;
+    gsize output_size;
+    guint64 prog_id;
+    guint64 timeout;            /* exec timeout of the thread that started the job */
+    gint64 deadline;            /* when to send kill_signal to the process, 0 for never */
+    gint kill_signal;
+    gboolean timed_out;
+    gboolean finished;
+    GError *error;
+} LVMCLIJob;
+
+/* called with job->lock held, the process is in its own process group and may
+   have started other processes (e.g. lvmpolld or dmeventd requests) */
+static gint lvm_cli_job_signal (LVMCLIJob *job, gint sig) {
+    gint ret = 0;
+
+    ret = kill (-job->pid, sig);
+    if (ret != 0 && errno == ESRCH)
+        /* the process may have failed to become a group leader */
+        ret = kill (job->pid, sig);
+
+    return ret;
+}
+
+/* called with job->lock held, terminates the process (group) if it didn't finish
+   within the timeout and kills it if it's still running after the grace period */
+static void lvm_cli_job_check_timeout (LVMCLIJob *job) {
+    gint64 now = 0;
+
+    if (job->finished || job->deadline == 0)
+        return;
+
+    now = g_get_monotonic_time ();
+    if (now < job->deadline)
+        return;
+
+    bd_utils_log_format (BD_UTILS_LOG_WARNING, "Process %d timed out, sending signal %d to its process group",
+                         job->pid, job->kill_signal);
+    lvm_cli_job_signal (job, job->kill_signal);
+    job->timed_out = TRUE;
+    if (job->kill_signal == SIGTERM) {
+        job->kill_signal = SIGKILL;
+        job->deadline = now + LVM_JOB_KILL_GRACE_PERIOD * G_TIME_SPAN_MILLISECOND;
+    } else
+        job->deadline = 0;
+}
+
+static void lvm_cli_job_process_output (LVMCLIJob *job) {
+    gchar *line_end = NULL;
+    guint8 completion = 0;
+
+    while ((line_end = strchr (job->out_line->str, '\n'))) {
+        *line_end = '\0';
+        if (job->prog_extract && job->prog_extract (job->out_line->str, &completion)) {
+            job->progress = completion;
+            bd_utils_report_progress (job->prog_id, completion, NULL);
+        }
+        g_string_erase (job->out_line, 0, line_end - job->out_line->str + 1);
     }
-    if (global_devices_str) {
-        devices_arg = g_strdup_printf ("--devices=%s", global_devices_str);
-        argv[++args_length] = devices_arg;
+}
+
+/* called with job->lock held */
+static void lvm_cli_job_reap (LVMCLIJob *job) {
+    gint wait_status = 0;
+    gint exit_code = -1;
+    gchar *log_msg = NULL;
+
+    job->finished = TRUE;
+    if (waitpid (job->pid, &wait_status, 0) < 0) {
+        g_set_error (&(job->error), BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Failed to get the exit status of the '%s' process: %m", job->cmd);
+    } else {
+        if (WIFEXITED (wait_status))
+            exit_code = WEXITSTATUS (wait_status);
+
+        if (job->timed_out)
+            g_set_error (&(job->error), BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_TIMEOUT,
+                         "Process didn't finish within %"G_GUINT64_FORMAT" ms and was terminated", job->timeout);
+        else if (WIFSIGNALED (wait_status))
+            g_set_error_literal (&(job->error), BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                                 "Process killed with a signal");
+        else if (exit_code != 0)
+            g_set_error (&(job->error), BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Process reported exit code %d: %s", exit_code, job->err_data->str);
     }
-    argv[++args_length] = NULL;
+    g_spawn_close_pid (job->pid);
+    bd_utils_exec_log_done (job->task_id, "lvm", job->start_time, exit_code, job->output_size);
+
+    if (job->error) {
+        log_msg = g_strdup_printf ("Got error: %s", job->error->message);
+        bd_utils_log_task_status (job->task_id, log_msg);
+        bd_utils_report_finished (job->prog_id, job->error->message);
+        g_free (log_msg);
+    } else {
+        job->progress = 100;
+        bd_utils_log_task_status (job->task_id, "Done.");
+        bd_utils_report_finished (job->prog_id, "Completed");
+    }
+}
 
-    success = bd_utils_exec_and_report_progress (argv, extra, prog_extract, proc_status, error);
-    g_mutex_unlock (&global_config_lock);
+/**
+ * lvm_cli_job_read:
+ * @job: job to read the output of
+ * @fd: (inout): the @job's stdout or stderr file descriptor
+ *
+ * Reads everything available on @fd, closes it (and sets it to -1) when the
+ * process closes its end and reaps the process once both stdout and stderr
+ * are closed. Has to be called with @job's lock held.
+ */
+static void lvm_cli_job_read (LVMCLIJob *job, gint *fd) {
+    gchar buf[4096];
+    gssize n_read = 0;
+
+    while ((n_read = read (*fd, buf, sizeof (buf))) > 0 || (n_read < 0 && errno == EINTR)) {
+        if (n_read < 0)
+            continue;
+        job->output_size += n_read;
+        if (*fd == job->out_fd) {
+            g_string_append_len (job->out_line, buf, n_read);
+            lvm_cli_job_process_output (job);
+        } else
+            g_string_append_len (job->err_data, buf, n_read);
+    }
+
+    if (n_read < 0 && errno == EAGAIN)
+        /* nothing more for now */
+        return;
+
+    close (*fd);
+    *fd = -1;
+
+    if (job->out_fd < 0 && job->err_fd < 0)
+        lvm_cli_job_reap (job);
+}
+
+/**
+ * lvm_cli_jobs_wait:
+ * @jobs: (array length=n_jobs): jobs to wait for
+ * @n_jobs: number of @jobs
+ * @timeout: how long to wait (in milliseconds, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Waits for any of the @jobs to finish by polling the outputs of all their
+ * processes at once (the outputs are closed when the processes exit).
+ *
+ * Returns: index of the first finished job in @jobs or -1 if none of them
+ *          finished in @timeout or in case of error (@error is set in that case)
+ */
+static gint lvm_cli_jobs_wait (LVMCLIJob **jobs, guint n_jobs, gint timeout, GError **error) {
+    struct pollfd *fds = NULL;
+    guint *fd_jobs = NULL;
+    guint n_fds = 0;
+    gint64 deadline = -1;
+    gint poll_timeout = -1;
+    gint n_ready = 0;
+    gint ret = -1;
+    guint i = 0;
+    LVMCLIJob *job = NULL;
+
+    if (timeout >= 0)
+        deadline = g_get_monotonic_time () + (gint64) timeout * G_TIME_SPAN_MILLISECOND;
+
+    fds = g_new0 (struct pollfd, 2 * n_jobs);
+    fd_jobs = g_new0 (guint, 2 * n_jobs);
+    while (TRUE) {
+        n_fds = 0;
+        for (i=0; ret < 0 && i < n_jobs; i++) {
+            g_mutex_lock (&(jobs[i]->lock));
+            lvm_cli_job_check_timeout (jobs[i]);
+            if (jobs[i]->finished)
+                ret = i;
+            if (jobs[i]->out_fd >= 0) {
+                fds[n_fds].fd = jobs[i]->out_fd;
+                fds[n_fds].events = POLLIN;
+                fd_jobs[n_fds++] = i;
+            }
+            if (jobs[i]->err_fd >= 0) {
+                fds[n_fds].fd = jobs[i]->err_fd;
+                fds[n_fds].events = POLLIN;
+                fd_jobs[n_fds++] = i;
+            }
+            g_mutex_unlock (&(jobs[i]->lock));
+        }
+        if (ret >= 0)
+            break;
+
+        /* another thread waiting for the same job may close its FDs while we
+           are polling them and the jobs may time out, so wake up regularly to
+           notice that */
+        poll_timeout = LVM_JOB_POLL_INTERVAL;
+        if (deadline >= 0)
+            poll_timeout = (gint) MIN (poll_timeout, MAX (0, (deadline - g_get_monotonic_time ()) / G_TIME_SPAN_MILLISECOND));
+
+        n_ready = poll (fds, n_fds, poll_timeout);
+        if (n_ready < 0 && errno == EINTR)
+            continue;
+        if (n_ready < 0) {
+            g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                         "Failed to wait for the LVM processes: %m");
+            break;
+        }
+
+        for (i=0; i < n_fds; i++) {
+            if (fds[i].revents == 0)
+                continue;
+            job = jobs[fd_jobs[i]];
+            g_mutex_lock (&(job->lock));
+            /* the FD may have been closed by another thread in the meantime */
+            if (fds[i].fd == job->out_fd)
+                lvm_cli_job_read (job, &(job->out_fd));
+            else if (fds[i].fd == job->err_fd)
+                lvm_cli_job_read (job, &(job->err_fd));
+            g_mutex_unlock (&(job->lock));
+        }
+
+        if (deadline >= 0 && g_get_monotonic_time () >= deadline) {
+            /* timed out, but some of the jobs may have been finished by other threads */
+            for (i=0; ret < 0 && i < n_jobs; i++) {
+                g_mutex_lock (&(jobs[i]->lock));
+                if (jobs[i]->finished)
+                    ret = i;
+                g_mutex_unlock (&(jobs[i]->lock));
+            }
+            break;
+        }
+    }
+
+    g_free (fds);
+    g_free (fd_jobs);
+    return ret;
+}
+
+static void lvm_cli_job_free_data (LVMCLIJob *job) {
+    if (job->out_fd >= 0)
+        close (job->out_fd);
+    if (job->err_fd >= 0)
+        close (job->err_fd);
+    g_free (job->cmd);
+    g_strfreev (job->cancel_args);
+    g_string_free (job->out_line, TRUE);
+    g_string_free (job->err_data, TRUE);
+    g_clear_error (&(job->error));
+    g_mutex_clear (&(job->lock));
+    g_free (job);
+}
+
+static gpointer lvm_cli_job_reaper (gpointer user_data) {
+    LVMCLIJob *job = (LVMCLIJob *) user_data;
+
+    /* keep reading the outputs so that the process doesn't block on a full pipe */
+    lvm_cli_jobs_wait (&job, 1, -1, NULL);
+    /* we hold the last reference, no locking needed */
+    if (!job->finished)
+        /* polling failed, just wait for the process to exit */
+        lvm_cli_job_reap (job);
+
+    lvm_cli_job_free_data (job);
+    return NULL;
+}
+
+static void lvm_cli_job_free (LVMCLIJob *job) {
+    if (!job->finished) {
+        /* the process needs to be reaped, but there's no reason to block the
+           caller releasing the last reference until it finishes */
+        bd_utils_log_task_status (job->task_id, "Leaving the process running in the background");
+        g_thread_unref (g_thread_new ("lvm-job-reaper", lvm_cli_job_reaper, job));
+        return;
+    }
+
+    lvm_cli_job_free_data (job);
+}
+
+/**
+ * start_lvm_job:
+ * @args: LVM command arguments
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @lock_config: whether to lock %global_config_lock or not (if %FALSE is given, caller is responsible
+ *               for holding the lock for this call)
+ * @prog_extract: (nullable): function for extracting progress information from the output
+ * @cancel_args: (nullable) (array zero-terminated=1): LVM command arguments to cancel the
+ *                                                     operation or %NULL to interrupt the process
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Starts the LVM command in the background in a new process group. The run is
+ * logged and accounted as any other run of a utility and the exec timeout of
+ * the calling thread (if any) applies to it, the timeout is enforced while the
+ * job is being waited for (or reaped in the background).
+ *
+ * Returns: (transfer full): a handle of the running command or %NULL in case of error
+ */
+static BDLVMJob* start_lvm_job (const gchar **args, const BDExtraArg **extra, gboolean lock_config,
+                                BDUtilsProgExtract prog_extract, const gchar **cancel_args, GError **error) {
+    const gchar **argv = NULL;
+    g_autofree gchar *config_arg = NULL;
+    g_autofree gchar *devices_arg = NULL;
+    GPtrArray *all_args = NULL;
+    const BDExtraArg **extra_p = NULL;
+    const gchar **arg_p = NULL;
+    gint null_fd = -1;
+    gint out_pipe[2] = {-1, -1};
+    gint err_pipe[2] = {-1, -1};
+    gint child_fds[3];
+    LVMCLIJob *job = NULL;
+    BDLVMJob *ret = NULL;
+    gchar *log_msg = NULL;
+    gboolean success = FALSE;
+    gint err = 0;
+
+    if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+        return NULL;
+
+    /* the outputs are only read when there's something to read */
+    null_fd = open ("/dev/null", O_RDONLY | O_CLOEXEC);
+    if (null_fd < 0 || pipe2 (out_pipe, O_CLOEXEC) != 0 || pipe2 (err_pipe, O_CLOEXEC) != 0 ||
+        fcntl (out_pipe[0], F_SETFL, O_NONBLOCK) != 0 || fcntl (err_pipe[0], F_SETFL, O_NONBLOCK) != 0) {
+        err = errno;
+        if (null_fd >= 0)
+            close (null_fd);
+        for (guint i = 0; i < 2; i++) {
+            if (out_pipe[i] >= 0)
+                close (out_pipe[i]);
+            if (err_pipe[i] >= 0)
+                close (err_pipe[i]);
+        }
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                     "Failed to create pipes for the lvm process: %s", g_strerror (err));
+        return NULL;
+    }
+
+    argv = build_lvm_argv (args, lock_config, &config_arg, &devices_arg);
+
+    all_args = g_ptr_array_new ();
+    for (arg_p=argv; *arg_p; arg_p++)
+        g_ptr_array_add (all_args, (gpointer) *arg_p);
+    for (extra_p=extra; extra_p && *extra_p; extra_p++) {
+        if ((*extra_p)->opt && (g_strcmp0 ((*extra_p)->opt, "") != 0))
+            g_ptr_array_add (all_args, (*extra_p)->opt);
+        if ((*extra_p)->val && (g_strcmp0 ((*extra_p)->val, "") != 0))
+            g_ptr_array_add (all_args, (*extra_p)->val);
+    }
+    g_ptr_array_add (all_args, NULL);
     g_free (argv);
 
-    return success;
+    job = g_new0 (LVMCLIJob, 1);
+    g_mutex_init (&(job->lock));
+    job->cmd = g_strjoinv (" ", (gchar **) all_args->pdata);
+
+    child_fds[STDIN_FILENO] = null_fd;
+    child_fds[STDOUT_FILENO] = out_pipe[1];
+    child_fds[STDERR_FILENO] = err_pipe[1];
+
+    /* in a new process group so that the processes started by lvm are
+       interrupted together with it */
+    success = bd_utils_spawn_with_fds ((const gchar **) all_args->pdata, NULL, child_fds, 3, TRUE,
+                                       &(job->pid), &(job->task_id), &(job->start_time), error);
+    g_ptr_array_free (all_args, TRUE);
+
+    /* the child ends are not needed in this process */
+    close (null_fd);
+    close (out_pipe[1]);
+    close (err_pipe[1]);
+
+    if (!success) {
+        close (out_pipe[0]);
+        close (err_pipe[0]);
+        g_mutex_clear (&(job->lock));
+        g_free (job->cmd);
+        g_free (job);
+        return NULL;
+    }
+    bd_utils_log_task_status (job->task_id, "Running in the background");
+
+    job->out_fd = out_pipe[0];
+    job->err_fd = err_pipe[0];
+    job->cancel_args = g_strdupv ((gchar **) cancel_args);
+    job->out_line = g_string_new (NULL);
+    job->err_data = g_string_new (NULL);
+    job->prog_extract = prog_extract;
+    job->kill_signal = SIGTERM;
+    job->timeout = bd_utils_get_exec_timeout_thread ();
+    if (job->timeout > 0)
+        job->deadline = job->start_time + (gint64) job->timeout * G_TIME_SPAN_MILLISECOND;
+
+    log_msg = g_strdup_printf ("Started '%s'", job->cmd);
+    job->prog_id = bd_utils_report_started (log_msg);
+    g_free (log_msg);
+
+    ret = g_new0 (BDLVMJob, 1);
+    ret->ref_count = 1;
+    ret->priv = job;
+    ret->priv_free = (GDestroyNotify) lvm_cli_job_free;
+
+    return ret;
 }
 
 /**
@@ -351,6 +865,227 @@ static JsonArray* call_lvm_and_parse_json_report (const gchar **args,
     return data_array;
 }
 
+/* called for every row of a JSON report with the name of the section (e.g. "pv",
+   "vg", "lv" or "seg") the row belongs to */
+typedef void (*LVMReportRowFunc) (const gchar *section, JsonObject *row, gpointer user_data);
+
+typedef struct LVMReportStream {
+    const gchar *report_key;
+    gchar *section;
+    gboolean got_output;
+    gboolean got_report;
+    gboolean got_key;
+    JsonParser *parser;
+    LVMReportRowFunc row_func;
+    gpointer row_data;
+    GError *error;
+} LVMReportStream;
+
+/* LVM prints every row of its JSON reports on a separate line (and so does
+   every line opening or closing a report section) so each row can be parsed on
+   its own without ever loading the whole report into memory */
+static void report_stream_line (const gchar *line, gpointer user_data) {
+    LVMReportStream *stream = (LVMReportStream *) user_data;
+    const gchar *end = NULL;
+    const gchar *quote = NULL;
+    JsonNode *root = NULL;
+    GError *l_error = NULL;
+
+    if (stream->error)
+        /* already failed, just let the process finish */
+        return;
+
+    while (g_ascii_isspace (*line))
+        line++;
+    end = line + strlen (line);
+    while (end > line && g_ascii_isspace (*(end - 1)))
+        end--;
+    if (end > line && *(end - 1) == ',')
+        end--;
+    if (end == line)
+        return;
+
+    stream->got_output = TRUE;
+
+    if (*line == '"' && (*(end - 1) == '[' || (end - line > 2 && *(end - 2) == '[' && *(end - 1) == ']'))) {
+        /* beginning of a section ("lv": [) or an empty section ("lv": []) */
+        quote = strchr (line + 1, '"');
+        if (!quote || quote >= end) {
+            g_set_error (&stream->error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
+                         "Failed to parse JSON output from LVM: unexpected line '%.*s'", (int) (end - line), line);
+            return;
+        }
+        g_free (stream->section);
+        stream->section = g_strndup (line + 1, quote - line - 1);
+        if (stream->report_key && g_strcmp0 (stream->section, stream->report_key) == 0)
+            stream->got_key = TRUE;
+        if (g_strcmp0 (stream->section, "report") == 0) {
+            stream->got_report = TRUE;
+            g_clear_pointer (&stream->section, g_free);
+        } else if (*(end - 1) == ']')
+            g_clear_pointer (&stream->section, g_free);
+    } else if (*line == ']')
+        /* end of a section */
+        g_clear_pointer (&stream->section, g_free);
+    else if (stream->section && (*line != '{' || (end - line) < 2 || *(end - 1) != '}')) {
+        /* there's nothing but rows in a section */
+        g_set_error (&stream->error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
+                     "Failed to parse JSON output from LVM: unexpected line '%.*s'", (int) (end - line), line);
+    } else if (stream->section &&
+               (!stream->report_key || g_strcmp0 (stream->section, stream->report_key) == 0)) {
+        /* a row */
+        if (!json_parser_load_from_data (stream->parser, line, end - line, &l_error)) {
+            g_set_error (&stream->error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
+                         "Failed to parse JSON output from LVM: %s", l_error->message);
+            g_error_free (l_error);
+            return;
+        }
+        root = json_parser_get_root (stream->parser);
+        if (!root || !JSON_NODE_HOLDS_OBJECT (root)) {
+            g_set_error (&stream->error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
+                         "Failed to parse JSON output from LVM: unexpected line '%.*s'", (int) (end - line), line);
+            return;
+        }
+        stream->row_func (stream->section, json_node_get_object (root), stream->row_data);
+    }
+}
+
+/**
+ * call_lvm_and_stream_json_report:
+ * @args: LVM command arguments (must include --reportformat json_std)
+ * @report_key: (nullable): the report section to pass rows from (e.g., "pv", "vg", "lv")
+ *                          or %NULL for rows from all sections
+ * @row_func: function to call for every row
+ * @row_data: data to pass to @row_func
+ * @error: (out) (optional): place to store error
+ *
+ * Runs an LVM command and passes the rows of its JSON report to @row_func as
+ * the output is being read. Unlike call_lvm_and_parse_json_report(), neither the
+ * whole output nor the whole JSON tree are kept in memory, only a single row.
+ * No output is not an error, @row_func is just never called in such case.
+ *
+ * Returns: whether the command was successfully run and its output parsed or not
+ */
+static gboolean call_lvm_and_stream_json_report (const gchar **args, const gchar *report_key,
+                                                 LVMReportRowFunc row_func, gpointer row_data,
+                                                 GError **error) {
+    gboolean success = FALSE;
+    const gchar **argv = NULL;
+    g_autofree gchar *config_arg = NULL;
+    g_autofree gchar *devices_arg = NULL;
+    gchar *output = NULL;
+    gchar *line = NULL;
+    gchar *next = NULL;
+    gboolean use_shell = FALSE;
+    gboolean shell_busy = FALSE;
+    LVMReportStream stream = { report_key, NULL, FALSE, FALSE, FALSE, NULL, row_func, row_data, NULL };
+
+    if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+        return FALSE;
+
+    argv = build_lvm_argv (args, TRUE, &config_arg, &devices_arg);
+
+    stream.parser = json_parser_new ();
+    use_shell = lvm_shell_usable (argv, NULL, TRUE);
+    if (use_shell) {
+        /* the shell gives us the report in one piece, but we can still avoid
+           building the whole JSON tree */
+        success = lvm_shell_run_report (argv, NULL, &output, &shell_busy, error);
+        for (line = output; success && line && *line; line = next) {
+            next = strchr (line, '\n');
+            if (next)
+                *(next++) = '\0';
+            else
+                next = line + strlen (line);
+            report_stream_line (line, &stream);
+        }
+        g_free (output);
+    }
+    /* reports don't wait for the shell running another command */
+    if (!use_shell || shell_busy)
+        success = bd_utils_exec_and_stream_output (argv, NULL, report_stream_line, &stream, error);
+    g_free (argv);
+    g_object_unref (stream.parser);
+    g_free (stream.section);
+
+    if (!success) {
+        g_clear_error (&stream.error);
+        return FALSE;
+    }
+
+    if (stream.error) {
+        g_propagate_error (error, stream.error);
+        return FALSE;
+    }
+
+    if (stream.got_output && !stream.got_report) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
+                             "Failed to parse LVM report");
+        return FALSE;
+    }
+
+    if (stream.got_output && report_key && !stream.got_key) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_PARSE,
+                     "Failed to parse LVM report: missing '%s' key", report_key);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+
+/* report columns needed for the particular BDLVMQueryFields, columns for
+   BD_LVM_QUERY_FIELDS_BASIC are always included */
+typedef struct ReportColumns {
+    BDLVMQueryFields fields;
+    const gchar *columns;
+} ReportColumns;
+
+static const ReportColumns pv_columns[] = {
+    {BD_LVM_QUERY_FIELDS_BASIC, "pv_name,pv_uuid"},
+    {BD_LVM_QUERY_FIELDS_SIZE, "pv_free,pv_size,pe_start"},
+    {BD_LVM_QUERY_FIELDS_VG, "vg_name,vg_uuid,vg_size,vg_free,vg_extent_size,vg_extent_count,vg_free_count,pv_count"},
+    {BD_LVM_QUERY_FIELDS_TAGS, "pv_tags"},
+    {BD_LVM_QUERY_FIELDS_ATTRS, "pv_missing"},
+    {0, NULL}
+};
+
+static const ReportColumns vg_columns[] = {
+    {BD_LVM_QUERY_FIELDS_BASIC, "vg_name,vg_uuid"},
+    {BD_LVM_QUERY_FIELDS_SIZE, "vg_size,vg_free,vg_extent_size,vg_extent_count,vg_free_count"},
+    {BD_LVM_QUERY_FIELDS_ATTRS, "pv_count,vg_exported,vg_seqno"},
+    {BD_LVM_QUERY_FIELDS_TAGS, "vg_tags"},
+    {0, NULL}
+};
+
+static const ReportColumns lv_columns[] = {
+    {BD_LVM_QUERY_FIELDS_BASIC, "vg_name,lv_name,lv_uuid"},
+    {BD_LVM_QUERY_FIELDS_SIZE, "lv_size"},
+    {BD_LVM_QUERY_FIELDS_ATTRS, "lv_attr,segtype,origin,pool_lv,data_lv,metadata_lv,lv_role"},
+    /* these need device-mapper status of the LVs */
+    {BD_LVM_QUERY_FIELDS_STATUS, "move_pv,data_percent,metadata_percent,copy_percent"},
+    {BD_LVM_QUERY_FIELDS_TAGS, "lv_tags"},
+    {0, NULL}
+};
+
+static gchar* get_report_columns (const ReportColumns *columns, BDLVMQueryFields fields, const gchar *extra) {
+    GString *ret = g_string_new (NULL);
+
+    for (const ReportColumns *col = columns; col->columns; col++) {
+        if (col->fields != BD_LVM_QUERY_FIELDS_BASIC && !(col->fields & fields))
+            continue;
+        if (ret->len > 0)
+            g_string_append_c (ret, ',');
+        g_string_append (ret, col->columns);
+    }
+    if (extra) {
+        if (ret->len > 0)
+            g_string_append_c (ret, ',');
+        g_string_append (ret, extra);
+    }
+
+    return g_string_free (ret, FALSE);
+}
 
 /* LVM json_std outputs "" for absent string values (e.g. vg_name for a PV
    not in any VG). Convert these to NULL for consistency with the dbus plugin. */
@@ -415,6 +1150,7 @@ static BDLVMVGdata* get_vg_data_from_json (JsonObject *vg_obj) {
     data->pv_count = (guint64) json_object_get_int_member_with_default (vg_obj, "pv_count", 0);
 
     data->exported = (gboolean) json_object_get_int_member_with_default (vg_obj, "vg_exported", 0);
+    data->seqno = (guint64) json_object_get_int_member_with_default (vg_obj, "vg_seqno", 0);
 
     if (json_object_has_member (vg_obj, "vg_tags")) {
         tags_array = json_object_get_array_member (vg_obj, "vg_tags");
@@ -802,6 +1538,21 @@ static gboolean extract_pvmove_progress (const gchar *line, guint8 *completion)
     return FALSE;
 }
 
+static gboolean _pvmove (const gchar *src, const gchar *dest, const BDExtraArg **extra, BDLVMJob **job, GError **error) {
+    const gchar *args[6] = {"pvmove", "-i", "1", src, NULL, NULL};
+    const gchar *abort_args[4] = {"pvmove", "--abort", src, NULL};
+    gint status = 0;
+    if (dest)
+        args[4] = dest;
+
+    if (job) {
+        *job = start_lvm_job (args, extra, TRUE, extract_pvmove_progress, abort_args, error);
+        return *job != NULL;
+    }
+
+    return call_lvm_and_report_progress (args, extra, extract_pvmove_progress, &status, error);
+}
+
 /**
  * bd_lvm_pvmove:
  * @src: the PV device to move extents off of
@@ -818,12 +1569,31 @@ static gboolean extract_pvmove_progress (const gchar *line, guint8 *completion)
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
  */
 gboolean bd_lvm_pvmove (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error) {
-    const gchar *args[6] = {"pvmove", "-i", "1", src, NULL, NULL};
-    gint status = 0;
-    if (dest)
-        args[4] = dest;
+    return _pvmove (src, dest, extra, NULL, error);
+}
 
-    return call_lvm_and_report_progress (args, extra, extract_pvmove_progress, &status, error);
+/**
+ * bd_lvm_pvmove_start:
+ * @src: the PV device to move extents off of
+ * @dest: (nullable): the PV device to move extents onto or %NULL
+ * @extra: (nullable) (array zero-terminated=1): extra options for the PV move
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_pvmove(), but doesn't wait for the extents to be moved. Use
+ * bd_lvm_job_wait() or bd_lvm_job_wait_any() to wait for the move to finish
+ * and get its result.
+ *
+ * Returns: (transfer full): a handle of the started PV move or %NULL in case
+ *                           it failed to start (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+BDLVMJob* bd_lvm_pvmove_start (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error) {
+    BDLVMJob *job = NULL;
+
+    _pvmove (src, dest, extra, &job, error);
+    return job;
 }
 
 /**
@@ -938,6 +1708,14 @@ BDLVMPVdata* bd_lvm_pvinfo (const gchar *device, GError **error) {
     return ret;
 }
 
+static void add_pv_row (const gchar *section G_GNUC_UNUSED, JsonObject *row, gpointer user_data) {
+    GPtrArray *pvs = (GPtrArray *) user_data;
+    BDLVMPVdata *pvdata = get_pv_data_from_json (row);
+
+    if (pvdata)
+        g_ptr_array_add (pvs, pvdata);
+}
+
 /**
  * bd_lvm_pvs:
  * @error: (out) (optional): place to store error (if any)
@@ -947,38 +1725,38 @@ BDLVMPVdata* bd_lvm_pvinfo (const gchar *device, GError **error) {
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
  */
 BDLVMPVdata** bd_lvm_pvs (GError **error) {
+    return bd_lvm_pvs_with_fields (BD_LVM_QUERY_FIELDS_ALL, error);
+}
+
+/**
+ * bd_lvm_pvs_with_fields:
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_pvs(), but only the @fields are queried and filled in, the rest
+ * of the data is left unset (%NULL or 0). Names and UUIDs are always queried.
+ *
+ * Returns: (array zero-terminated=1): information about PVs found in the system
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMPVdata** bd_lvm_pvs_with_fields (BDLVMQueryFields fields, GError **error) {
     const gchar *args[9] = {"pvs", "--units=b", "--nosuffix",
                        "--reportformat", "json_std",
-                       "-o", "pv_name,pv_uuid,pv_free,pv_size,pe_start,vg_name,vg_uuid,vg_size," \
-                       "vg_free,vg_extent_size,vg_extent_count,vg_free_count,pv_count,pv_tags,pv_missing",
-                       NULL};
-    JsonParser *parser = NULL;
-    JsonArray *pv_array = NULL;
+                       "-o", NULL, NULL};
+    g_autofree gchar *columns = NULL;
     GPtrArray *pvs;
-    GError *l_error = NULL;
 
-    pvs = g_ptr_array_new ();
+    columns = get_report_columns (pv_columns, fields, NULL);
+    args[6] = columns;
 
-    pv_array = call_lvm_and_parse_json_report (args, "pv", &parser, TRUE, &l_error);
-    if (!pv_array) {
-        if (l_error) {
-            g_propagate_error (error, l_error);
-            g_ptr_array_free (pvs, TRUE);
-            return NULL;
-        }
-        /* no output => no PVs, not an error */
-        g_ptr_array_add (pvs, NULL);
-        return (BDLVMPVdata **) g_ptr_array_free (pvs, FALSE);
-    }
+    pvs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_pvdata_free);
 
-    for (guint i = 0; i < json_array_get_length (pv_array); i++) {
-        JsonObject *pv_obj = json_array_get_object_element (pv_array, i);
-        BDLVMPVdata *pvdata = get_pv_data_from_json (pv_obj);
-        if (pvdata)
-            g_ptr_array_add (pvs, pvdata);
+    if (!call_lvm_and_stream_json_report (args, "pv", add_pv_row, pvs, error)) {
+        g_ptr_array_free (pvs, TRUE);
+        return NULL;
     }
-
-    g_object_unref (parser);
+    g_ptr_array_set_free_func (pvs, NULL);
 
     /* returning NULL-terminated array of BDLVMPVdata */
     g_ptr_array_add (pvs, NULL);
@@ -1221,7 +1999,7 @@ gboolean bd_lvm_vglock_stop (const gchar *vg_name, const BDExtraArg **extra, GEr
 BDLVMVGdata* bd_lvm_vginfo (const gchar *vg_name, GError **error) {
     const gchar *args[10] = {"vgs", "--nosuffix", "--units=b",
                        "--reportformat", "json_std",
-                       "-o", "name,uuid,size,free,extent_size,extent_count,free_count,pv_count,vg_exported,vg_tags",
+                       "-o", "name,uuid,size,free,extent_size,extent_count,free_count,pv_count,vg_exported,vg_tags,vg_seqno",
                        vg_name, NULL};
     JsonParser *parser = NULL;
     JsonArray *vg_array = NULL;
@@ -1244,6 +2022,14 @@ BDLVMVGdata* bd_lvm_vginfo (const gchar *vg_name, GError **error) {
     return ret;
 }
 
+static void add_vg_row (const gchar *section G_GNUC_UNUSED, JsonObject *row, gpointer user_data) {
+    GPtrArray *vgs = (GPtrArray *) user_data;
+    BDLVMVGdata *vgdata = get_vg_data_from_json (row);
+
+    if (vgdata)
+        g_ptr_array_add (vgs, vgdata);
+}
+
 /**
  * bd_lvm_vgs:
  * @error: (out) (optional): place to store error (if any)
@@ -1253,37 +2039,38 @@ BDLVMVGdata* bd_lvm_vginfo (const gchar *vg_name, GError **error) {
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
  */
 BDLVMVGdata** bd_lvm_vgs (GError **error) {
+    return bd_lvm_vgs_with_fields (BD_LVM_QUERY_FIELDS_ALL, error);
+}
+
+/**
+ * bd_lvm_vgs_with_fields:
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_vgs(), but only the @fields are queried and filled in, the rest
+ * of the data is left unset (%NULL or 0). Names and UUIDs are always queried.
+ *
+ * Returns: (array zero-terminated=1): information about VGs found in the system
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMVGdata** bd_lvm_vgs_with_fields (BDLVMQueryFields fields, GError **error) {
     const gchar *args[9] = {"vgs", "--nosuffix", "--units=b",
                       "--reportformat", "json_std",
-                      "-o", "name,uuid,size,free,extent_size,extent_count,free_count,pv_count,vg_exported,vg_tags",
-                      NULL};
-    JsonParser *parser = NULL;
-    JsonArray *vg_array = NULL;
+                      "-o", NULL, NULL};
+    g_autofree gchar *columns = NULL;
     GPtrArray *vgs;
-    GError *l_error = NULL;
 
-    vgs = g_ptr_array_new ();
+    columns = get_report_columns (vg_columns, fields, NULL);
+    args[6] = columns;
 
-    vg_array = call_lvm_and_parse_json_report (args, "vg", &parser, TRUE, &l_error);
-    if (!vg_array) {
-        if (l_error) {
-            g_propagate_error (error, l_error);
-            g_ptr_array_free (vgs, TRUE);
-            return NULL;
-        }
-        /* no output => no VGs, not an error */
-        g_ptr_array_add (vgs, NULL);
-        return (BDLVMVGdata **) g_ptr_array_free (vgs, FALSE);
-    }
+    vgs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_vgdata_free);
 
-    for (guint i = 0; i < json_array_get_length (vg_array); i++) {
-        JsonObject *vg_obj = json_array_get_object_element (vg_array, i);
-        BDLVMVGdata *vgdata = get_vg_data_from_json (vg_obj);
-        if (vgdata)
-            g_ptr_array_add (vgs, vgdata);
+    if (!call_lvm_and_stream_json_report (args, "vg", add_vg_row, vgs, error)) {
+        g_ptr_array_free (vgs, TRUE);
+        return NULL;
     }
-
-    g_object_unref (parser);
+    g_ptr_array_set_free_func (vgs, NULL);
 
     /* returning NULL-terminated array of BDLVMVGdata */
     g_ptr_array_add (vgs, NULL);
@@ -1317,43 +2104,27 @@ gchar* bd_lvm_lvorigin (const gchar *vg_name, const gchar *lv_name, GError **err
     return g_strstrip (output);
 }
 
-/**
- * bd_lvm_lvcreate:
- * @vg_name: name of the VG to create a new LV in
- * @lv_name: name of the to-be-created LV
- * @size: requested size of the new LV
- * @type: (nullable): type of the new LV ("striped", "raid1",..., see lvcreate (8))
- * @pv_list: (nullable) (array zero-terminated=1): list of PVs the newly created LV should use or %NULL
- * if not specified
- * @extra: (nullable) (array zero-terminated=1): extra options for the LV creation
- *                                                 (just passed to LVM as is)
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the given @vg_name/@lv_name LV was successfully created or not
- *
- * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_CREATE
- */
-gboolean bd_lvm_lvcreate (const gchar *vg_name, const gchar *lv_name, guint64 size, const gchar *type, const gchar **pv_list, const BDExtraArg **extra, GError **error) {
+/* @size_str and @type_str are set to the strings used in the returned args that
+   need to be freed by the caller (together with the returned args) */
+static const gchar** build_lvcreate_args (const gchar *vg_name, const gchar *lv_name, guint64 size, const gchar *type,
+                                          const gchar **pv_list, gchar **size_str, gchar **type_str) {
     guint pv_list_len = pv_list ? g_strv_length ((gchar **) pv_list) : 0;
     const gchar **args = g_new0 (const gchar*, pv_list_len + 10);
-    gboolean success = FALSE;
     guint64 i = 0;
     guint64 j = 0;
-    gchar *size_str = NULL;
-    gchar *type_str = NULL;
 
     args[i++] = "lvcreate";
     args[i++] = "-n";
     args[i++] = lv_name;
     args[i++] = "-L";
-    size_str = g_strdup_printf ("%"G_GUINT64_FORMAT"K", size/1024);
-    args[i++] = size_str;
+    *size_str = g_strdup_printf ("%"G_GUINT64_FORMAT"K", size/1024);
+    args[i++] = *size_str;
     args[i++] = "-y";
     if (type) {
         if (g_strcmp0 (type, "striped") == 0) {
             args[i++] = "--stripes";
-            type_str = g_strdup_printf ("%d", pv_list_len);
-            args[i++] = type_str;
+            *type_str = g_strdup_printf ("%d", pv_list_len);
+            args[i++] = *type_str;
         } else {
             args[i++] = "--type";
             args[i++] = type;
@@ -1366,6 +2137,33 @@ gboolean bd_lvm_lvcreate (const gchar *vg_name, const gchar *lv_name, guint64 si
 
     args[i] = NULL;
 
+    return args;
+}
+
+/**
+ * bd_lvm_lvcreate:
+ * @vg_name: name of the VG to create a new LV in
+ * @lv_name: name of the to-be-created LV
+ * @size: requested size of the new LV
+ * @type: (nullable): type of the new LV ("striped", "raid1",..., see lvcreate (8))
+ * @pv_list: (nullable) (array zero-terminated=1): list of PVs the newly created LV should use or %NULL
+ * if not specified
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV creation
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the given @vg_name/@lv_name LV was successfully created or not
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_CREATE
+ */
+gboolean bd_lvm_lvcreate (const gchar *vg_name, const gchar *lv_name, guint64 size, const gchar *type, const gchar **pv_list, const BDExtraArg **extra, GError **error) {
+    const gchar **args = NULL;
+    gboolean success = FALSE;
+    gchar *size_str = NULL;
+    gchar *type_str = NULL;
+
+    args = build_lvcreate_args (vg_name, lv_name, size, type, pv_list, &size_str, &type_str);
+
     success = call_lvm_and_report_error (args, extra, TRUE, error);
     g_free (size_str);
     g_free (type_str);
@@ -1406,6 +2204,206 @@ gboolean bd_lvm_lvremove (const gchar *vg_name, const gchar *lv_name, gboolean f
     return success;
 }
 
+/* runs one command of a batch, either in the batch's private lvm shell (if
+   given) or the same way as any other command */
+static gboolean call_lvm_batch_command (const gchar **args, const BDExtraArg **extra, LVMShell **batch_shell, GError **error) {
+    gboolean success = FALSE;
+    const gchar **argv = NULL;
+    g_autofree gchar *config_arg = NULL;
+    g_autofree gchar *devices_arg = NULL;
+
+    if (!batch_shell)
+        return call_lvm_and_report_error (args, extra, TRUE, error);
+
+    argv = build_lvm_argv (args, TRUE, &config_arg, &devices_arg);
+
+    if (lvm_shell_can_run (argv, extra, FALSE))
+        success = lvm_shell_run_private (batch_shell, argv, extra, NULL, error);
+    else
+        success = bd_utils_exec_and_report_error (argv, extra, error);
+    g_free (argv);
+
+    return success;
+}
+
+/**
+ * bd_lvm_lvcreate_many:
+ * @vg_name: name of the VG to create the new LVs in
+ * @specs: (array zero-terminated=1): specifications of the LVs to create
+ * @extra: (nullable) (array zero-terminated=1): extra options for the creation of
+ *                                                 each of the LVs (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Creates all the LVs specified by @specs, minimizing the overhead of running the
+ * LVM commands for each of them. A failure to create one of the LVs doesn't stop
+ * the creation of the others.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): results of the creation
+ *          for each of the @specs (in the same order) or %NULL in case of error
+ *          preventing the whole batch from being run
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_CREATE
+ */
+BDLVMBatchResult** bd_lvm_lvcreate_many (const gchar *vg_name, BDLVMLVSpec **specs, const BDExtraArg **extra, GError **error) {
+    const gchar *thin_args[8] = {"lvcreate", "-T", NULL, "-V", NULL, "-n", NULL, NULL};
+    const gchar **args = NULL;
+    GPtrArray *results = NULL;
+    BDLVMLVSpec **spec_p = NULL;
+    gchar *size_str = NULL;
+    gchar *type_str = NULL;
+    gchar *pool_str = NULL;
+    gboolean use_shell = FALSE;
+    LVMShell *batch_shell = NULL;
+    GError *l_error = NULL;
+
+    if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+        return NULL;
+
+    /* lvcreate can only create one LV at a time, but all of them can be passed
+       to one lvm shell process instead of starting (and initializing) lvm for
+       each of them, the batch gets its own shell unless the shell mode is
+       enabled and the shared one is used anyway */
+    use_shell = !lvm_shell_get_enabled () && specs && specs[0] && specs[1];
+
+    results = g_ptr_array_new ();
+    for (spec_p = specs; spec_p && *spec_p; spec_p++) {
+        size_str = NULL;
+        type_str = NULL;
+        pool_str = NULL;
+        if ((*spec_p)->pool_name) {
+            pool_str = g_strdup_printf ("%s/%s", vg_name, (*spec_p)->pool_name);
+            size_str = g_strdup_printf ("%"G_GUINT64_FORMAT"K", (*spec_p)->size / 1024);
+            thin_args[2] = pool_str;
+            thin_args[4] = size_str;
+            thin_args[6] = (*spec_p)->lv_name;
+            args = NULL;
+        } else
+            args = build_lvcreate_args (vg_name, (*spec_p)->lv_name, (*spec_p)->size, (*spec_p)->type,
+                                        (const gchar **) (*spec_p)->pv_list, &size_str, &type_str);
+
+        call_lvm_batch_command (args ? args : thin_args, extra, use_shell ? &batch_shell : NULL, &l_error);
+        g_ptr_array_add (results, _lvm_batch_result_new ((*spec_p)->lv_name, l_error));
+
+        g_clear_error (&l_error);
+        g_free (size_str);
+        g_free (type_str);
+        g_free (pool_str);
+        g_free (args);
+    }
+
+    lvm_shell_free (batch_shell);
+
+    g_ptr_array_add (results, NULL);
+    return (BDLVMBatchResult **) g_ptr_array_free (results, FALSE);
+}
+
+/**
+ * bd_lvm_lvremove_many:
+ * @vg_name: name of the VG containing the to-be-removed LVs
+ * @lv_names: (array zero-terminated=1): names of the to-be-removed LVs
+ * @force: whether to force removal or not
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV removal
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Removes all the @lv_names LVs, minimizing the number of LVM commands run.
+ * A failure to remove one of the LVs doesn't stop the removal of the others.
+ * LVs not existing in @vg_name are reported as failed with %BD_LVM_ERROR_NOEXIST.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): results of the removal
+ *          for each of the @lv_names (in the same order) or %NULL in case of error
+ *          preventing the whole batch from being run
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_REMOVE
+ */
+BDLVMBatchResult** bd_lvm_lvremove_many (const gchar *vg_name, const gchar **lv_names, gboolean force, const BDExtraArg **extra, GError **error) {
+    guint n_lvs = lv_names ? g_strv_length ((gchar **) lv_names) : 0;
+    const gchar **args = NULL;
+    BDLVMBatchResult **results = NULL;
+    BDLVMLVdata **lvs = NULL;
+    BDLVMLVdata **lv_p = NULL;
+    GHashTable *existing = NULL;
+    GHashTable *remaining = NULL;
+    GPtrArray *lv_specs = NULL;
+    GError *l_error = NULL;
+    GError *lvs_error = NULL;
+    GError *noexist_error = NULL;
+    gboolean success = TRUE;
+    guint next_arg = 0;
+    guint i = 0;
+
+    if (!check_deps (&avail_deps, DEPS_LVM_MASK, deps, DEPS_LAST, &deps_check_lock, error))
+        return NULL;
+
+    if (n_lvs == 0)
+        return g_new0 (BDLVMBatchResult *, 1);
+
+    /* LVs existing before the removal, names of the other LVs must not be
+       reported as removed just because they are not there afterwards */
+    lvs = bd_lvm_lvs_with_fields (vg_name, BD_LVM_QUERY_FIELDS_BASIC, error);
+    if (!lvs) {
+        g_prefix_error (error, "Failed to get LVs in the VG '%s': ", vg_name);
+        return NULL;
+    }
+    existing = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) bd_lvm_lvdata_free);
+    for (lv_p = lvs; *lv_p; lv_p++)
+        g_hash_table_replace (existing, (*lv_p)->lv_name, *lv_p);
+    g_free (lvs);
+
+    lv_specs = g_ptr_array_new_with_free_func (g_free);
+    for (i = 0; i < n_lvs; i++)
+        if (g_hash_table_contains (existing, lv_names[i]))
+            g_ptr_array_add (lv_specs, g_strdup_printf ("%s/%s", vg_name, lv_names[i]));
+
+    /* lvremove removes all the LVs given to it in one go (continuing with the
+       other LVs if one of them cannot be removed) */
+    if (lv_specs->len > 0) {
+        args = g_new0 (const gchar *, lv_specs->len + 4);
+        args[next_arg++] = "lvremove";
+        /* '--yes' is needed if DISCARD is enabled */
+        args[next_arg++] = "--yes";
+        if (force)
+            args[next_arg++] = "--force";
+        for (i = 0; i < lv_specs->len; i++)
+            args[next_arg++] = g_ptr_array_index (lv_specs, i);
+        args[next_arg] = NULL;
+
+        success = call_lvm_and_report_error (args, extra, TRUE, &l_error);
+        g_free (args);
+    }
+    g_ptr_array_free (lv_specs, TRUE);
+
+    /* find out which of the LVs couldn't be removed, all of them are considered
+       failed if that's not possible */
+    remaining = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) bd_lvm_lvdata_free);
+    if (!success) {
+        lvs = bd_lvm_lvs_with_fields (vg_name, BD_LVM_QUERY_FIELDS_BASIC, &lvs_error);
+        for (lv_p = lvs; lv_p && *lv_p; lv_p++)
+            g_hash_table_replace (remaining, (*lv_p)->lv_name, *lv_p);
+        g_free (lvs);
+    }
+
+    results = g_new0 (BDLVMBatchResult *, n_lvs + 1);
+    for (i = 0; i < n_lvs; i++) {
+        if (!g_hash_table_contains (existing, lv_names[i])) {
+            g_set_error (&noexist_error, BD_LVM_ERROR, BD_LVM_ERROR_NOEXIST,
+                         "The LV '%s/%s' doesn't exist", vg_name, lv_names[i]);
+            results[i] = _lvm_batch_result_new (lv_names[i], noexist_error);
+            g_clear_error (&noexist_error);
+        } else if (!success && (lvs_error || g_hash_table_contains (remaining, lv_names[i])))
+            results[i] = _lvm_batch_result_new (lv_names[i], l_error);
+        else
+            results[i] = _lvm_batch_result_new (lv_names[i], NULL);
+    }
+
+    g_hash_table_destroy (existing);
+    g_hash_table_destroy (remaining);
+    g_clear_error (&lvs_error);
+    g_clear_error (&l_error);
+
+    return results;
+}
+
 /**
  * bd_lvm_lvrename:
  * @vg_name: name of the VG containing the to-be-renamed LV
@@ -1426,20 +2424,7 @@ gboolean bd_lvm_lvrename (const gchar *vg_name, const gchar *lv_name, const gcha
 }
 
 
-/**
- * bd_lvm_lvresize:
- * @vg_name: name of the VG containing the to-be-resized LV
- * @lv_name: name of the to-be-resized LV
- * @size: the requested new size of the LV
- * @extra: (nullable) (array zero-terminated=1): extra options for the LV resize
- *                                                 (just passed to LVM as is)
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the @vg_name/@lv_name LV was successfully resized or not
- *
- * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
- */
-gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error) {
+static gboolean _lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, BDLVMJob **job, GError **error) {
     const gchar *args[8] = {"lvresize", "--force", "-L", NULL, NULL, NULL, NULL, NULL};
     gboolean success = FALSE;
     guint8 next_arg = 4;
@@ -1460,10 +2445,54 @@ gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 si
     lvspec = g_strdup_printf ("%s/%s", vg_name, lv_name);
     args[next_arg++] = lvspec;
 
-    success = call_lvm_and_report_error (args, extra, TRUE, error);
-    g_free ((gchar *) args[3]);
+    if (job) {
+        *job = start_lvm_job (args, extra, TRUE, NULL, NULL, error);
+        success = *job != NULL;
+    } else
+        success = call_lvm_and_report_error (args, extra, TRUE, error);
+    g_free ((gchar *) args[3]);
+
+    return success;
+}
+
+/**
+ * bd_lvm_lvresize:
+ * @vg_name: name of the VG containing the to-be-resized LV
+ * @lv_name: name of the to-be-resized LV
+ * @size: the requested new size of the LV
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV resize
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @vg_name/@lv_name LV was successfully resized or not
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error) {
+    return _lvresize (vg_name, lv_name, size, extra, NULL, error);
+}
+
+/**
+ * bd_lvm_lvresize_start:
+ * @vg_name: name of the VG containing the to-be-resized LV
+ * @lv_name: name of the to-be-resized LV
+ * @size: the requested new size of the LV
+ * @extra: (nullable) (array zero-terminated=1): extra options for the LV resize
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_lvresize(), but doesn't wait for the resize to finish.
+ *
+ * Returns: (transfer full): a handle of the started LV resize or %NULL in case
+ *                           it failed to start (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+BDLVMJob* bd_lvm_lvresize_start (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error) {
+    BDLVMJob *job = NULL;
 
-    return success;
+    _lvresize (vg_name, lv_name, size, extra, &job, error);
+    return job;
 }
 
 /**
@@ -1743,6 +2772,47 @@ BDLVMLVdata* bd_lvm_lvinfo_tree (const gchar *vg_name, const gchar *lv_name, GEr
     return result;
 }
 
+typedef struct LVRows {
+    GPtrArray *lvs;
+    GHashTable *lvs_by_name;
+    gboolean merge_segs;
+} LVRows;
+
+static void add_lv_row (const gchar *section G_GNUC_UNUSED, JsonObject *row, gpointer user_data) {
+    LVRows *rows = (LVRows *) user_data;
+    BDLVMLVdata *lvdata = get_lv_data_from_json (row);
+    BDLVMLVdata *other = NULL;
+    gchar *key = NULL;
+
+    if (!lvdata)
+        return;
+
+    if (!lvdata->vg_name || !lvdata->lv_name) {
+        /* nothing to find other rows of the same LV by */
+        g_ptr_array_add (rows->lvs, lvdata);
+        return;
+    }
+
+    key = g_strdup_printf ("%s/%s", lvdata->vg_name, lvdata->lv_name);
+    other = g_hash_table_lookup (rows->lvs_by_name, key);
+    if (!other) {
+        g_hash_table_insert (rows->lvs_by_name, key, lvdata);
+        g_ptr_array_add (rows->lvs, lvdata);
+        return;
+    }
+
+    if (rows->merge_segs)
+        /* more segments of an LV we've already seen */
+        merge_lv_data (other, lvdata);
+    else
+        /* ignore duplicate entries in lvs output, these are caused by multi segments LVs */
+        bd_utils_log_format (BD_UTILS_LOG_DEBUG,
+                             "Duplicate LV entry for '%s' found in lvs output",
+                             key);
+    bd_lvm_lvdata_free (lvdata);
+    g_free (key);
+}
+
 /**
  * bd_lvm_lvs:
  * @vg_name: (nullable): name of the VG to get information about LVs from
@@ -1754,59 +2824,53 @@ BDLVMLVdata* bd_lvm_lvinfo_tree (const gchar *vg_name, const gchar *lv_name, GEr
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
  */
 BDLVMLVdata** bd_lvm_lvs (const gchar *vg_name, GError **error) {
+    return bd_lvm_lvs_with_fields (vg_name, BD_LVM_QUERY_FIELDS_ALL, error);
+}
+
+/**
+ * bd_lvm_lvs_with_fields:
+ * @vg_name: (nullable): name of the VG to get information about LVs from
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_lvs(), but only the @fields are queried and filled in, the rest
+ * of the data is left unset (%NULL or 0). Names (including the VG name) and UUIDs
+ * are always queried. Leaving out %BD_LVM_QUERY_FIELDS_STATUS avoids getting
+ * device-mapper status of all the active LVs.
+ *
+ * Returns: (array zero-terminated=1): information about LVs found in the given
+ * @vg_name VG or in system if @vg_name is %NULL
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata** bd_lvm_lvs_with_fields (const gchar *vg_name, BDLVMQueryFields fields, GError **error) {
     const gchar *args[11] = {"lvs", "--nosuffix", "--units=b",
                        "--reportformat", "json_std", "-a",
-                       "-o", "vg_name,lv_name,lv_uuid,lv_size,lv_attr,segtype,origin,pool_lv,data_lv,metadata_lv,lv_role,move_pv,data_percent,metadata_percent,copy_percent,lv_tags",
-                       NULL, NULL};
-    JsonParser *parser = NULL;
-    JsonArray *lv_array = NULL;
-    GPtrArray *lvs;
-    GError *l_error = NULL;
+                       "-o", NULL, NULL, NULL};
+    g_autofree gchar *columns = NULL;
+    LVRows rows = { NULL, NULL, FALSE };
 
-    lvs = g_ptr_array_new ();
+    columns = get_report_columns (lv_columns, fields, NULL);
+    args[7] = columns;
 
     if (vg_name)
         args[8] = vg_name;
 
-    lv_array = call_lvm_and_parse_json_report (args, "lv", &parser, TRUE, &l_error);
-    if (!lv_array) {
-        if (l_error) {
-            g_propagate_error (error, l_error);
-            g_ptr_array_free (lvs, TRUE);
-            return NULL;
-        }
-        /* no output => no LVs, not an error */
-        g_ptr_array_add (lvs, NULL);
-        return (BDLVMLVdata **) g_ptr_array_free (lvs, FALSE);
-    }
-
-    for (guint i = 0; i < json_array_get_length (lv_array); i++) {
-        JsonObject *lv_obj = json_array_get_object_element (lv_array, i);
-        BDLVMLVdata *lvdata = get_lv_data_from_json (lv_obj);
-        if (lvdata) {
-            /* ignore duplicate entries in lvs output, these are caused by multi segments LVs */
-            gboolean duplicate = FALSE;
-            for (gsize j = 0; j < lvs->len; j++) {
-                if (g_strcmp0 (((BDLVMLVdata *) g_ptr_array_index (lvs, j))->lv_name, lvdata->lv_name) == 0) {
-                    bd_utils_log_format (BD_UTILS_LOG_DEBUG,
-                                         "Duplicate LV entry for '%s' found in lvs output",
-                                         lvdata->lv_name);
-                    bd_lvm_lvdata_free (lvdata);
-                    duplicate = TRUE;
-                    break;
-                }
-            }
+    rows.lvs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_lvdata_free);
+    /* LVs by "VG/LV" names, LV names are only unique within a VG */
+    rows.lvs_by_name = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
 
-            if (!duplicate)
-                g_ptr_array_add (lvs, lvdata);
-        }
+    if (!call_lvm_and_stream_json_report (args, "lv", add_lv_row, &rows, error)) {
+        g_hash_table_destroy (rows.lvs_by_name);
+        g_ptr_array_free (rows.lvs, TRUE);
+        return NULL;
     }
-
-    g_object_unref (parser);
+    g_hash_table_destroy (rows.lvs_by_name);
+    g_ptr_array_set_free_func (rows.lvs, NULL);
 
     /* returning NULL-terminated array of BDLVMLVdata */
-    g_ptr_array_add (lvs, NULL);
-    return (BDLVMLVdata **) g_ptr_array_free (lvs, FALSE);
+    g_ptr_array_add (rows.lvs, NULL);
+    return (BDLVMLVdata **) g_ptr_array_free (rows.lvs, FALSE);
 }
 
 /**
@@ -1822,57 +2886,190 @@ BDLVMLVdata** bd_lvm_lvs (const gchar *vg_name, GError **error) {
  * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
  */
 BDLVMLVdata** bd_lvm_lvs_tree (const gchar *vg_name, GError **error) {
+    return bd_lvm_lvs_tree_with_fields (vg_name, BD_LVM_QUERY_FIELDS_ALL, error);
+}
+
+/**
+ * bd_lvm_lvs_tree_with_fields:
+ * @vg_name: (nullable): name of the VG to get information about LVs from
+ * @fields: fields to get (a combination of #BDLVMQueryFields)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_lvs_tree(), but only the @fields are queried and filled in, the
+ * rest of the data is left unset (%NULL or 0). Names (including the VG name), UUIDs,
+ * segment type and the data_lvs, metadata_lvs and segs fields are always filled in.
+ *
+ * Returns: (array zero-terminated=1): information about LVs found in the given
+ * @vg_name VG or in system if @vg_name is %NULL.
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMLVdata** bd_lvm_lvs_tree_with_fields (const gchar *vg_name, BDLVMQueryFields fields, GError **error) {
     const gchar *args[11] = {"lvs", "--nosuffix", "--units=b",
                        "--reportformat", "json_std", "-a",
-                       "-o", "vg_name,lv_name,lv_uuid,lv_size,lv_attr,segtype,origin,pool_lv,data_lv,metadata_lv,lv_role,move_pv,data_percent,metadata_percent,copy_percent,lv_tags,devices,metadata_devices,seg_size_pe",
-                       NULL, NULL};
-    JsonParser *parser = NULL;
-    JsonArray *lv_array = NULL;
-    GPtrArray *lvs;
-    GError *l_error = NULL;
+                       "-o", NULL, NULL, NULL};
+    g_autofree gchar *columns = NULL;
+    LVRows rows = { NULL, NULL, TRUE };
 
-    lvs = g_ptr_array_new ();
+    /* segment type and sub-LVs are needed to put the tree together */
+    if (fields & BD_LVM_QUERY_FIELDS_ATTRS)
+        columns = get_report_columns (lv_columns, fields, "devices,metadata_devices,seg_size_pe");
+    else
+        columns = get_report_columns (lv_columns, fields, "segtype,data_lv,metadata_lv,devices,metadata_devices,seg_size_pe");
+    args[7] = columns;
 
     if (vg_name)
         args[8] = vg_name;
 
-    lv_array = call_lvm_and_parse_json_report (args, "lv", &parser, TRUE, &l_error);
-    if (!lv_array) {
-        if (l_error) {
-            g_propagate_error (error, l_error);
-            g_ptr_array_free (lvs, TRUE);
-            return NULL;
-        }
-        /* no output => no LVs, not an error */
-        g_ptr_array_add (lvs, NULL);
-        return (BDLVMLVdata **) g_ptr_array_free (lvs, FALSE);
+    rows.lvs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_lvdata_free);
+    /* LVs by "VG/LV" names, LV names are only unique within a VG */
+    rows.lvs_by_name = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+    if (!call_lvm_and_stream_json_report (args, "lv", add_lv_row, &rows, error)) {
+        g_hash_table_destroy (rows.lvs_by_name);
+        g_ptr_array_free (rows.lvs, TRUE);
+        return NULL;
     }
+    g_hash_table_destroy (rows.lvs_by_name);
+    g_ptr_array_set_free_func (rows.lvs, NULL);
 
-    for (guint i = 0; i < json_array_get_length (lv_array); i++) {
-        JsonObject *lv_obj = json_array_get_object_element (lv_array, i);
-        BDLVMLVdata *lvdata = get_lv_data_from_json (lv_obj);
-        if (lvdata) {
-            gboolean merged = FALSE;
-            for (gsize j = 0; j < lvs->len; j++) {
-                BDLVMLVdata *other = (BDLVMLVdata *) g_ptr_array_index (lvs, j);
-                if (g_strcmp0 (other->lv_name, lvdata->lv_name) == 0) {
-                    merge_lv_data (other, lvdata);
-                    bd_lvm_lvdata_free (lvdata);
-                    merged = TRUE;
-                    break;
-                }
-            }
+    /* returning NULL-terminated array of BDLVMLVdata */
+    g_ptr_array_add (rows.lvs, NULL);
+    return (BDLVMLVdata **) g_ptr_array_free (rows.lvs, FALSE);
+}
+
+typedef struct FullReportRows {
+    GPtrArray *pvs;
+    GPtrArray *vgs;
+    GPtrArray *lvs;
+    GHashTable *lvs_by_uuid;
+    GPtrArray *early_segs;
+} FullReportRows;
+
+/* segments are reported separately, one row per segment, and need to be merged
+   into their LVs (same as in bd_lvm_lvs_tree()), returns %FALSE if the LV of
+   @segdata hasn't been seen (yet) and @can_postpone is %TRUE, otherwise takes
+   the ownership of @segdata if @can_postpone is %TRUE */
+static gboolean add_full_report_seg (FullReportRows *rows, BDLVMLVdata *segdata, gboolean can_postpone) {
+    BDLVMLVdata *lvdata = segdata->uuid ? g_hash_table_lookup (rows->lvs_by_uuid, segdata->uuid) : NULL;
+
+    if (!lvdata && can_postpone)
+        return FALSE;
+
+    if (!lvdata) {
+        bd_utils_log_format (BD_UTILS_LOG_DEBUG,
+                             "Segment of an unknown LV '%s' found in LVM report", segdata->uuid);
+    } else if (!lvdata->segtype && !lvdata->segs && !lvdata->data_lvs) {
+        /* first segment of the LV */
+        lvdata->segtype = g_steal_pointer (&(segdata->segtype));
+        lvdata->segs = g_steal_pointer (&(segdata->segs));
+        lvdata->data_lvs = g_steal_pointer (&(segdata->data_lvs));
+        lvdata->metadata_lvs = g_steal_pointer (&(segdata->metadata_lvs));
+    } else
+        merge_lv_data (lvdata, segdata);
+
+    if (can_postpone)
+        bd_lvm_lvdata_free (segdata);
+    return TRUE;
+}
 
-            if (!merged)
-                g_ptr_array_add (lvs, lvdata);
+static void add_full_report_row (const gchar *section, JsonObject *row, gpointer user_data) {
+    FullReportRows *rows = (FullReportRows *) user_data;
+    BDLVMPVdata *pvdata = NULL;
+    BDLVMVGdata *vgdata = NULL;
+    BDLVMLVdata *lvdata = NULL;
+
+    if (g_strcmp0 (section, "vg") == 0) {
+        vgdata = get_vg_data_from_json (row);
+        if (vgdata && vgdata->name)
+            g_ptr_array_add (rows->vgs, vgdata);
+        else
+            bd_lvm_vgdata_free (vgdata);
+    } else if (g_strcmp0 (section, "pv") == 0) {
+        pvdata = get_pv_data_from_json (row);
+        if (pvdata)
+            g_ptr_array_add (rows->pvs, pvdata);
+    } else if (g_strcmp0 (section, "lv") == 0) {
+        lvdata = get_lv_data_from_json (row);
+        if (lvdata) {
+            g_ptr_array_add (rows->lvs, lvdata);
+            if (lvdata->uuid)
+                g_hash_table_insert (rows->lvs_by_uuid, lvdata->uuid, lvdata);
         }
+    } else if (g_strcmp0 (section, "seg") == 0) {
+        /* LVM reports segments after LVs, but let's not rely on that */
+        lvdata = get_lv_data_from_json (row);
+        if (lvdata && !add_full_report_seg (rows, lvdata, TRUE))
+            g_ptr_array_add (rows->early_segs, lvdata);
     }
+    /* other sections (e.g. "pvseg" or "log") are not interesting */
+}
 
-    g_object_unref (parser);
+/**
+ * bd_lvm_full_report:
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Gets information about all PVs, VGs and LVs (including their segments) in
+ * the system at once. This is much cheaper than calling bd_lvm_pvs(),
+ * bd_lvm_vgs() and bd_lvm_lvs_tree() one after another because the devices are
+ * scanned only once.
+ *
+ * Returns: (transfer full): information about PVs, VGs and LVs found in the
+ * system or %NULL in case of error (the @error) gets populated in those cases)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+BDLVMFullReport* bd_lvm_full_report (GError **error) {
+    const gchar *args[23] = {"fullreport", "--nosuffix", "--units=b",
+                       "--reportformat", "json_std", "-a",
+                       "--configreport", "pv",
+                       "-o", "pv_name,pv_uuid,pv_free,pv_size,pe_start,vg_name,vg_uuid,vg_size," \
+                       "vg_free,vg_extent_size,vg_extent_count,vg_free_count,pv_count,pv_tags,pv_missing",
+                       "--configreport", "vg",
+                       "-o", "vg_name,vg_uuid,vg_size,vg_free,vg_extent_size,vg_extent_count,vg_free_count,pv_count,vg_exported,vg_tags,vg_seqno",
+                       "--configreport", "lv",
+                       "-o", "vg_name,lv_name,lv_uuid,lv_size,lv_attr,origin,pool_lv,data_lv,metadata_lv,lv_role,move_pv,data_percent,metadata_percent,copy_percent,lv_tags",
+                       "--configreport", "seg",
+                       "-o", "lv_uuid,data_lv,metadata_lv,segtype,devices,metadata_devices,seg_size_pe",
+                       NULL};
+    FullReportRows rows = { NULL, NULL, NULL, NULL, NULL };
+    BDLVMFullReport *ret = NULL;
+
+    rows.pvs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_pvdata_free);
+    rows.vgs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_vgdata_free);
+    rows.lvs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_lvdata_free);
+    rows.lvs_by_uuid = g_hash_table_new (g_str_hash, g_str_equal);
+    rows.early_segs = g_ptr_array_new_with_free_func ((GDestroyNotify) bd_lvm_lvdata_free);
+
+    /* one report object per VG (and one for the orphan PVs), no output => no
+       PVs, VGs and LVs, not an error */
+    if (!call_lvm_and_stream_json_report (args, NULL, add_full_report_row, &rows, error)) {
+        g_ptr_array_free (rows.early_segs, TRUE);
+        g_hash_table_destroy (rows.lvs_by_uuid);
+        g_ptr_array_free (rows.lvs, TRUE);
+        g_ptr_array_free (rows.vgs, TRUE);
+        g_ptr_array_free (rows.pvs, TRUE);
+        return NULL;
+    }
 
-    /* returning NULL-terminated array of BDLVMLVdata */
-    g_ptr_array_add (lvs, NULL);
-    return (BDLVMLVdata **) g_ptr_array_free (lvs, FALSE);
+    for (guint i = 0; i < rows.early_segs->len; i++)
+        add_full_report_seg (&rows, g_ptr_array_index (rows.early_segs, i), FALSE);
+    g_ptr_array_free (rows.early_segs, TRUE);
+    g_hash_table_destroy (rows.lvs_by_uuid);
+
+    g_ptr_array_set_free_func (rows.pvs, NULL);
+    g_ptr_array_set_free_func (rows.vgs, NULL);
+    g_ptr_array_set_free_func (rows.lvs, NULL);
+    ret = g_new0 (BDLVMFullReport, 1);
+
+    g_ptr_array_add (rows.pvs, NULL);
+    ret->pvs = (BDLVMPVdata **) g_ptr_array_free (rows.pvs, FALSE);
+    g_ptr_array_add (rows.vgs, NULL);
+    ret->vgs = (BDLVMVGdata **) g_ptr_array_free (rows.vgs, FALSE);
+    g_ptr_array_add (rows.lvs, NULL);
+    ret->lvs = (BDLVMLVdata **) g_ptr_array_free (rows.lvs, FALSE);
+
+    return ret;
 }
 
 /**
@@ -2742,30 +3939,7 @@ gboolean bd_lvm_vdo_pool_resize (const gchar *vg_name, const gchar *pool_name, g
     return bd_lvm_lvresize (vg_name, pool_name, size, extra, error);
 }
 
-/**
- * bd_lvm_vdo_pool_convert:
- * @vg_name: name of the VG that contains @pool_lv
- * @pool_lv: name of the LV that should become the new VDO pool LV
- * @name: (nullable): name for the VDO LV or %NULL for default name
- * @virtual_size: virtual size for the new VDO LV
- * @index_memory: amount of index memory (in bytes) or 0 for default
- * @compression: whether to enable compression or not
- * @deduplication: whether to enable deduplication or not
- * @write_policy: write policy for the volume
- * @extra: (nullable) (array zero-terminated=1): extra options for the VDO pool creation
- *                                                 (just passed to LVM as is)
- * @error: (out) (optional): place to store error (if any)
- *
- * Converts the @pool_lv into a new VDO pool LV in the @vg_name VG and creates a new
- * @name VDO LV with size @virtual_size.
- *
- * Note: All data on @pool_lv will be irreversibly destroyed.
- *
- * Returns: whether the new VDO pool LV was successfully created from @pool_lv and or not
- *
- * Tech category: %BD_LVM_TECH_VDO-%BD_LVM_TECH_MODE_CREATE&%BD_LVM_TECH_MODE_MODIFY
- */
-gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name, guint64 virtual_size, guint64 index_memory, gboolean compression, gboolean deduplication, BDLVMVDOWritePolicy write_policy, const BDExtraArg **extra, GError **error) {
+static gboolean _vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name, guint64 virtual_size, guint64 index_memory, gboolean compression, gboolean deduplication, BDLVMVDOWritePolicy write_policy, const BDExtraArg **extra, BDLVMJob **job, GError **error) {
     const gchar *args[14] = {"lvconvert", "--yes", "--type", "vdo-pool",
                              "--compression", compression ? "y" : "n",
                              "--deduplication", deduplication ? "y" : "n",
@@ -2806,7 +3980,11 @@ gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, co
         global_config_str = g_strdup_printf ("%s allocation {vdo_write_policy=\"%s\"}", old_config ? old_config : "",
                                                                                         write_policy_str);
 
-    success = call_lvm_and_report_error (args, extra, FALSE, error);
+    if (job) {
+        *job = start_lvm_job (args, extra, FALSE, NULL, NULL, error);
+        success = *job != NULL;
+    } else
+        success = call_lvm_and_report_error (args, extra, FALSE, error);
 
     g_free (global_config_str);
     global_config_str = old_config;
@@ -2818,6 +3996,65 @@ gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, co
     return success;
 }
 
+/**
+ * bd_lvm_vdo_pool_convert:
+ * @vg_name: name of the VG that contains @pool_lv
+ * @pool_lv: name of the LV that should become the new VDO pool LV
+ * @name: (nullable): name for the VDO LV or %NULL for default name
+ * @virtual_size: virtual size for the new VDO LV
+ * @index_memory: amount of index memory (in bytes) or 0 for default
+ * @compression: whether to enable compression or not
+ * @deduplication: whether to enable deduplication or not
+ * @write_policy: write policy for the volume
+ * @extra: (nullable) (array zero-terminated=1): extra options for the VDO pool creation
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Converts the @pool_lv into a new VDO pool LV in the @vg_name VG and creates a new
+ * @name VDO LV with size @virtual_size.
+ *
+ * Note: All data on @pool_lv will be irreversibly destroyed.
+ *
+ * Returns: whether the new VDO pool LV was successfully created from @pool_lv and or not
+ *
+ * Tech category: %BD_LVM_TECH_VDO-%BD_LVM_TECH_MODE_CREATE&%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name, guint64 virtual_size, guint64 index_memory, gboolean compression, gboolean deduplication, BDLVMVDOWritePolicy write_policy, const BDExtraArg **extra, GError **error) {
+    return _vdo_pool_convert (vg_name, pool_lv, name, virtual_size, index_memory, compression, deduplication,
+                              write_policy, extra, NULL, error);
+}
+
+/**
+ * bd_lvm_vdo_pool_convert_start:
+ * @vg_name: name of the VG that contains @pool_lv
+ * @pool_lv: name of the LV that should become the new VDO pool LV
+ * @name: (nullable): name for the VDO LV or %NULL for default name
+ * @virtual_size: virtual size for the new VDO LV
+ * @index_memory: amount of index memory (in bytes) or 0 for default
+ * @compression: whether to enable compression or not
+ * @deduplication: whether to enable deduplication or not
+ * @write_policy: write policy for the volume
+ * @extra: (nullable) (array zero-terminated=1): extra options for the VDO pool creation
+ *                                                 (just passed to LVM as is)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Same as bd_lvm_vdo_pool_convert(), but doesn't wait for the conversion to finish.
+ *
+ * Note: All data on @pool_lv will be irreversibly destroyed.
+ *
+ * Returns: (transfer full): a handle of the started conversion or %NULL in case
+ *                           it failed to start (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_VDO-%BD_LVM_TECH_MODE_CREATE&%BD_LVM_TECH_MODE_MODIFY
+ */
+BDLVMJob* bd_lvm_vdo_pool_convert_start (const gchar *vg_name, const gchar *pool_lv, const gchar *name, guint64 virtual_size, guint64 index_memory, gboolean compression, gboolean deduplication, BDLVMVDOWritePolicy write_policy, const BDExtraArg **extra, GError **error) {
+    BDLVMJob *job = NULL;
+
+    _vdo_pool_convert (vg_name, pool_lv, name, virtual_size, index_memory, compression, deduplication,
+                       write_policy, extra, &job, error);
+    return job;
+}
+
 /**
  * bd_lvm_vdolvpoolname:
  * @vg_name: name of the VG containing the queried VDO LV
@@ -2844,3 +4081,147 @@ gchar* bd_lvm_vdolvpoolname (const gchar *vg_name, const gchar *lv_name, GError
 
     return g_strstrip (output);
 }
+
+/**
+ * bd_lvm_job_get_progress:
+ * @job: LVM job to get the progress of
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: progress of the @job in percents (only reported by some operations,
+ *          e.g. a PV move, the other ones report 0 until they finish) or -1 in
+ *          case of error
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gdouble bd_lvm_job_get_progress (BDLVMJob *job, GError **error) {
+    LVMCLIJob *cli_job = (LVMCLIJob *) job->priv;
+    GError *l_error = NULL;
+    gdouble progress = 0;
+
+    /* process the output produced so far (if any) */
+    lvm_cli_jobs_wait (&cli_job, 1, 0, &l_error);
+    if (l_error) {
+        g_propagate_error (error, l_error);
+        return -1;
+    }
+
+    g_mutex_lock (&(cli_job->lock));
+    progress = cli_job->progress;
+    g_mutex_unlock (&(cli_job->lock));
+
+    return progress;
+}
+
+/**
+ * bd_lvm_job_wait:
+ * @job: LVM job to wait for
+ * @timeout: how long to wait for the @job to finish (in milliseconds, 0 to
+ *           not wait at all, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: %TRUE if the @job finished successfully, %FALSE if it failed (@error
+ *          is set to the error of the operation in that case) or if it didn't
+ *          finish in @timeout (@error is not set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gboolean bd_lvm_job_wait (BDLVMJob *job, gint timeout, GError **error) {
+    LVMCLIJob *cli_job = (LVMCLIJob *) job->priv;
+
+    gboolean ret = TRUE;
+
+    if (lvm_cli_jobs_wait (&cli_job, 1, timeout, error) != 0)
+        return FALSE;
+
+    g_mutex_lock (&(cli_job->lock));
+    if (cli_job->error) {
+        g_propagate_error (error, g_error_copy (cli_job->error));
+        ret = FALSE;
+    }
+    g_mutex_unlock (&(cli_job->lock));
+
+    return ret;
+}
+
+/**
+ * bd_lvm_job_wait_any:
+ * @jobs: (array zero-terminated=1): LVM jobs to wait for
+ * @timeout: how long to wait for any of the @jobs to finish (in milliseconds,
+ *           0 to not wait at all, -1 to wait indefinitely)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Waits for any of the @jobs to finish. Jobs that already finished count too
+ * so the finished jobs should be removed from @jobs before the next call. Use
+ * bd_lvm_job_wait() with @timeout 0 to get the result of the finished job.
+ *
+ * The outputs of all the lvm processes are polled at once, no extra threads
+ * are needed.
+ *
+ * Returns: index of a finished job in @jobs or -1 if none of them finished in
+ *          @timeout or in case of error (@error is set in that case)
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_QUERY
+ */
+gint bd_lvm_job_wait_any (BDLVMJob **jobs, gint timeout, GError **error) {
+    LVMCLIJob **cli_jobs = NULL;
+    guint n_jobs = 0;
+    gint ret = -1;
+
+    for (n_jobs=0; jobs && jobs[n_jobs]; n_jobs++);
+    if (n_jobs == 0) {
+        g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                             "No jobs to wait for");
+        return -1;
+    }
+
+    cli_jobs = g_new0 (LVMCLIJob *, n_jobs);
+    for (n_jobs=0; jobs[n_jobs]; n_jobs++)
+        cli_jobs[n_jobs] = (LVMCLIJob *) jobs[n_jobs]->priv;
+
+    ret = lvm_cli_jobs_wait (cli_jobs, n_jobs, timeout, error);
+    g_free (cli_jobs);
+
+    return ret;
+}
+
+/**
+ * bd_lvm_job_cancel:
+ * @job: LVM job to cancel
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Requests cancellation of the @job. The @job still needs to be waited for to
+ * find out when it actually stops. A PV move is aborted with 'pvmove --abort'
+ * (see pvmove(8) for what happens with the extents moved so far), other
+ * operations are interrupted with SIGINT sent to the lvm process and all the
+ * processes it started.
+ *
+ * Returns: whether the cancellation was successfully requested or not
+ *
+ * Tech category: %BD_LVM_TECH_BASIC-%BD_LVM_TECH_MODE_MODIFY
+ */
+gboolean bd_lvm_job_cancel (BDLVMJob *job, GError **error) {
+    LVMCLIJob *cli_job = (LVMCLIJob *) job->priv;
+    gboolean finished = FALSE;
+
+    g_mutex_lock (&(cli_job->lock));
+    finished = cli_job->finished;
+    if (!finished && !cli_job->cancel_args && lvm_cli_job_signal (cli_job, SIGINT) != 0) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                     "Failed to interrupt the '%s' process: %m", cli_job->cmd);
+        g_mutex_unlock (&(cli_job->lock));
+        return FALSE;
+    }
+    g_mutex_unlock (&(cli_job->lock));
+
+    if (finished) {
+        g_set_error (error, BD_LVM_ERROR, BD_LVM_ERROR_FAIL,
+                     "The '%s' process already finished", cli_job->cmd);
+        return FALSE;
+    }
+
+    if (cli_job->cancel_args)
+        /* cancel_args never change, the lock is not needed for this */
+        return call_lvm_and_report_error ((const gchar **) cli_job->cancel_args, NULL, TRUE, error);
+
+    return TRUE;
+}
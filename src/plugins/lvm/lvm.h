@@ -70,6 +70,35 @@ typedef enum {
     BD_LVM_VDO_WRITE_POLICY_ASYNC,
 } BDLVMVDOWritePolicy;
 
+typedef enum {
+    BD_LVM_QUERY_FIELDS_BASIC =   0,
+    BD_LVM_QUERY_FIELDS_SIZE =    1 << 0,
+    BD_LVM_QUERY_FIELDS_ATTRS =   1 << 1,
+    BD_LVM_QUERY_FIELDS_TAGS =    1 << 2,
+    BD_LVM_QUERY_FIELDS_VG =      1 << 3,
+    BD_LVM_QUERY_FIELDS_STATUS =  1 << 4,
+    BD_LVM_QUERY_FIELDS_ALL =     (1 << 5) - 1,
+} BDLVMQueryFields;
+
+typedef enum {
+    BD_LVM_THPOOL_MODE_UNKNOWN,
+    BD_LVM_THPOOL_MODE_READ_WRITE,
+    BD_LVM_THPOOL_MODE_READ_ONLY,
+    BD_LVM_THPOOL_MODE_OUT_OF_DATA_SPACE,
+    BD_LVM_THPOOL_MODE_FAIL,
+} BDLVMThPoolMode;
+
+typedef enum {
+    BD_LVM_EVENT_VG_ADDED,
+    BD_LVM_EVENT_VG_REMOVED,
+    BD_LVM_EVENT_VG_CHANGED,
+    BD_LVM_EVENT_LV_ADDED,
+    BD_LVM_EVENT_LV_REMOVED,
+    BD_LVM_EVENT_LV_RESIZED,
+    BD_LVM_EVENT_LV_ACTIVATED,
+    BD_LVM_EVENT_LV_DEACTIVATED,
+} BDLVMEventType;
+
 typedef struct BDLVMPVdata {
     gchar *pv_name;
     gchar *pv_uuid;
@@ -102,6 +131,7 @@ typedef struct BDLVMVGdata {
     guint64 pv_count;
     gboolean exported;
     gchar **vg_tags;
+    guint64 seqno;
 } BDLVMVGdata;
 
 void bd_lvm_vgdata_free (BDLVMVGdata *data);
@@ -188,6 +218,156 @@ typedef struct BDLVMCacheStats {
 void bd_lvm_cache_stats_free (BDLVMCacheStats *data);
 BDLVMCacheStats* bd_lvm_cache_stats_copy (BDLVMCacheStats *data);
 
+typedef struct BDLVMWritecacheStats {
+    guint64 block_size;
+    guint64 cache_size;
+    guint64 cache_used;
+    guint64 total_blocks;
+    guint64 free_blocks;
+    guint64 writeback_blocks;
+    guint64 error;
+} BDLVMWritecacheStats;
+
+void bd_lvm_writecache_stats_free (BDLVMWritecacheStats *data);
+BDLVMWritecacheStats* bd_lvm_writecache_stats_copy (BDLVMWritecacheStats *data);
+
+typedef struct BDLVMRAIDStats {
+    gchar *raid_type;
+    guint64 dev_count;
+    gchar *dev_health;
+    guint64 total_regions;
+    guint64 insync_regions;
+    gdouble sync_ratio;
+    gchar *sync_action;
+    guint64 mismatch_count;
+} BDLVMRAIDStats;
+
+void bd_lvm_raid_stats_free (BDLVMRAIDStats *data);
+BDLVMRAIDStats* bd_lvm_raid_stats_copy (BDLVMRAIDStats *data);
+
+typedef struct BDLVMThPoolStats {
+    guint64 transaction_id;
+    guint64 block_size;
+    guint64 data_size;
+    guint64 data_used;
+    guint64 data_total_blocks;
+    guint64 data_used_blocks;
+    guint64 md_block_size;
+    guint64 md_size;
+    guint64 md_used;
+    guint64 md_total_blocks;
+    guint64 md_used_blocks;
+    guint64 held_md_root;
+    gboolean needs_check;
+    gboolean error_if_no_space;
+    BDLVMThPoolMode mode;
+} BDLVMThPoolStats;
+
+void bd_lvm_thpool_stats_free (BDLVMThPoolStats *data);
+BDLVMThPoolStats* bd_lvm_thpool_stats_copy (BDLVMThPoolStats *data);
+
+typedef struct BDLVMThLVStats {
+    guint64 mapped_size;
+    guint64 highest_mapped;
+    gboolean failed;
+} BDLVMThLVStats;
+
+void bd_lvm_thlv_stats_free (BDLVMThLVStats *data);
+BDLVMThLVStats* bd_lvm_thlv_stats_copy (BDLVMThLVStats *data);
+
+typedef struct BDLVMFullReport {
+    BDLVMPVdata **pvs;
+    BDLVMVGdata **vgs;
+    BDLVMLVdata **lvs;
+} BDLVMFullReport;
+
+void bd_lvm_full_report_free (BDLVMFullReport *report);
+BDLVMFullReport* bd_lvm_full_report_copy (BDLVMFullReport *report);
+
+typedef struct BDLVMStateSnapshot {
+    BDLVMPVdata **pvs;
+    BDLVMVGdata **vgs;
+    BDLVMLVdata **lvs;
+
+    /*< private >*/
+    gint ref_count;
+    GHashTable *pvs_by_uuid;
+    GHashTable *pvs_by_path;
+    GHashTable *vgs_by_uuid;
+    GHashTable *vgs_by_name;
+    GHashTable *lvs_by_uuid;
+    GHashTable *lvs_by_name;
+    GHashTable *lvs_by_path;
+    GHashTable *lvs_by_pv;
+} BDLVMStateSnapshot;
+
+void bd_lvm_state_snapshot_free (BDLVMStateSnapshot *snapshot);
+BDLVMStateSnapshot* bd_lvm_state_snapshot_copy (BDLVMStateSnapshot *snapshot);
+
+typedef struct BDLVMEvent {
+    BDLVMEventType type;
+    gchar *vg_name;
+    gchar *lv_name;
+    guint64 old_size;
+    guint64 new_size;
+} BDLVMEvent;
+
+void bd_lvm_event_free (BDLVMEvent *data);
+BDLVMEvent* bd_lvm_event_copy (BDLVMEvent *data);
+
+typedef struct BDLVMWatcher {
+    /*< private >*/
+    gint ref_count;
+    gpointer priv;
+    GDestroyNotify priv_free;
+} BDLVMWatcher;
+
+void bd_lvm_watcher_free (BDLVMWatcher *watcher);
+BDLVMWatcher* bd_lvm_watcher_copy (BDLVMWatcher *watcher);
+
+typedef struct BDLVMJob {
+    /*< private >*/
+    gint ref_count;
+    gpointer priv;
+    GDestroyNotify priv_free;
+} BDLVMJob;
+
+void bd_lvm_job_free (BDLVMJob *job);
+BDLVMJob* bd_lvm_job_copy (BDLVMJob *job);
+
+typedef struct BDLVMLVSpec {
+    gchar *lv_name;
+    guint64 size;
+    gchar *type;
+    gchar **pv_list;
+    gchar *pool_name;
+} BDLVMLVSpec;
+
+void bd_lvm_lvspec_free (BDLVMLVSpec *data);
+BDLVMLVSpec* bd_lvm_lvspec_copy (BDLVMLVSpec *data);
+
+typedef struct BDLVMBatchResult {
+    gchar *lv_name;
+    gboolean success;
+    gchar *error_message;
+} BDLVMBatchResult;
+
+void bd_lvm_batch_result_free (BDLVMBatchResult *data);
+BDLVMBatchResult* bd_lvm_batch_result_copy (BDLVMBatchResult *data);
+
+typedef struct BDLVMDBusCacheStats {
+    gboolean enabled;
+    guint64 n_objects;
+    guint64 hits;
+    guint64 misses;
+    guint64 stale;
+    guint64 refreshes;
+    guint64 updates;
+} BDLVMDBusCacheStats;
+
+void bd_lvm_dbus_cache_stats_free (BDLVMDBusCacheStats *data);
+BDLVMDBusCacheStats* bd_lvm_dbus_cache_stats_copy (BDLVMDBusCacheStats *data);
+
 typedef enum {
     BD_LVM_TECH_BASIC = 0,
     BD_LVM_TECH_BASIC_SNAP,
@@ -223,6 +403,7 @@ typedef enum {
  */
 gboolean bd_lvm_init (void);
 void bd_lvm_close (void);
+void bd_lvm_prewarm_deps (void);
 
 gboolean bd_lvm_is_tech_avail (BDLVMTech tech, guint64 mode, GError **error);
 
@@ -240,11 +421,13 @@ gboolean bd_lvm_pvcreate (const gchar *device, guint64 data_alignment, guint64 m
 gboolean bd_lvm_pvresize (const gchar *device, guint64 size, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_pvremove (const gchar *device, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_pvmove (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error);
+BDLVMJob* bd_lvm_pvmove_start (const gchar *src, const gchar *dest, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_pvscan (const gchar *device, gboolean update_cache, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_add_pv_tags (const gchar *device, const gchar **tags, GError **error);
 gboolean bd_lvm_delete_pv_tags (const gchar *device, const gchar **tags, GError **error);
 BDLVMPVdata* bd_lvm_pvinfo (const gchar *device, GError **error);
 BDLVMPVdata** bd_lvm_pvs (GError **error);
+BDLVMPVdata** bd_lvm_pvs_with_fields (BDLVMQueryFields fields, GError **error);
 
 gboolean bd_lvm_vgcreate (const gchar *name, const gchar **pv_list, guint64 pe_size, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_vgremove (const gchar *vg_name, const BDExtraArg **extra, GError **error);
@@ -261,12 +444,16 @@ gboolean bd_lvm_vgcfgbackup (const gchar *vg_name, const gchar *backup_file, con
 gboolean bd_lvm_vgcfgrestore (const gchar *vg_name, const gchar *backup_file, const BDExtraArg **extra, GError **error);
 BDLVMVGdata* bd_lvm_vginfo (const gchar *vg_name, GError **error);
 BDLVMVGdata** bd_lvm_vgs (GError **error);
+BDLVMVGdata** bd_lvm_vgs_with_fields (BDLVMQueryFields fields, GError **error);
 
 gchar* bd_lvm_lvorigin (const gchar *vg_name, const gchar *lv_name, GError **error);
 gboolean bd_lvm_lvcreate (const gchar *vg_name, const gchar *lv_name, guint64 size, const gchar *type, const gchar **pv_list, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_lvremove (const gchar *vg_name, const gchar *lv_name, gboolean force, const BDExtraArg **extra, GError **error);
+BDLVMBatchResult** bd_lvm_lvcreate_many (const gchar *vg_name, BDLVMLVSpec **specs, const BDExtraArg **extra, GError **error);
+BDLVMBatchResult** bd_lvm_lvremove_many (const gchar *vg_name, const gchar **lv_names, gboolean force, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_lvrename (const gchar *vg_name, const gchar *lv_name, const gchar *new_name, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_lvresize (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error);
+BDLVMJob* bd_lvm_lvresize_start (const gchar *vg_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_lvrepair (const gchar *vg_name, const gchar *lv_name, const gchar **pv_list, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_lvactivate (const gchar *vg_name, const gchar *lv_name, gboolean ignore_skip, gboolean shared, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_lvdeactivate (const gchar *vg_name, const gchar *lv_name, const BDExtraArg **extra, GError **error);
@@ -277,18 +464,43 @@ gboolean bd_lvm_delete_lv_tags (const gchar *vg_name, const gchar *lv_name, cons
 BDLVMLVdata* bd_lvm_lvinfo (const gchar *vg_name, const gchar *lv_name, GError **error);
 BDLVMLVdata* bd_lvm_lvinfo_tree (const gchar *vg_name, const gchar *lv_name, GError **error);
 BDLVMLVdata** bd_lvm_lvs (const gchar *vg_name, GError **error);
+BDLVMLVdata** bd_lvm_lvs_with_fields (const gchar *vg_name, BDLVMQueryFields fields, GError **error);
 BDLVMLVdata** bd_lvm_lvs_tree (const gchar *vg_name, GError **error);
+BDLVMLVdata** bd_lvm_lvs_tree_with_fields (const gchar *vg_name, BDLVMQueryFields fields, GError **error);
+BDLVMFullReport* bd_lvm_full_report (GError **error);
+BDLVMStateSnapshot* bd_lvm_state_snapshot_new (GError **error);
+BDLVMPVdata* bd_lvm_state_snapshot_get_pv (BDLVMStateSnapshot *snapshot, const gchar *device, GError **error);
+BDLVMVGdata* bd_lvm_state_snapshot_get_vg (BDLVMStateSnapshot *snapshot, const gchar *vg_name, GError **error);
+BDLVMLVdata* bd_lvm_state_snapshot_get_lv (BDLVMStateSnapshot *snapshot, const gchar *vg_name, const gchar *lv_name, GError **error);
+BDLVMLVdata** bd_lvm_state_snapshot_get_pv_lvs (BDLVMStateSnapshot *snapshot, const gchar *device, GError **error);
+BDLVMWatcher* bd_lvm_watcher_new (GError **error);
+gint bd_lvm_watcher_get_fd (BDLVMWatcher *watcher, GError **error);
+BDLVMEvent** bd_lvm_watcher_process (BDLVMWatcher *watcher, gint timeout, GError **error);
+BDLVMVGdata** bd_lvm_watcher_get_vgs (BDLVMWatcher *watcher, GError **error);
+BDLVMLVdata** bd_lvm_watcher_get_lvs (BDLVMWatcher *watcher, const gchar *vg_name, GError **error);
+
+gdouble bd_lvm_job_get_progress (BDLVMJob *job, GError **error);
+gboolean bd_lvm_job_wait (BDLVMJob *job, gint timeout, GError **error);
+gint bd_lvm_job_wait_any (BDLVMJob **jobs, gint timeout, GError **error);
+gboolean bd_lvm_job_cancel (BDLVMJob *job, GError **error);
 
 gboolean bd_lvm_thpoolcreate (const gchar *vg_name, const gchar *lv_name, guint64 size, guint64 md_size, guint64 chunk_size, const gchar *profile, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_thlvcreate (const gchar *vg_name, const gchar *pool_name, const gchar *lv_name, guint64 size, const BDExtraArg **extra, GError **error);
 gchar* bd_lvm_thlvpoolname (const gchar *vg_name, const gchar *lv_name, GError **error);
 gboolean bd_lvm_thsnapshotcreate (const gchar *vg_name, const gchar *origin_name, const gchar *snapshot_name, const gchar *pool_name, const BDExtraArg **extra, GError **error);
+BDLVMThPoolStats* bd_lvm_thpool_stats (const gchar *vg_name, const gchar *pool_name, GError **error);
+BDLVMThLVStats* bd_lvm_thlv_stats (const gchar *vg_name, const gchar *thlv_name, GError **error);
 
 gboolean bd_lvm_set_global_config (const gchar *new_config, GError **error);
 gchar* bd_lvm_get_global_config (GError **error);
 
 gboolean bd_lvm_set_devices_filter (const gchar **devices, GError **error);
 gchar** bd_lvm_get_devices_filter (GError **error);
+gboolean bd_lvm_set_shell_mode (gboolean enabled, GError **error);
+gboolean bd_lvm_get_shell_mode (GError **error);
+gboolean bd_lvm_set_dbus_cache (gboolean enabled, GError **error);
+gboolean bd_lvm_get_dbus_cache (GError **error);
+BDLVMDBusCacheStats* bd_lvm_get_dbus_cache_stats (GError **error);
 
 guint64 bd_lvm_cache_get_default_md_size (guint64 cache_size, GError **error);
 const gchar* bd_lvm_cache_get_mode_str (BDLVMCacheMode mode, GError **error);
@@ -300,6 +512,8 @@ gboolean bd_lvm_cache_create_cached_lv (const gchar *vg_name, const gchar *lv_na
                                         const gchar **slow_pvs, const gchar **fast_pvs, GError **error);
 gchar* bd_lvm_cache_pool_name (const gchar *vg_name, const gchar *cached_lv, GError **error);
 BDLVMCacheStats* bd_lvm_cache_stats (const gchar *vg_name, const gchar *cached_lv, GError **error);
+BDLVMWritecacheStats* bd_lvm_writecache_stats (const gchar *vg_name, const gchar *cached_lv, GError **error);
+BDLVMRAIDStats* bd_lvm_raid_stats (const gchar *vg_name, const gchar *lv_name, GError **error);
 
 gboolean bd_lvm_writecache_attach (const gchar *vg_name, const gchar *data_lv, const gchar *cache_lv, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_writecache_detach (const gchar *vg_name, const gchar *cached_lv, gboolean destroy, const BDExtraArg **extra, GError **error);
@@ -319,6 +533,7 @@ gboolean bd_lvm_vdo_disable_deduplication (const gchar *vg_name, const gchar *po
 gboolean bd_lvm_thpool_convert (const gchar *vg_name, const gchar *data_lv, const gchar *metadata_lv, const gchar *name, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_cache_pool_convert (const gchar *vg_name, const gchar *data_lv, const gchar *metadata_lv, const gchar *name, const BDExtraArg **extra, GError **error);
 gboolean bd_lvm_vdo_pool_convert (const gchar *vg_name, const gchar *pool_lv, const gchar *name, guint64 virtual_size, guint64 index_memory, gboolean compression, gboolean deduplication, BDLVMVDOWritePolicy write_policy, const BDExtraArg **extra, GError **error);
+BDLVMJob* bd_lvm_vdo_pool_convert_start (const gchar *vg_name, const gchar *pool_lv, const gchar *name, guint64 virtual_size, guint64 index_memory, gboolean compression, gboolean deduplication, BDLVMVDOWritePolicy write_policy, const BDExtraArg **extra, GError **error);
 gchar* bd_lvm_vdolvpoolname (const gchar *vg_name, const gchar *lv_name, GError **error);
 
 const gchar* bd_lvm_get_vdo_operating_mode_str (BDLVMVDOOperatingMode mode, GError **error);
@@ -24,6 +24,7 @@
 
 #include "vdo_stats.h"
 #include "lvm.h"
+#include "probes.h"
 
 
 G_GNUC_INTERNAL gboolean
@@ -172,7 +173,7 @@ vdo_get_stats_full (const gchar *name, GError **error) {
         return NULL;
     }
 
-    if (!dm_task_run (dmt)) {
+    if (!BD_PROBE_CALL (dm_task_run, dm_task_run (dmt))) {
         g_set_error_literal (error, BD_LVM_ERROR, BD_LVM_ERROR_DM_ERROR,
                              "Failed to run DM task");
         dm_task_destroy (dmt);
@@ -183,6 +183,18 @@ void bd_md_close (void) {
     g_atomic_int_set (&avail_deps, 0);
 }
 
+/**
+ * bd_md_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_md_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+}
+
 
 /**
  * bd_md_is_tech_avail:
@@ -80,6 +80,7 @@ typedef enum {
  */
 gboolean bd_md_init (void);
 void bd_md_close (void);
+void bd_md_prewarm_deps (void);
 
 gboolean bd_md_is_tech_avail (BDMDTech tech, guint64 mode, GError **error);
 
@@ -26,6 +26,7 @@
 
 #include "mpath.h"
 #include "check_deps.h"
+#include "probes.h"
 
 #define MULTIPATH_MIN_VERSION "0.4.9"
 
@@ -84,6 +85,18 @@ void bd_mpath_close (void) {
     g_atomic_int_set (&avail_deps, 0);
 }
 
+/**
+ * bd_mpath_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_mpath_prewarm_deps (void) {
+    check_deps (&avail_deps, ALL_DEPS_MASK (DEPS_LAST), deps, DEPS_LAST, &deps_check_lock, NULL);
+}
+
 /**
  * bd_mpath_is_tech_avail:
  * @tech: the queried tech
@@ -211,7 +224,7 @@ static gboolean map_is_multipath (const gchar *map_name, GError **error) {
         return FALSE;
     }
 
-    if (dm_task_run (task) == 0) {
+    if (BD_PROBE_CALL (dm_task_run, dm_task_run (task)) == 0) {
         g_set_error_literal (error, BD_MPATH_ERROR, BD_MPATH_ERROR_DM_ERROR,
                              "Failed to run DM task");
         dm_task_destroy (task);
@@ -260,7 +273,7 @@ static gchar** get_map_deps (const gchar *map_name, guint64 *n_deps, GError **er
         return NULL;
     }
 
-    if (dm_task_run (task) == 0) {
+    if (BD_PROBE_CALL (dm_task_run, dm_task_run (task)) == 0) {
         g_set_error_literal (error, BD_MPATH_ERROR, BD_MPATH_ERROR_DM_ERROR,
                              "Failed to run DM task");
         dm_task_destroy (task);
@@ -330,7 +343,7 @@ gboolean bd_mpath_is_mpath_member (const gchar *device, GError **error) {
         return FALSE;
     }
 
-    dm_task_run (task_names);
+    (void) BD_PROBE_CALL (dm_task_run, dm_task_run (task_names));
     names = dm_task_get_names (task_names);
 
     if (!names || !names->dev) {
@@ -429,7 +442,7 @@ gchar** bd_mpath_get_mpath_members (GError **error) {
         return NULL;
     }
 
-    dm_task_run (task_names);
+    (void) BD_PROBE_CALL (dm_task_run, dm_task_run (task_names));
     names = dm_task_get_names (task_names);
 
     if (!names || !names->dev) {
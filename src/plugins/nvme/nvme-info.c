@@ -33,6 +33,7 @@
 #include <check_deps.h>
 #include "nvme.h"
 #include "nvme-private.h"
+#include "probes.h"
 
 
 /**
@@ -484,7 +485,7 @@ BDNVMEControllerInfo * bd_nvme_get_controller_info (const gchar *device, GError
         return NULL;
     }
     /* send the NVME_IDENTIFY_CNS_CTRL ioctl */
-    ret = nvme_identify_ctrl (fd, ctrl_id);
+    ret = BD_PROBE_CALL (nvme_identify_ctrl, nvme_identify_ctrl (fd, ctrl_id));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Identify Controller command error: ");
@@ -614,7 +615,7 @@ BDNVMENamespaceInfo *bd_nvme_get_namespace_info (const gchar *device, GError **e
         return NULL;
 
     /* get Namespace Identifier (NSID) for the @device (NVME_IOCTL_ID) */
-    ret = nvme_get_nsid (fd, &nsid);
+    ret = BD_PROBE_CALL (nvme_get_nsid, nvme_get_nsid (fd, &nsid));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "Error getting Namespace Identifier (NSID): ");
@@ -628,7 +629,7 @@ BDNVMENamespaceInfo *bd_nvme_get_namespace_info (const gchar *device, GError **e
         close (fd);
         return NULL;
     }
-    ret = nvme_identify_ns (fd, nsid, ns_info);
+    ret = BD_PROBE_CALL (nvme_identify_ns, nvme_identify_ns (fd, nsid, ns_info));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Identify Namespace command error: ");
@@ -644,20 +645,20 @@ BDNVMENamespaceInfo *bd_nvme_get_namespace_info (const gchar *device, GError **e
         free (ns_info);
         return NULL;
     }
-    ret_ctrl = nvme_identify_ctrl (fd, ctrl_id);
+    ret_ctrl = BD_PROBE_CALL (nvme_identify_ctrl, nvme_identify_ctrl (fd, ctrl_id));
 
     /* send the NVME_IDENTIFY_CNS_NS_DESC_LIST ioctl, NVMe 1.3 */
     if (ret_ctrl == 0 && GUINT32_FROM_LE (ctrl_id->ver) >= 0x10300) {
         descs = _nvme_alloc (NVME_IDENTIFY_DATA_SIZE, NULL);
         if (descs != NULL)
-            ret_desc = nvme_identify_ns_descs (fd, nsid, descs);
+            ret_desc = BD_PROBE_CALL (nvme_identify_ns_descs, nvme_identify_ns_descs (fd, nsid, descs));
     }
 
     /* send the NVME_IDENTIFY_CNS_CSI_INDEPENDENT_ID_NS ioctl, NVMe 2.0 */
     if (ret_ctrl == 0 && GUINT32_FROM_LE (ctrl_id->ver) >= 0x20000) {
         ns_info_ind = _nvme_alloc (sizeof (struct nvme_id_independent_id_ns), NULL);
         if (ns_info_ind != NULL)
-            ret_ns_ind = nvme_identify_independent_identify_ns (fd, nsid, ns_info_ind);
+            ret_ns_ind = BD_PROBE_CALL (nvme_identify_independent_identify_ns, nvme_identify_independent_identify_ns (fd, nsid, ns_info_ind));
     }
     close (fd);
 
@@ -781,7 +782,7 @@ BDNVMESmartLog * bd_nvme_get_smart_log (const gchar *device, GError **error) {
         close (fd);
         return NULL;
     }
-    ret_identify = nvme_identify_ctrl (fd, ctrl_id);
+    ret_identify = BD_PROBE_CALL (nvme_identify_ctrl, nvme_identify_ctrl (fd, ctrl_id));
     if (ret_identify != 0) {
         _nvme_status_to_error (ret_identify, FALSE, error);
         g_prefix_error (error, "NVMe Identify Controller command error: ");
@@ -797,7 +798,7 @@ BDNVMESmartLog * bd_nvme_get_smart_log (const gchar *device, GError **error) {
         free (ctrl_id);
         return NULL;
     }
-    ret = nvme_get_log_smart (fd, NVME_NSID_ALL, FALSE /* rae */, smart_log);
+    ret = BD_PROBE_CALL (nvme_get_log_smart, nvme_get_log_smart (fd, NVME_NSID_ALL, FALSE /* rae */, smart_log));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Get Log Page - SMART / Health Information Log command error: ");
@@ -893,7 +894,7 @@ BDNVMEErrorLogEntry ** bd_nvme_get_error_log_entries (const gchar *device, GErro
         close (fd);
         return NULL;
     }
-    ret = nvme_identify_ctrl (fd, ctrl_id);
+    ret = BD_PROBE_CALL (nvme_identify_ctrl, nvme_identify_ctrl (fd, ctrl_id));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Identify Controller command error: ");
@@ -911,7 +912,7 @@ BDNVMEErrorLogEntry ** bd_nvme_get_error_log_entries (const gchar *device, GErro
         close (fd);
         return NULL;
     }
-    ret = nvme_get_log_error (fd, elpe, FALSE /* rae */, err_log);
+    ret = BD_PROBE_CALL (nvme_get_log_error, nvme_get_log_error (fd, elpe, FALSE /* rae */, err_log));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Get Log Page - Error Information Log Entry command error: ");
@@ -980,7 +981,7 @@ BDNVMESelfTestLog * bd_nvme_get_self_test_log (const gchar *device, GError **err
         close (fd);
         return NULL;
     }
-    ret = nvme_get_log_device_self_test (fd, self_test_log);
+    ret = BD_PROBE_CALL (nvme_get_log_device_self_test, nvme_get_log_device_self_test (fd, self_test_log));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Get Log Page - Device Self-test Log command error: ");
@@ -1127,7 +1128,7 @@ BDNVMESanitizeLog * bd_nvme_get_sanitize_log (const gchar *device, GError **erro
         close (fd);
         return NULL;
     }
-    ret = nvme_get_log_sanitize (fd, FALSE /* rae */, sanitize_log);
+    ret = BD_PROBE_CALL (nvme_get_log_sanitize, nvme_get_log_sanitize (fd, FALSE /* rae */, sanitize_log));
     if (ret != 0) {
         _nvme_status_to_error (ret, FALSE, error);
         g_prefix_error (error, "NVMe Get Log Page - Sanitize Status Log command error: ");
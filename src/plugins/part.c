@@ -25,6 +25,7 @@
 #include <locale.h>
 
 #include "part.h"
+#include "probes.h"
 
 /**
  * SECTION: part
@@ -249,7 +250,7 @@ static gboolean write_label (struct fdisk_context *cxt, struct fdisk_table *orig
        chance things will just work. If not, an error will be reported
        anyway with no harm. */
 
-    ret = fdisk_write_disklabel (cxt);
+    ret = BD_PROBE_CALL (fdisk_write_disklabel, fdisk_write_disklabel (cxt));
     if (ret != 0) {
         g_set_error (error, BD_PART_ERROR, BD_PART_ERROR_FAIL,
                      "Failed to write the new disklabel to disk '%s': %s", disk, strerror_l (-ret, c_locale));
@@ -198,6 +198,18 @@ void bd_smart_close (void) {
     _smart_close_plugin ();
 }
 
+/**
+ * bd_smart_prewarm_deps:
+ *
+ * Checks all the runtime dependencies of the plugin so that they don't need
+ * to be checked later. **This function is called automatically by
+ * bd_prewarm_deps().**
+ *
+ */
+void bd_smart_prewarm_deps (void) {
+    bd_smart_is_tech_avail (0, 0, NULL);
+}
+
 /**
  * bd_smart_ata_attribute_free: (skip)
  * @attr: (nullable): %BDSmartATAAttribute to free
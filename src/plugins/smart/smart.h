@@ -435,6 +435,7 @@ BDSmartSCSI * bd_smart_scsi_copy (BDSmartSCSI *data);
 gboolean bd_smart_check_deps (void);
 gboolean bd_smart_init (void);
 void     bd_smart_close (void);
+void     bd_smart_prewarm_deps (void);
 
 gboolean bd_smart_is_tech_avail (BDSmartTech tech, guint64 mode, GError **error);
 
@@ -782,6 +782,13 @@ def lvm_pvmove(src, dest=None, extra=None, **kwargs):
     return _lvm_pvmove(src, dest, extra)
 __all__.append("lvm_pvmove")
 
+_lvm_pvmove_start = BlockDev.lvm_pvmove_start
+@override(BlockDev.lvm_pvmove_start)
+def lvm_pvmove_start(src, dest=None, extra=None, **kwargs):
+    extra = _get_extra(extra, kwargs)
+    return _lvm_pvmove_start(src, dest, extra)
+__all__.append("lvm_pvmove_start")
+
 _lvm_pvscan = BlockDev.lvm_pvscan
 @override(BlockDev.lvm_pvscan)
 def lvm_pvscan(device=None, update_cache=True, extra=None, **kwargs):
@@ -852,6 +859,30 @@ def lvm_lvremove(vg_name, lv_name, force=False, extra=None, **kwargs):
     return _lvm_lvremove(vg_name, lv_name, force, extra)
 __all__.append("lvm_lvremove")
 
+class LVMLVSpec(BlockDev.LVMLVSpec):
+    def __new__(cls, lv_name, size, type=None, pv_list=None, pool_name=None):  # pylint: disable=redefined-builtin
+        ret = BlockDev.LVMLVSpec.new(lv_name, size, type, pv_list, pool_name)
+        ret.__class__ = cls
+        return ret
+    def __init__(self, *args, **kwargs):  # pylint: disable=unused-argument
+        super(LVMLVSpec, self).__init__()  #pylint: disable=bad-super-call
+LVMLVSpec = override(LVMLVSpec)
+__all__.append("LVMLVSpec")
+
+_lvm_lvcreate_many = BlockDev.lvm_lvcreate_many
+@override(BlockDev.lvm_lvcreate_many)
+def lvm_lvcreate_many(vg_name, specs, extra=None, **kwargs):
+    extra = _get_extra(extra, kwargs)
+    return _lvm_lvcreate_many(vg_name, specs, extra)
+__all__.append("lvm_lvcreate_many")
+
+_lvm_lvremove_many = BlockDev.lvm_lvremove_many
+@override(BlockDev.lvm_lvremove_many)
+def lvm_lvremove_many(vg_name, lv_names, force=False, extra=None, **kwargs):
+    extra = _get_extra(extra, kwargs)
+    return _lvm_lvremove_many(vg_name, lv_names, force, extra)
+__all__.append("lvm_lvremove_many")
+
 _lvm_lvrename = BlockDev.lvm_lvrename
 @override(BlockDev.lvm_lvrename)
 def lvm_lvrename(vg_name, lv_name, new_name, extra=None, **kwargs):
@@ -866,6 +897,13 @@ def lvm_lvresize(vg_name, lv_name, size, extra=None, **kwargs):
     return _lvm_lvresize(vg_name, lv_name, size, extra)
 __all__.append("lvm_lvresize")
 
+_lvm_lvresize_start = BlockDev.lvm_lvresize_start
+@override(BlockDev.lvm_lvresize_start)
+def lvm_lvresize_start(vg_name, lv_name, size, extra=None, **kwargs):
+    extra = _get_extra(extra, kwargs)
+    return _lvm_lvresize_start(vg_name, lv_name, size, extra)
+__all__.append("lvm_lvresize_start")
+
 _lvm_lvactivate = BlockDev.lvm_lvactivate
 @override(BlockDev.lvm_lvactivate)
 def lvm_lvactivate(vg_name, lv_name, ignore_skip=False, shared=False, extra=None, **kwargs):
@@ -1010,6 +1048,13 @@ def lvm_vdo_pool_convert(vg_name, lv_name, pool_name, virtual_size, index_memory
     return _lvm_vdo_pool_convert(vg_name, lv_name, pool_name, virtual_size, index_memory, compression, deduplication, write_policy, extra)
 __all__.append("lvm_vdo_pool_convert")
 
+_lvm_vdo_pool_convert_start = BlockDev.lvm_vdo_pool_convert_start
+@override(BlockDev.lvm_vdo_pool_convert_start)
+def lvm_vdo_pool_convert_start(vg_name, lv_name, pool_name, virtual_size, index_memory=0, compression=True, deduplication=True, write_policy=BlockDev.LVMVDOWritePolicy.AUTO, extra=None, **kwargs):
+    extra = _get_extra(extra, kwargs)
+    return _lvm_vdo_pool_convert_start(vg_name, lv_name, pool_name, virtual_size, index_memory, compression, deduplication, write_policy, extra)
+__all__.append("lvm_vdo_pool_convert_start")
+
 _lvm_devices_add = BlockDev.lvm_devices_add
 @override(BlockDev.lvm_devices_add)
 def lvm_devices_add(device, devices_file=None, extra=None, **kwargs):
@@ -17,7 +17,9 @@
  * Author: Vratislav Podzimek <vpodzime@redhat.com>
  */
 
+#define _GNU_SOURCE
 #include <glib.h>
+#include <glib-unix.h>
 #include "exec.h"
 #include "extra_arg.h"
 #include "logging.h"
@@ -25,10 +27,17 @@
 #include <poll.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+/* static (USDT) probes for tracing the executed utilities with e.g. bpftrace */
+#include "probes.h"
+
 #ifdef __clang__
 #define ZERO_INIT {}
 #else
@@ -45,6 +54,17 @@ static GMutex task_id_counter_lock;
 static guint64 task_id_counter = 0;
 static BDUtilsProgFunc prog_func = NULL;
 static __thread BDUtilsProgFunc thread_prog_func = NULL;
+static __thread guint64 thread_exec_timeout = 0;
+
+/* time (in milliseconds) given to a process to exit after SIGTERM before it's killed with SIGKILL */
+#define _EXEC_KILL_GRACE_PERIOD 5000
+
+static GMutex version_cache_lock;
+static gchar *version_cache_dir = NULL;
+
+/* utility name -> BDUtilsExecStats */
+static GMutex exec_stats_lock;
+static GHashTable *exec_stats = NULL;
 
 /**
  * bd_utils_exec_error_quark: (skip)
@@ -83,14 +103,16 @@ void bd_utils_log_task_status (guint64 task_id, const gchar *msg) {
 
 /**
  * log_running: (skip)
+ * @start_time: (out): place to store the start time of the run
  *
  * Returns: id of the running task
  */
-static guint64 log_running (const gchar **argv) {
+static guint64 log_running (const gchar **argv, gint64 *start_time) {
     guint64 task_id = 0;
     gchar *str_argv = NULL;
     gchar *log_msg = NULL;
 
+    *start_time = g_get_monotonic_time ();
     task_id = bd_utils_get_next_task_id ();
 
     str_argv = g_strjoinv (" ", (gchar **) argv);
@@ -120,21 +142,136 @@ static void log_out (guint64 task_id, const gchar *stdout, const gchar *stderr)
     return;
 }
 
+/**
+ * bd_utils_exec_stats_copy: (skip)
+ * @stats: (nullable): %BDUtilsExecStats to copy
+ *
+ * Creates a new copy of @stats.
+ */
+BDUtilsExecStats* bd_utils_exec_stats_copy (BDUtilsExecStats *stats) {
+    BDUtilsExecStats *ret = NULL;
+
+    if (stats == NULL)
+        return NULL;
+
+    ret = g_new0 (BDUtilsExecStats, 1);
+    *ret = *stats;
+    ret->util = g_strdup (stats->util);
+
+    return ret;
+}
+
+/**
+ * bd_utils_exec_stats_free: (skip)
+ * @stats: (nullable): %BDUtilsExecStats to free
+ *
+ * Frees @stats.
+ */
+void bd_utils_exec_stats_free (BDUtilsExecStats *stats) {
+    if (stats == NULL)
+        return;
+
+    g_free (stats->util);
+    g_free (stats);
+}
+
+GType bd_utils_exec_stats_get_type (void) {
+    static GType type = 0;
+
+    if (G_UNLIKELY (!type))
+        type = g_boxed_type_register_static ("BDUtilsExecStats",
+                                             (GBoxedCopyFunc) bd_utils_exec_stats_copy,
+                                             (GBoxedFreeFunc) bd_utils_exec_stats_free);
+
+    return type;
+}
+
+/**
+ * _exec_stats_record: (skip)
+ * @util: the utility that was run (argv[0])
+ * @duration: wall time of the run (in microseconds)
+ * @failed: whether the run failed or not
+ * @output_size: size of the (standard and error) output of the run
+ */
+static void _exec_stats_record (const gchar *util, gint64 duration, gboolean failed, gsize output_size) {
+    BDUtilsExecStats *stats = NULL;
+    const gchar *util_name = NULL;
+    guint64 duration_ms = 0;
+    guint bucket = 0;
+
+    /* aggregate per utility, not per its path */
+    util_name = strrchr (util, '/');
+    util_name = util_name ? util_name + 1 : util;
+
+    /* bucket 0 is for runs shorter than 1 ms, then the buckets double in size */
+    duration = MAX (duration, 0);
+    duration_ms = (guint64) duration / 1000;
+    while (duration_ms > 0 && bucket < BD_UTILS_EXEC_STATS_BUCKETS - 1) {
+        duration_ms >>= 1;
+        bucket++;
+    }
+
+    /* just a few additions under the lock, the runs themselves are way more expensive */
+    g_mutex_lock (&exec_stats_lock);
+    if (G_UNLIKELY (!exec_stats))
+        exec_stats = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) bd_utils_exec_stats_free);
+    stats = g_hash_table_lookup (exec_stats, util_name);
+    if (G_UNLIKELY (!stats)) {
+        stats = g_new0 (BDUtilsExecStats, 1);
+        stats->util = g_strdup (util_name);
+        g_hash_table_insert (exec_stats, stats->util, stats);
+    }
+    stats->runs++;
+    if (failed)
+        stats->failures++;
+    stats->total_time += (guint64) duration;
+    stats->max_time = MAX (stats->max_time, (guint64) duration);
+    stats->output_size += output_size;
+    stats->histogram[bucket]++;
+    g_mutex_unlock (&exec_stats_lock);
+}
+
 /**
  * log_done: (skip)
+ * @util: the utility that was run (argv[0])
+ * @start_time: start time of the run as returned by log_running()
+ * @exit_code: exit code of the run or -1 if the run failed without an exit code
+ * @output_size: size of the (standard and error) output of the run
  *
  */
-static void log_done (guint64 task_id, gint exit_code) {
+static void log_done (guint64 task_id, const gchar *util, gint64 start_time, gint exit_code, gsize output_size) {
     gchar *log_msg = NULL;
+    const gchar *util_name = NULL;
+    gint64 end_time = 0;
+
+    end_time = g_get_monotonic_time ();
+    BD_PROBE4 (exec_exit, task_id, util, exit_code, end_time - start_time);
 
     log_msg = g_strdup_printf ("...done [%"G_GUINT64_FORMAT"] (exit code: %d)", task_id, exit_code);
     bd_utils_log (BD_UTILS_LOG_INFO, log_msg);
     g_free (log_msg);
 
+    _exec_stats_record (util, end_time - start_time, exit_code != 0, output_size);
+
+    if (bd_utils_get_tracing ()) {
+        util_name = strrchr (util, '/');
+        bd_utils_trace_record (task_id, "utils", util_name ? util_name + 1 : util, start_time, end_time, exit_code);
+    }
 
     return;
 }
 
+/* environment for the spawned utilities, C locale to get parsable output */
+static gchar ** _get_exec_env (void) {
+    gchar **env = NULL;
+
+    env = g_get_environ ();
+    env = g_environ_setenv (env, "LC_ALL", "C.UTF-8", TRUE);
+    env = g_environ_unsetenv (env, "LANGUAGE");
+
+    return env;
+}
+
 static const gchar ** _append_extra_args (const gchar **argv, const BDExtraArg **extra) {
     const gchar **args = NULL;
     guint args_len = 0;
@@ -166,144 +303,6 @@ static const gchar ** _append_extra_args (const gchar **argv, const BDExtraArg *
     return args;
 }
 
-/**
- * bd_utils_exec_and_report_error:
- * @argv: (array zero-terminated=1): the argv array for the call
- * @extra: (nullable) (array zero-terminated=1): extra arguments
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
- */
-gboolean bd_utils_exec_and_report_error (const gchar **argv, const BDExtraArg **extra, GError **error) {
-    gint status = 0;
-    /* just use the "stronger" function providing dumb progress reporting (just
-       'started' and 'finished') and throw away the returned status */
-    return bd_utils_exec_and_report_progress (argv, extra, NULL, &status, error);
-}
-
-/**
- * bd_utils_exec_and_report_error_no_progress:
- * @argv: (array zero-terminated=1): the argv array for the call
- * @extra: (nullable) (array zero-terminated=1): extra arguments
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
- */
-gboolean bd_utils_exec_and_report_error_no_progress (const gchar **argv, const BDExtraArg **extra, GError **error) {
-    gint status = 0;
-    /* just use the "stronger" function and throw away the returned status */
-    return bd_utils_exec_and_report_status_error (argv, extra, &status, error);
-}
-
-/**
- * bd_utils_exec_and_capture_output_no_progress:
- * @argv: (array zero-terminated=1): the argv array for the call
- * @extra: (nullable) (array zero-terminated=1): extra arguments
- * @output: (out) (optional): place to store stdout to
- * @stderr: (out) (optional): place to store stderr to
- * @status: (out): place to store the process return code
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the @argv was successfully executed capturing the output or not
- */
-gboolean bd_utils_exec_and_capture_output_no_progress (const gchar **argv, const BDExtraArg **extra, gchar **output, gchar **stderr, gint *status, GError **error) {
-    gboolean success = FALSE;
-    gchar *stdout_data = NULL;
-    gchar *stderr_data = NULL;
-    guint64 task_id = 0;
-    const gchar **args = NULL;
-    gint exit_status = 0;
-    gchar **old_env = NULL;
-    gchar **new_env = NULL;
-    GError *l_error = NULL;
-
-    args = _append_extra_args (argv, extra);
-
-    old_env = g_get_environ ();
-    new_env = g_environ_setenv (old_env, "LC_ALL", "C.UTF-8", TRUE);
-    new_env = g_environ_unsetenv (new_env, "LANGUAGE");
-
-    task_id = log_running (args ? args : argv);
-    success = g_spawn_sync (NULL, args ? (gchar **) args : (gchar **) argv, new_env, G_SPAWN_SEARCH_PATH,
-                            NULL, NULL, &stdout_data, &stderr_data, &exit_status, error);
-    g_strfreev (new_env);
-    if (!success) {
-        /* error is already populated from the call */
-        g_free (stdout_data);
-        g_free (stderr_data);
-        g_free (args);
-        return FALSE;
-    }
-
-    /* g_spawn_sync set the status in the same way waitpid() does, we need
-       to get the process exit code manually (this is similar to calling
-       WEXITSTATUS but also sets the error for terminated processes */
-
-    #if !GLIB_CHECK_VERSION(2, 69, 0)
-    #define g_spawn_check_wait_status(x,y) (g_spawn_check_exit_status (x,y))
-    #endif
-
-    if (!g_spawn_check_wait_status (exit_status, &l_error)) {
-        if (g_error_matches (l_error, G_SPAWN_ERROR, G_SPAWN_ERROR_FAILED)) {
-            /* process was terminated abnormally (e.g. using a signal) */
-            g_free (stdout_data);
-            g_free (stderr_data);
-            g_free (args);
-            g_propagate_error (error, l_error);
-            return FALSE;
-        }
-
-        *status = l_error->code;
-        g_clear_error (&l_error);
-    } else
-        *status = 0;
-
-    log_out (task_id, stdout_data, stderr_data);
-    log_done (task_id, *status);
-
-    g_free (args);
-    if (output)
-        *output = stdout_data;
-    else
-        g_free (stdout_data);
-    if (stderr)
-        *stderr = stderr_data;
-    else
-        g_free (stderr_data);
-
-    return TRUE;
-}
-
-/**
- * bd_utils_exec_and_report_status_error:
- * @argv: (array zero-terminated=1): the argv array for the call
- * @extra: (nullable) (array zero-terminated=1): extra arguments
- * @status: (out): place to store the status
- * @error: (out) (optional): place to store error (if any)
- *
- * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
- */
-gboolean bd_utils_exec_and_report_status_error (const gchar **argv, const BDExtraArg **extra, gint *status, GError **error) {
-    gboolean ret;
-    gchar *stdout_data = NULL;
-    gchar *stderr_data = NULL;
-
-    ret = bd_utils_exec_and_capture_output_no_progress (argv, extra, &stdout_data, &stderr_data, status, error);
-
-    if (ret && *status != 0) {
-        if (stderr_data && (g_strcmp0 ("", stderr_data) != 0))
-            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                         "Process reported exit code %d: %s", *status, stderr_data);
-        else
-            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                         "Process reported exit code %d: %s", *status, stdout_data);
-        ret = FALSE;
-    }
-    g_free (stdout_data);
-    g_free (stderr_data);
-    return ret;
-}
-
 /* buffer size in bytes used to read from stdout and stderr */
 #define _EXEC_BUF_SIZE 64*1024
 
@@ -320,9 +319,20 @@ static gchar *bd_strchr_len_null (const gchar *haystack, gssize haystack_len, co
         return MAX (ret, ret_null);
 }
 
+static void _process_line (const gchar *line, GString *filtered_buffer, BDUtilsLineFunc line_func, gpointer line_data,
+                           guint64 progress_id, guint8 *progress, BDUtilsProgExtract prog_extract) {
+    if (prog_extract && prog_extract (line, progress))
+        bd_utils_report_progress (progress_id, *progress, NULL);
+    else if (line_func)
+        line_func (line, line_data);
+    else
+        g_string_append (filtered_buffer, line);
+}
+
 static gboolean
-_process_fd_event (gint fd, struct pollfd *poll_fd, GString *read_buffer, GString *filtered_buffer, gsize *read_buffer_pos, gboolean *done,
-                   guint64 progress_id, guint8 *progress, BDUtilsProgExtract prog_extract, GError **error) {
+_process_fd_event (gint fd, struct pollfd *poll_fd, GString *read_buffer, GString *filtered_buffer, gsize *read_buffer_pos, gboolean *done, gsize *total_read,
+                   guint64 progress_id, guint8 *progress, BDUtilsProgExtract prog_extract, BDUtilsLineFunc line_func, gpointer line_data,
+                   GError **error) {
     gchar buf[_EXEC_BUF_SIZE] = { 0 };
     ssize_t num_read;
     gchar *line;
@@ -332,27 +342,28 @@ _process_fd_event (gint fd, struct pollfd *poll_fd, GString *read_buffer, GStrin
 
     if (! *done && (poll_fd->revents & POLLIN)) {
         /* read until we get EOF (0) or error (-1), expecting EAGAIN */
-        while ((num_read = read (fd, buf, _EXEC_BUF_SIZE)) > 0)
-            g_string_append_len (read_buffer, buf, num_read);
-        errno_saved = errno;
-
-        /* process the fresh data by lines */
-        if (read_buffer->len > *read_buffer_pos) {
+        while ((num_read = read (fd, buf, _EXEC_BUF_SIZE)) > 0) {
             gchar *buf_ptr;
             gsize buf_len;
 
+            g_string_append_len (read_buffer, buf, num_read);
+            *total_read += num_read;
+
+            /* process the fresh data by lines */
             while ((buf_ptr = read_buffer->str + *read_buffer_pos,
                     buf_len = read_buffer->len - *read_buffer_pos,
                     newline_pos = bd_strchr_len_null (buf_ptr, buf_len, '\n'))) {
                 line = g_strndup (buf_ptr, newline_pos - buf_ptr + 1);
-                if (prog_extract && prog_extract (line, progress))
-                    bd_utils_report_progress (progress_id, *progress, NULL);
-                else
-                    g_string_append (filtered_buffer, line);
+                _process_line (line, filtered_buffer, line_func, line_data, progress_id, progress, prog_extract);
                 g_free (line);
                 *read_buffer_pos = newline_pos - read_buffer->str + 1;
             }
+
+            /* only keep the incomplete last line */
+            g_string_erase (read_buffer, 0, *read_buffer_pos);
+            *read_buffer_pos = 0;
         }
+        errno_saved = errno;
 
         /* read error */
         if (num_read < 0 && errno_saved != EAGAIN && errno_saved != EINTR) {
@@ -374,281 +385,1443 @@ _process_fd_event (gint fd, struct pollfd *poll_fd, GString *read_buffer, GStrin
         /* process the remaining buffer */
         line = read_buffer->str + *read_buffer_pos;
         /* GString guarantees the buffer is always NULL-terminated. */
-        if (strlen (line) > 0) {
-            if (prog_extract && prog_extract (line, progress))
-                bd_utils_report_progress (progress_id, *progress, NULL);
-            else
-                g_string_append (filtered_buffer, line);
-        }
+        if (strlen (line) > 0)
+            _process_line (line, filtered_buffer, line_func, line_data, progress_id, progress, prog_extract);
     }
 
     return TRUE;
 }
 
-static gboolean _utils_exec_and_report_progress (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, const gchar *input, gint *proc_status, gchar **stdout, gchar **stderr, GError **error) {
-    const gchar **args = NULL;
-    gchar *args_str = NULL;
-    guint64 task_id = 0;
-    guint64 progress_id = 0;
-    gchar *msg = NULL;
-    GPid pid = 0;
-    gint out_fd = 0;
-    gint err_fd = 0;
-    gint in_fd = 0;
-    gint child_ret = -1;
-    gint status = 0;
-    gboolean ret = FALSE;
-    gint poll_status = 0;
-    guint8 completion = 0;
-    struct pollfd fds[2] = { ZERO_INIT, ZERO_INIT };
-    int flags;
-    gboolean out_done = FALSE;
-    gboolean err_done = FALSE;
-    GString *stdout_data;
-    GString *stdout_buffer;
-    GString *stderr_data;
-    GString *stderr_buffer;
-    gsize stdout_buffer_pos = 0;
-    gsize stderr_buffer_pos = 0;
-    gchar **old_env = NULL;
-    gchar **new_env = NULL;
-    gboolean success = TRUE;
-    GError *l_error = NULL;
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+static void _close_pipe (gint pipe_fds[2]) {
+    if (pipe_fds[0] >= 0)
+        close (pipe_fds[0]);
+    if (pipe_fds[1] >= 0)
+        close (pipe_fds[1]);
+    pipe_fds[0] = pipe_fds[1] = -1;
+}
+#else
+static void _child_setup_pgroup (gpointer user_data G_GNUC_UNUSED) {
+    setpgid (0, 0);
+}
+#endif
 
-    args = _append_extra_args (argv, extra);
+/**
+ * _spawn_with_pipes: (skip)
+ * @argv: the argv array for the call
+ * @envp: environment for the spawned process
+ * @new_pgroup: whether to put the process into a new process group (so that it can be
+ *              killed together with its children)
+ * @pid: (out): place to store the PID of the spawned process
+ * @in_fd: (out) (optional): place to store the FD connected to the standard input of
+ *                           the process or %NULL if the input should be `/dev/null`
+ * @out_fd: (out): place to store the FD connected to the standard output of the process
+ * @err_fd: (out): place to store the FD connected to the standard error output of the process
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Spawns @argv using posix_spawn() which (unlike fork()) doesn't need to copy the
+ * page tables of the calling process (glibc uses clone() with CLONE_VM|CLONE_VFORK)
+ * so the cost of spawning a process doesn't grow with the memory footprint of the
+ * caller. GLib only takes this path if the caller's FDs may be leaked into the child.
+ * The spawned process is not reaped.
+ *
+ * Returns: whether the process was successfully spawned or not
+ */
+static gboolean _spawn_with_pipes (const gchar **argv, gchar **envp, gboolean new_pgroup, GPid *pid, gint *in_fd, gint *out_fd, gint *err_fd, GError **error) {
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    sigset_t sig_mask;
+    sigset_t sig_default;
+    gint in_pipe[2] = {-1, -1};
+    gint out_pipe[2] = {-1, -1};
+    gint err_pipe[2] = {-1, -1};
+    pid_t child_pid = 0;
+    gint ret = 0;
+    gshort flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+
+    if ((in_fd && pipe2 (in_pipe, O_CLOEXEC) != 0) || pipe2 (out_pipe, O_CLOEXEC) != 0 || pipe2 (err_pipe, O_CLOEXEC) != 0) {
+        ret = errno;
+        _close_pipe (in_pipe);
+        _close_pipe (out_pipe);
+        _close_pipe (err_pipe);
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Failed to create pipes for the process: %s", g_strerror (ret));
+        return FALSE;
+    }
+
+    posix_spawn_file_actions_init (&actions);
+    if (in_fd)
+        posix_spawn_file_actions_adddup2 (&actions, in_pipe[0], STDIN_FILENO);
+    else
+        posix_spawn_file_actions_addopen (&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2 (&actions, out_pipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2 (&actions, err_pipe[1], STDERR_FILENO);
+    /* don't leak FDs of the calling process opened without O_CLOEXEC */
+    posix_spawn_file_actions_addclosefrom_np (&actions, STDERR_FILENO + 1);
+
+    /* same as GLib, run the process with an empty signal mask and default SIGPIPE handling */
+    posix_spawnattr_init (&attr);
+    sigemptyset (&sig_mask);
+    sigemptyset (&sig_default);
+    sigaddset (&sig_default, SIGPIPE);
+    posix_spawnattr_setsigmask (&attr, &sig_mask);
+    posix_spawnattr_setsigdefault (&attr, &sig_default);
+    if (new_pgroup) {
+        posix_spawnattr_setpgroup (&attr, 0);
+        flags |= POSIX_SPAWN_SETPGROUP;
+    }
+    posix_spawnattr_setflags (&attr, flags);
+
+    ret = posix_spawnp (&child_pid, argv[0], &actions, &attr, (gchar **) argv, envp);
+
+    posix_spawnattr_destroy (&attr);
+    posix_spawn_file_actions_destroy (&actions);
+
+    /* the child ends of the pipes are not needed in this process */
+    if (in_pipe[0] >= 0)
+        close (in_pipe[0]);
+    close (out_pipe[1]);
+    close (err_pipe[1]);
+
+    if (ret != 0) {
+        if (in_pipe[1] >= 0)
+            close (in_pipe[1]);
+        close (out_pipe[0]);
+        close (err_pipe[0]);
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Failed to execute child process '%s': %s", argv[0], g_strerror (ret));
+        return FALSE;
+    }
 
-    task_id = log_running (args ? args : argv);
+    *pid = child_pid;
+    if (in_fd)
+        *in_fd = in_pipe[1];
+    *out_fd = out_pipe[0];
+    *err_fd = err_pipe[0];
 
-    old_env = g_get_environ ();
-    new_env = g_environ_setenv (old_env, "LC_ALL", "C.UTF-8", TRUE);
-    new_env = g_environ_unsetenv (new_env, "LANGUAGE");
+    return TRUE;
+#else
+    /* error is populated by the call (if any) */
+    return g_spawn_async_with_pipes (NULL, (gchar **) argv, envp,
+                                     G_SPAWN_DEFAULT|G_SPAWN_SEARCH_PATH|G_SPAWN_DO_NOT_REAP_CHILD,
+                                     new_pgroup ? _child_setup_pgroup : NULL, NULL,
+                                     pid, in_fd, out_fd, err_fd, error);
+#endif
+}
 
-    ret = g_spawn_async_with_pipes (NULL, args ? (gchar**) args : (gchar**) argv, new_env,
-                                    G_SPAWN_DEFAULT|G_SPAWN_SEARCH_PATH|G_SPAWN_DO_NOT_REAP_CHILD,
-                                    NULL, NULL, &pid, input ? &in_fd : NULL, &out_fd, &err_fd, error);
+#ifndef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+typedef struct ChildFDs {
+    const gint *fds;
+    guint n_fds;
+    gboolean new_pgroup;
+} ChildFDs;
 
-    g_strfreev (new_env);
+static void _child_setup_fds (gpointer user_data) {
+    ChildFDs *child_fds = (ChildFDs *) user_data;
+    guint i = 0;
+
+    /* FDs 3 and higher are already marked as CLOEXEC by GLib at this point,
+       dup2() clears the flag for the new ones */
+    for (i = 0; i < child_fds->n_fds; i++)
+        dup2 (child_fds->fds[i], i);
+    if (child_fds->new_pgroup)
+        setpgid (0, 0);
+}
+#endif
+
+/**
+ * bd_utils_spawn_with_fds: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @env_vars: (nullable) (array zero-terminated=1): extra environment variables for the
+ *                                                    process in the `NAME=value` format
+ * @fds: (array length=n_fds): FDs to pass to the process as its FDs 0, 1,..., @n_fds - 1
+ * @n_fds: number of FDs in @fds (at least 3)
+ * @new_pgroup: whether to put the process into a new process group (so that it can be
+ *              signalled together with its children)
+ * @pid: (out): place to store the PID of the spawned process
+ * @task_id: (out): place to store the ID of the task the run is logged as
+ * @start_time: (out): place to store the start time of the run
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Spawns @argv (in the same environment as the exec functions use) with @fds as
+ * its standard input, output, error output and the extra FDs. No other FDs of the
+ * calling process are inherited by the spawned process.
+ *
+ * The run is logged and accounted as any other run of a utility, the caller is
+ * responsible for reaping the process and passing its exit code to
+ * bd_utils_exec_log_done() together with @task_id and @start_time.
+ *
+ * Returns: whether the process was successfully spawned or not
+ */
+gboolean bd_utils_spawn_with_fds (const gchar **argv, const gchar **env_vars, const gint *fds, guint n_fds, gboolean new_pgroup, GPid *pid, guint64 *task_id, gint64 *start_time, GError **error) {
+    gchar **envp = NULL;
+    const gchar **var_p = NULL;
+    gchar **name_value = NULL;
+    gint ret = 0;
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    sigset_t sig_mask;
+    sigset_t sig_default;
+    pid_t child_pid = 0;
+    guint i = 0;
+    gshort flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#else
+    ChildFDs child_fds = {fds, n_fds, new_pgroup};
+#endif
+
+    envp = _get_exec_env ();
+    for (var_p = env_vars; var_p && *var_p; var_p++) {
+        name_value = g_strsplit (*var_p, "=", 2);
+        envp = g_environ_setenv (envp, name_value[0], name_value[1] ? name_value[1] : "", TRUE);
+        g_strfreev (name_value);
+    }
+
+    *task_id = log_running (argv, start_time);
+
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP
+    posix_spawn_file_actions_init (&actions);
+    for (i = 0; i < n_fds; i++)
+        posix_spawn_file_actions_adddup2 (&actions, fds[i], i);
+    /* don't leak FDs of the calling process opened without O_CLOEXEC */
+    posix_spawn_file_actions_addclosefrom_np (&actions, n_fds);
+
+    /* same as GLib, run the process with an empty signal mask and default SIGPIPE handling */
+    posix_spawnattr_init (&attr);
+    sigemptyset (&sig_mask);
+    sigemptyset (&sig_default);
+    sigaddset (&sig_default, SIGPIPE);
+    posix_spawnattr_setsigmask (&attr, &sig_mask);
+    posix_spawnattr_setsigdefault (&attr, &sig_default);
+    if (new_pgroup) {
+        posix_spawnattr_setpgroup (&attr, 0);
+        flags |= POSIX_SPAWN_SETPGROUP;
+    }
+    posix_spawnattr_setflags (&attr, flags);
+
+    ret = posix_spawnp (&child_pid, argv[0], &actions, &attr, (gchar **) argv, envp);
+
+    posix_spawnattr_destroy (&attr);
+    posix_spawn_file_actions_destroy (&actions);
+    g_strfreev (envp);
+
+    if (ret != 0) {
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Failed to execute child process '%s': %s", argv[0], g_strerror (ret));
+        log_done (*task_id, argv[0], *start_time, -1, 0);
+        return FALSE;
+    }
+    *pid = child_pid;
+#else
+    ret = g_spawn_async (NULL, (gchar **) argv, envp,
+                         G_SPAWN_DEFAULT|G_SPAWN_SEARCH_PATH|G_SPAWN_DO_NOT_REAP_CHILD,
+                         _child_setup_fds, &child_fds, pid, error);
+    g_strfreev (envp);
 
     if (!ret) {
-        /* error is already populated */
-        g_free (args);
+        /* error is already populated from the call */
+        log_done (*task_id, argv[0], *start_time, -1, 0);
         return FALSE;
     }
+#endif
+    BD_PROBE3 (exec_spawn, *task_id, argv[0], *pid);
 
-    args_str = g_strjoinv (" ", args ? (gchar **) args : (gchar **) argv);
-    msg = g_strdup_printf ("Started '%s'", args_str);
-    progress_id = bd_utils_report_started (msg);
-    g_free (args_str);
-    g_free (args);
-    g_free (msg);
+    return TRUE;
+}
 
-    /* set both fds for non-blocking read */
-    flags = fcntl (out_fd, F_GETFL, 0);
-    if (fcntl (out_fd, F_SETFL, flags | O_NONBLOCK))
-        bd_utils_log_format (BD_UTILS_LOG_WARNING,
-                             "_utils_exec_and_report_progress: Failed to set out_fd non-blocking: %m");
-    flags = fcntl (err_fd, F_GETFL, 0);
-    if (fcntl (err_fd, F_SETFL, flags | O_NONBLOCK))
-        bd_utils_log_format (BD_UTILS_LOG_WARNING,
-                             "_utils_exec_and_report_progress: Failed to set err_fd non-blocking: %m");
+/**
+ * bd_utils_exec_log_running: (skip)
+ * @argv: (array zero-terminated=1): the argv array for the run
+ * @start_time: (out): place to store the start time of the run
+ *
+ * Logs a run of @argv not spawned by the exec functions (e.g. a command passed to
+ * an already running process) so that it is accounted as any other run of a utility.
+ * The run has to be finished with bd_utils_exec_log_done().
+ *
+ * Returns: ID of the task the run is logged as
+ */
+guint64 bd_utils_exec_log_running (const gchar **argv, gint64 *start_time) {
+    return log_running (argv, start_time);
+}
 
-    if (input) {
-        ssize_t num_written = 0;
+/**
+ * bd_utils_exec_log_done: (skip)
+ * @task_id: ID of the task as returned by bd_utils_exec_log_running() or bd_utils_spawn_with_fds()
+ * @util: the utility that was run (`argv[0]`)
+ * @start_time: start time of the run as returned by bd_utils_exec_log_running()
+ *              or bd_utils_spawn_with_fds()
+ * @exit_code: exit code of the run or -1 if the run failed without an exit code
+ * @output_size: size of the output of the run
+ *
+ * Logs the end of a run started with bd_utils_exec_log_running() or bd_utils_spawn_with_fds()
+ * and records it in the execution statistics.
+ */
+void bd_utils_exec_log_done (guint64 task_id, const gchar *util, gint64 start_time, gint exit_code, gsize output_size) {
+    log_done (task_id, util, start_time, exit_code, output_size);
+}
+
+static void _kill_process_group (GPid pid, gint sig) {
+    /* the process may have failed to become a group leader */
+    if (kill (-pid, sig) != 0 && errno == ESRCH)
+        kill (pid, sig);
+}
+
+static gint _pidfd_open (GPid pid) {
+#ifdef SYS_pidfd_open
+    return (gint) syscall (SYS_pidfd_open, pid, 0);
+#else
+    return -1;
+#endif
+}
+
+static gint _pidfd_send_signal (gint pidfd, gint sig) {
+#ifdef SYS_pidfd_send_signal
+    return (gint) syscall (SYS_pidfd_send_signal, pidfd, sig, NULL, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/**
+ * _collect_output: (skip)
+ * @pid: PID of the (not yet reaped) process
+ * @out_fd: FD connected to the standard output of @pid, closed by this function
+ * @err_fd: FD connected to the standard error output of @pid, closed by this function
+ * @progress_id: ID of the task progress is reported for
+ * @prog_extract: (nullable): function for extracting progress information
+ * @line_func: (nullable): function to pass the (filtered) standard output lines to
+ *                         instead of appending them to @stdout_data
+ * @line_data: (nullable): user data for @line_func
+ * @stdout_data: place to append the (filtered) standard output to
+ * @stderr_data: place to append the (filtered) standard error output to
+ * @timeout: timeout (in milliseconds) for @pid to finish or 0 for no timeout, @pid
+ *           has to be a process group leader if non-zero
+ * @wait_status: (out): place to store the status of @pid as returned by waitpid()
+ * @output_size: (out): place to store the number of bytes read from @out_fd and @err_fd
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Reads the outputs of @pid and reaps it. Both @out_fd and @err_fd are polled
+ * together with a pidfd for @pid (if supported by the kernel) so the outputs
+ * are only read until @pid exits and not until all its children close them.
+ *
+ * If @pid doesn't finish within @timeout, its process group is terminated with
+ * SIGTERM (and SIGKILL if that doesn't help) and %BD_UTILS_EXEC_ERROR_TIMEOUT
+ * is reported.
+ *
+ * Returns: whether the outputs were successfully read and @pid was reaped or not
+ */
+static gboolean _collect_output (GPid pid, gint out_fd, gint err_fd, guint64 progress_id, BDUtilsProgExtract prog_extract,
+                                 BDUtilsLineFunc line_func, gpointer line_data, GString *stdout_data, GString *stderr_data, guint64 timeout, gint *wait_status,
+                                 gsize *output_size, GError **error) {
+    struct pollfd fds[3] = { ZERO_INIT, ZERO_INIT, ZERO_INIT };
+    struct pollfd exited_fd = ZERO_INIT;
+    GString *stdout_buffer;
+    GString *stderr_buffer;
+    gsize stdout_buffer_pos = 0;
+    gsize stderr_buffer_pos = 0;
+    gboolean out_done = FALSE;
+    gboolean err_done = FALSE;
+    gboolean reaped = FALSE;
+    guint8 completion = 0;
+    gint pidfd = -1;
+    gint poll_status = 0;
+    gint poll_timeout = -1;
+    gint64 deadline = 0;
+    gint64 now = 0;
+    gint kill_signal = SIGTERM;
+    gboolean timed_out = FALSE;
+    gint child_ret = 0;
+    int flags;
+    gboolean success = TRUE;
+
+    if (timeout > 0)
+        deadline = g_get_monotonic_time () + timeout * G_TIME_SPAN_MILLISECOND;
+    *output_size = 0;
+
+    /* set both fds for non-blocking read */
+    flags = fcntl (out_fd, F_GETFL, 0);
+    if (fcntl (out_fd, F_SETFL, flags | O_NONBLOCK))
+        bd_utils_log_format (BD_UTILS_LOG_WARNING,
+                             "_collect_output: Failed to set out_fd non-blocking: %m");
+    flags = fcntl (err_fd, F_GETFL, 0);
+    if (fcntl (err_fd, F_SETFL, flags | O_NONBLOCK))
+        bd_utils_log_format (BD_UTILS_LOG_WARNING,
+                             "_collect_output: Failed to set err_fd non-blocking: %m");
+
+    pidfd = _pidfd_open (pid);
+
+    stdout_buffer = g_string_new (NULL);
+    stderr_buffer = g_string_new (NULL);
+
+    fds[0].fd = out_fd;
+    fds[1].fd = err_fd;
+    fds[2].fd = pidfd;
+    fds[0].events = POLLIN | POLLHUP | POLLERR;
+    fds[1].events = POLLIN | POLLHUP | POLLERR;
+    fds[2].events = POLLIN;
+
+    /* used to read whatever is left in the pipes once the process exits */
+    exited_fd.revents = POLLIN | POLLHUP;
+
+    while (! (out_done && err_done)) {
+        if (deadline > 0) {
+            now = g_get_monotonic_time ();
+            if (now >= deadline) {
+                /* terminate the whole process group, kill it if it's still running after the grace period */
+                bd_utils_log_format (BD_UTILS_LOG_WARNING, "Process %d timed out, sending signal %d to its process group",
+                                     pid, kill_signal);
+                _kill_process_group (pid, kill_signal);
+                timed_out = TRUE;
+                if (kill_signal == SIGTERM) {
+                    kill_signal = SIGKILL;
+                    deadline = now + _EXEC_KILL_GRACE_PERIOD * G_TIME_SPAN_MILLISECOND;
+                } else
+                    deadline = 0;
+            }
+        }
+        /* round up to not wake up just before the deadline */
+        poll_timeout = deadline > 0 ? (gint) ((deadline - now + G_TIME_SPAN_MILLISECOND - 1) / G_TIME_SPAN_MILLISECOND) : -1;
+
+        poll_status = poll (fds, 3, poll_timeout);
+        if (poll_status == 0)
+            /* timeout, checked above */
+            continue;
+        if (poll_status < 0) {
+            if (errno == EAGAIN || errno == EINTR)
+                continue;
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Failed to poll output FDs: %m");
+            success = FALSE;
+            break;
+        }
+
+        if (!out_done) {
+            if (! _process_fd_event (out_fd, &fds[0], stdout_buffer, stdout_data, &stdout_buffer_pos, &out_done, output_size, progress_id, &completion, prog_extract, line_func, line_data, error)) {
+                success = FALSE;
+                break;
+            }
+        }
+
+        if (!err_done) {
+            if (! _process_fd_event (err_fd, &fds[1], stderr_buffer, stderr_data, &stderr_buffer_pos, &err_done, output_size, progress_id, &completion, prog_extract, NULL, NULL, error)) {
+                success = FALSE;
+                break;
+            }
+        }
+
+        /* the process exited, everything it has written is already in the pipes
+           which may still be kept open by its children */
+        if ((fds[2].revents & POLLIN) && waitpid (pid, wait_status, WNOHANG) == pid) {
+            reaped = TRUE;
+            fds[2].fd = -1;
+            if (!out_done && ! _process_fd_event (out_fd, &exited_fd, stdout_buffer, stdout_data, &stdout_buffer_pos, &out_done, output_size, progress_id, &completion, prog_extract, line_func, line_data, error)) {
+                success = FALSE;
+                break;
+            }
+            if (!err_done && ! _process_fd_event (err_fd, &exited_fd, stderr_buffer, stderr_data, &stderr_buffer_pos, &err_done, output_size, progress_id, &completion, prog_extract, NULL, NULL, error)) {
+                success = FALSE;
+                break;
+            }
+        }
+
+        /* negative FDs are ignored by poll() */
+        if (out_done)
+            fds[0].fd = -1;
+        if (err_done)
+            fds[1].fd = -1;
+    }
+
+    g_string_free (stdout_buffer, TRUE);
+    g_string_free (stderr_buffer, TRUE);
+    close (out_fd);
+    close (err_fd);
+    if (pidfd >= 0)
+        close (pidfd);
+
+    if (!reaped) {
+        child_ret = waitpid (pid, wait_status, 0);
+        if (child_ret == -1) {
+            if (errno != ECHILD) {
+                if (success)
+                    g_set_error_literal (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                                         "Failed to wait for the process");
+                success = FALSE;
+            } else
+                /* no such process (the child exited before we tried to wait for it) */
+                *wait_status = 0;
+            errno = 0;
+        }
+    }
+
+    if (success && timed_out) {
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_TIMEOUT,
+                     "Process didn't finish within %"G_GUINT64_FORMAT" ms and was terminated", timeout);
+        success = FALSE;
+    }
+
+    return success;
+}
+
+/**
+ * bd_utils_exec_and_report_error:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ */
+gboolean bd_utils_exec_and_report_error (const gchar **argv, const BDExtraArg **extra, GError **error) {
+    gint status = 0;
+    /* just use the "stronger" function providing dumb progress reporting (just
+       'started' and 'finished') and throw away the returned status */
+    return bd_utils_exec_and_report_progress (argv, extra, NULL, &status, error);
+}
+
+/**
+ * bd_utils_exec_and_report_error_no_progress:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ */
+gboolean bd_utils_exec_and_report_error_no_progress (const gchar **argv, const BDExtraArg **extra, GError **error) {
+    gint status = 0;
+    /* just use the "stronger" function and throw away the returned status */
+    return bd_utils_exec_and_report_status_error (argv, extra, &status, error);
+}
+
+/**
+ * bd_utils_exec_and_capture_output_no_progress:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @output: (out) (optional): place to store stdout to
+ * @stderr: (out) (optional): place to store stderr to
+ * @status: (out): place to store the process return code
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @argv was successfully executed capturing the output or not
+ */
+gboolean bd_utils_exec_and_capture_output_no_progress (const gchar **argv, const BDExtraArg **extra, gchar **output, gchar **stderr, gint *status, GError **error) {
+    gboolean success = FALSE;
+    GString *stdout_data = NULL;
+    GString *stderr_data = NULL;
+    guint64 task_id = 0;
+    const gchar **args = NULL;
+    GPid pid = 0;
+    gint out_fd = 0;
+    gint err_fd = 0;
+    gint wait_status = 0;
+    guint64 timeout = thread_exec_timeout;
+    gchar **new_env = NULL;
+    gint64 start_time = 0;
+    gsize output_size = 0;
+
+    args = _append_extra_args (argv, extra);
+
+    new_env = _get_exec_env ();
+
+    task_id = log_running (args ? args : argv, &start_time);
+    success = _spawn_with_pipes (args ? args : argv, new_env, timeout > 0, &pid, NULL, &out_fd, &err_fd, error);
+    g_strfreev (new_env);
+    g_free (args);
+    if (!success) {
+        /* error is already populated from the call */
+        log_done (task_id, argv[0], start_time, -1, 0);
+        return FALSE;
+    }
+    BD_PROBE3 (exec_spawn, task_id, argv[0], pid);
+
+    stdout_data = g_string_new (NULL);
+    stderr_data = g_string_new (NULL);
+    success = _collect_output (pid, out_fd, err_fd, 0, NULL, NULL, NULL, stdout_data, stderr_data, timeout, &wait_status, &output_size, error);
+    if (success && WIFSIGNALED (wait_status)) {
+        /* process was terminated abnormally (e.g. using a signal) */
+        g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Process killed with a signal");
+        success = FALSE;
+    }
+    if (!success) {
+        /* error is already populated */
+        log_done (task_id, argv[0], start_time, -1, output_size);
+        g_string_free (stdout_data, TRUE);
+        g_string_free (stderr_data, TRUE);
+        return FALSE;
+    }
+
+    *status = WIFEXITED (wait_status) ? WEXITSTATUS (wait_status) : 0;
+
+    log_out (task_id, stdout_data->str, stderr_data->str);
+    log_done (task_id, argv[0], start_time, *status, output_size);
+
+    if (output)
+        *output = g_string_free (stdout_data, FALSE);
+    else
+        g_string_free (stdout_data, TRUE);
+    if (stderr)
+        *stderr = g_string_free (stderr_data, FALSE);
+    else
+        g_string_free (stderr_data, TRUE);
+
+    return TRUE;
+}
+
+/**
+ * bd_utils_exec_and_report_status_error:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @status: (out): place to store the status
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ */
+gboolean bd_utils_exec_and_report_status_error (const gchar **argv, const BDExtraArg **extra, gint *status, GError **error) {
+    gboolean ret;
+    gchar *stdout_data = NULL;
+    gchar *stderr_data = NULL;
+
+    ret = bd_utils_exec_and_capture_output_no_progress (argv, extra, &stdout_data, &stderr_data, status, error);
+
+    if (ret && *status != 0) {
+        if (stderr_data && (g_strcmp0 ("", stderr_data) != 0))
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Process reported exit code %d: %s", *status, stderr_data);
+        else
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Process reported exit code %d: %s", *status, stdout_data);
+        ret = FALSE;
+    }
+    g_free (stdout_data);
+    g_free (stderr_data);
+    return ret;
+}
+
+/**
+ * _check_exec_status: (skip)
+ * @progress_id: ID of the task progress is reported for
+ * @status: status of the finished process as returned by waitpid()
+ * @stdout_data: standard output of the process
+ * @stderr_data: standard error output of the process
+ * @proc_status: (out): place to store the process exit status
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Reports the task as finished.
+ *
+ * Returns: whether the process exited with exit code 0 or not
+ */
+static gboolean _check_exec_status (guint64 progress_id, gint status, GString *stdout_data, GString *stderr_data, gint *proc_status, GError **error) {
+    GError *l_error = NULL;
+    const gchar *msg = NULL;
+
+    if (WIFSIGNALED (status)) {
+        *proc_status = 128 + WTERMSIG (status);
+        g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Process killed with a signal");
+        bd_utils_report_finished (progress_id, l_error->message);
+        g_propagate_error (error, l_error);
+        return FALSE;
+    } else if (WIFEXITED (status) && WEXITSTATUS (status) != 0) {
+        *proc_status = WEXITSTATUS (status);
+        msg = stderr_data->len > 0 ? stderr_data->str : stdout_data->str;
+        g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                     "Process reported exit code %d: %s", *proc_status, msg);
+        bd_utils_report_finished (progress_id, l_error->message);
+        g_propagate_error (error, l_error);
+        return FALSE;
+    }
+
+    *proc_status = WIFEXITED (status) ? WEXITSTATUS (status) : 0;
+    bd_utils_report_finished (progress_id, "Completed");
+
+    return TRUE;
+}
+
+static gboolean _utils_exec_and_report_progress (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, BDUtilsLineFunc line_func, gpointer line_data, const gchar *input, gint *proc_status, gchar **stdout, gchar **stderr, GError **error) {
+    const gchar **args = NULL;
+    gchar *args_str = NULL;
+    guint64 task_id = 0;
+    guint64 progress_id = 0;
+    gchar *msg = NULL;
+    GPid pid = 0;
+    gint out_fd = 0;
+    gint err_fd = 0;
+    gint in_fd = 0;
+    gint status = 0;
+    guint64 timeout = thread_exec_timeout;
+    gboolean ret = FALSE;
+    GString *stdout_data;
+    GString *stderr_data;
+    gchar **new_env = NULL;
+    gboolean success = TRUE;
+    GError *l_error = NULL;
+    gint64 start_time = 0;
+    gsize output_size = 0;
+
+    /* no exit status unless the process is successfully reaped */
+    *proc_status = -1;
+
+    args = _append_extra_args (argv, extra);
+
+    task_id = log_running (args ? args : argv, &start_time);
+
+    new_env = _get_exec_env ();
+
+    ret = _spawn_with_pipes (args ? args : argv, new_env, timeout > 0, &pid, input ? &in_fd : NULL, &out_fd, &err_fd, error);
+
+    g_strfreev (new_env);
+
+    if (!ret) {
+        /* error is already populated */
+        log_done (task_id, argv[0], start_time, -1, 0);
+        g_free (args);
+        return FALSE;
+    }
+    BD_PROBE3 (exec_spawn, task_id, argv[0], pid);
+
+    args_str = g_strjoinv (" ", args ? (gchar **) args : (gchar **) argv);
+    msg = g_strdup_printf ("Started '%s'", args_str);
+    progress_id = bd_utils_report_started (msg);
+    g_free (args_str);
+    g_free (args);
+    g_free (msg);
+
+    if (input) {
+        ssize_t num_written = 0;
         ssize_t num_written_total = 0;
         size_t len = strlen (input);
 
-        while (len - num_written_total > 0 && (num_written = write (in_fd, input + num_written_total, len - num_written_total)) > 0)
-            num_written_total += num_written;
+        while (len - num_written_total > 0 && (num_written = write (in_fd, input + num_written_total, len - num_written_total)) > 0)
+            num_written_total += num_written;
+
+        if (num_written < 0) {
+            g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Failed to write to stdin of the process: %m");
+            bd_utils_report_finished (progress_id, l_error->message);
+            g_propagate_error (error, l_error);
+            /* would overwrite errno, need to close as a last step */
+            close (in_fd);
+            close (out_fd);
+            close (err_fd);
+            /* the process may be blocked waiting for the rest of the input */
+            if (timeout > 0)
+                _kill_process_group (pid, SIGKILL);
+            else
+                kill (pid, SIGKILL);
+            waitpid (pid, NULL, 0);
+            log_done (task_id, argv[0], start_time, -1, 0);
+            return FALSE;
+        }
+        close (in_fd);
+        g_warn_if_fail (len - num_written_total == 0);
+    }
+
+    stdout_data = g_string_new (NULL);
+    stderr_data = g_string_new (NULL);
+
+    if (!_collect_output (pid, out_fd, err_fd, progress_id, prog_extract, line_func, line_data, stdout_data, stderr_data, timeout, &status, &output_size, &l_error)) {
+        bd_utils_report_finished (progress_id, l_error->message);
+        g_propagate_error (error, l_error);
+        success = FALSE;
+    } else
+        success = _check_exec_status (progress_id, status, stdout_data, stderr_data, proc_status, error);
+
+    log_out (task_id, stdout_data->str, stderr_data->str);
+    log_done (task_id, argv[0], start_time, success ? 0 : (*proc_status != 0 ? *proc_status : -1), output_size);
+
+    if (success && stdout)
+        *stdout = g_string_free (stdout_data, FALSE);
+    else
+        g_string_free (stdout_data, TRUE);
+    if (success && stderr)
+        *stderr = g_string_free (stderr_data, FALSE);
+    else
+        g_string_free (stderr_data, TRUE);
+
+    return success;
+}
+
+/**
+ * bd_utils_exec_and_report_progress:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @prog_extract: (scope notified) (nullable): function for extracting progress information
+ * @proc_status: (out): place to store the process exit status (-1 if the process failed
+ *                      to start, timed out or its status couldn't be determined)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Note that any NULL bytes read from standard output and standard error
+ * output are treated as separators similar to newlines and @prog_extract
+ * will be called with the respective chunk.
+ *
+ * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ */
+gboolean bd_utils_exec_and_report_progress (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, gint *proc_status, GError **error) {
+    return _utils_exec_and_report_progress (argv, extra, prog_extract, NULL, NULL, NULL, proc_status, NULL, NULL, error);
+}
+
+/**
+ * bd_utils_exec_with_input:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @input: (nullable): input for the executed program
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ */
+gboolean bd_utils_exec_with_input (const gchar **argv, const gchar *input, const BDExtraArg **extra, GError **error) {
+    gint status = 0;
+    /* just use the "stronger" function providing dumb progress reporting (just
+       'started' and 'finished') and throw away the returned status */
+    return _utils_exec_and_report_progress (argv, extra, NULL, NULL, NULL, input, &status, NULL, NULL, error);
+}
+
+/**
+ * bd_utils_exec_and_stream_output:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @line_func: (scope call): function to call for every line of the standard output
+ * @line_data: (closure): data to pass to @line_func
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Similar to bd_utils_exec_and_capture_output() but instead of collecting the
+ * standard output and returning it as a single string when the process exits,
+ * the output is passed to @line_func line by line as it's being read so the
+ * lines can be processed while the process is still running. Only an incomplete
+ * last line is being kept in memory.
+ *
+ * Note that any NULL bytes read from the standard output are treated as separators
+ * similar to newlines and @line_func will be called with the respective chunk.
+ *
+ * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ */
+gboolean bd_utils_exec_and_stream_output (const gchar **argv, const BDExtraArg **extra, BDUtilsLineFunc line_func, gpointer line_data, GError **error) {
+    gint status = 0;
+
+    return _utils_exec_and_report_progress (argv, extra, NULL, line_func, line_data, NULL, &status, NULL, NULL, error);
+}
+
+/**
+ * _check_captured_output: (skip)
+ *
+ * Checks that the process provided some output. Takes ownership of
+ * @stdout and @stderr.
+ */
+static gboolean _check_captured_output (gint status, gchar *stdout, gchar *stderr, gchar **output, GError **error) {
+    if ((status != 0) || (g_strcmp0 ("", stdout) == 0)) {
+        if (status != 0)
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Process reported exit code %d: %s%s", status,
+                         stdout ? stdout : "",
+                         stderr ? stderr : "");
+        else
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_NOOUT,
+                         "Process didn't provide any data on standard output. "
+                         "Error output: %s", stderr ? stderr : "");
+        g_free (stderr);
+        g_free (stdout);
+        return FALSE;
+    } else {
+        *output = stdout;
+        g_free (stderr);
+        return TRUE;
+    }
+}
+
+/**
+ * bd_utils_exec_and_capture_output:
+ * @argv: (array zero-terminated=1): the argv array for the call
+ * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @output: (out): variable to store output to
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Note that any NULL bytes read from standard output and standard error
+ * output will be discarded.
+ *
+ * Returns: whether the @argv was successfully executed capturing the output or not
+ */
+gboolean bd_utils_exec_and_capture_output (const gchar **argv, const BDExtraArg **extra, gchar **output, GError **error) {
+    gint status = 0;
+    gchar *stdout = NULL;
+    gchar *stderr = NULL;
+    gboolean ret = FALSE;
+
+    ret = _utils_exec_and_report_progress (argv, extra, NULL, NULL, NULL, NULL, &status, &stdout, &stderr, error);
+    if (!ret)
+        return ret;
+
+    return _check_captured_output (status, stdout, stderr, output, error);
+}
+
+#if !GLIB_CHECK_VERSION(2, 58, 0)
+#define G_SOURCE_FUNC(f) ((GSourceFunc) (void (*)(void)) (f))
+#endif
+
+typedef struct ExecAsyncData {
+    guint64 task_id;
+    gchar *util;
+    gint64 start_time;
+    gsize output_size;
+    guint64 progress_id;
+    GPid pid;
+    gint pidfd;
+    gint out_fd;
+    gint err_fd;
+    BDUtilsProgExtract prog_extract;
+    guint8 completion;
+    GString *stdout_buffer;
+    GString *stderr_buffer;
+    gsize stdout_buffer_pos;
+    gsize stderr_buffer_pos;
+    GString *stdout_data;
+    GString *stderr_data;
+    gboolean out_done;
+    gboolean err_done;
+    GSource *out_source;
+    GSource *err_source;
+    GSource *child_source;
+    gint wait_status;
+    gint proc_status;
+    GSource *timeout_source;
+    guint64 timeout;
+    gboolean timed_out;
+    GError *error;
+    /* protects @exited, the cancellation handler may run in a different thread */
+    GMutex lock;
+    gboolean exited;
+    gulong cancel_id;
+} ExecAsyncData;
+
+/* the sources hold references to the task so they are already gone when this is called */
+static void _exec_async_data_free (ExecAsyncData *data) {
+    if (data->pidfd >= 0)
+        close (data->pidfd);
+    if (data->out_fd >= 0)
+        close (data->out_fd);
+    if (data->err_fd >= 0)
+        close (data->err_fd);
+    if (data->stdout_buffer)
+        g_string_free (data->stdout_buffer, TRUE);
+    if (data->stderr_buffer)
+        g_string_free (data->stderr_buffer, TRUE);
+    if (data->stdout_data)
+        g_string_free (data->stdout_data, TRUE);
+    if (data->stderr_data)
+        g_string_free (data->stderr_data, TRUE);
+    g_clear_error (&(data->error));
+    g_mutex_clear (&(data->lock));
+    g_free (data->util);
+    g_free (data);
+}
+
+/* must be called with data->lock held */
+static void _exec_async_kill (ExecAsyncData *data, gint sig) {
+    if (data->exited)
+        return;
+
+    if (data->pidfd < 0) {
+        /* the process is reaped by GLib's child watch which doesn't take our
+           lock so it may already be gone (see _utils_exec_async()) */
+        _kill_process_group (data->pid, sig);
+        return;
+    }
+
+    /* the process is only reaped with the lock held (in _exec_async_pidfd_ready())
+       so it cannot be gone and its PID (and thus process group ID) reused yet */
+    if (kill (-data->pid, sig) != 0 && errno == ESRCH)
+        /* the process may have failed to become a group leader */
+        _pidfd_send_signal (data->pidfd, sig);
+}
+
+static void _exec_async_cancelled (GCancellable *cancellable G_GNUC_UNUSED, gpointer user_data) {
+    ExecAsyncData *data = user_data;
+
+    g_mutex_lock (&(data->lock));
+    _exec_async_kill (data, SIGKILL);
+    g_mutex_unlock (&(data->lock));
+}
+
+static void _exec_async_return (GTask *task) {
+    ExecAsyncData *data = g_task_get_task_data (task);
+    GCancellable *cancellable = g_task_get_cancellable (task);
+    GError *l_error = NULL;
+
+    if (!(data->out_done && data->err_done && data->exited))
+        /* still waiting for something */
+        return;
+
+    if (data->cancel_id) {
+        g_cancellable_disconnect (cancellable, data->cancel_id);
+        data->cancel_id = 0;
+    }
+    if (data->timeout_source) {
+        g_source_destroy (data->timeout_source);
+        g_clear_pointer (&(data->timeout_source), g_source_unref);
+    }
+
+    if (data->error) {
+        bd_utils_report_finished (data->progress_id, data->error->message);
+        l_error = data->error;
+        data->error = NULL;
+    } else if (data->timed_out && !g_cancellable_is_cancelled (cancellable)) {
+        g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_TIMEOUT,
+                     "Process didn't finish within %"G_GUINT64_FORMAT" ms and was terminated", data->timeout);
+        bd_utils_report_finished (data->progress_id, l_error->message);
+    } else if (!_check_exec_status (data->progress_id, data->wait_status, data->stdout_data, data->stderr_data,
+                                    &(data->proc_status), &l_error) && g_cancellable_is_cancelled (cancellable)) {
+        /* process killed because of the cancellation */
+        g_clear_error (&l_error);
+        g_cancellable_set_error_if_cancelled (cancellable, &l_error);
+    }
+
+    log_out (data->task_id, data->stdout_data->str, data->stderr_data->str);
+    log_done (data->task_id, data->util, data->start_time, l_error ? (data->proc_status != 0 ? data->proc_status : -1) : 0,
+              data->output_size);
+
+    if (l_error)
+        g_task_return_error (task, l_error);
+    else
+        g_task_return_boolean (task, TRUE);
+}
+
+static gboolean _exec_async_process_fd (GTask *task, gint fd, struct pollfd *poll_fd) {
+    ExecAsyncData *data = g_task_get_task_data (task);
+    GError *l_error = NULL;
+    gboolean *done = NULL;
+    gboolean success = FALSE;
+
+    if (fd == data->out_fd) {
+        done = &(data->out_done);
+        success = _process_fd_event (fd, poll_fd, data->stdout_buffer, data->stdout_data, &(data->stdout_buffer_pos), done, &(data->output_size),
+                                     data->progress_id, &(data->completion), data->prog_extract, NULL, NULL, &l_error);
+    } else {
+        done = &(data->err_done);
+        success = _process_fd_event (fd, poll_fd, data->stderr_buffer, data->stderr_data, &(data->stderr_buffer_pos), done, &(data->output_size),
+                                     data->progress_id, &(data->completion), data->prog_extract, NULL, NULL, &l_error);
+    }
+
+    if (!success) {
+        /* no point in reading any further, just wait for the process */
+        if (!data->error)
+            data->error = l_error;
+        else
+            g_clear_error (&l_error);
+        *done = TRUE;
+    }
+
+    return *done;
+}
+
+static gboolean _exec_async_fd_ready (gint fd, GIOCondition condition, gpointer user_data) {
+    GTask *task = user_data;
+    ExecAsyncData *data = g_task_get_task_data (task);
+    struct pollfd poll_fd = ZERO_INIT;
+
+    poll_fd.fd = fd;
+    if (condition & G_IO_IN)
+        poll_fd.revents |= POLLIN;
+    if (condition & G_IO_HUP)
+        poll_fd.revents |= POLLHUP;
+    if (condition & G_IO_ERR)
+        poll_fd.revents |= POLLERR;
+    if (condition & G_IO_NVAL)
+        poll_fd.revents |= POLLNVAL;
+
+    if (!_exec_async_process_fd (task, fd, &poll_fd))
+        return G_SOURCE_CONTINUE;
+
+    if (fd == data->out_fd)
+        g_clear_pointer (&(data->out_source), g_source_unref);
+    else
+        g_clear_pointer (&(data->err_source), g_source_unref);
+
+    _exec_async_return (task);
+
+    return G_SOURCE_REMOVE;
+}
+
+/* called once the process has been reaped */
+static void _exec_async_process_exited (GTask *task) {
+    ExecAsyncData *data = g_task_get_task_data (task);
+    struct pollfd exited_fd = ZERO_INIT;
+
+    g_clear_pointer (&(data->child_source), g_source_unref);
+
+    /* the process exited, everything it has written is already in the pipes
+       which may still be kept open by its children */
+    exited_fd.revents = POLLIN | POLLHUP;
+    if (!data->out_done) {
+        _exec_async_process_fd (task, data->out_fd, &exited_fd);
+        g_source_destroy (data->out_source);
+        g_clear_pointer (&(data->out_source), g_source_unref);
+    }
+    if (!data->err_done) {
+        _exec_async_process_fd (task, data->err_fd, &exited_fd);
+        g_source_destroy (data->err_source);
+        g_clear_pointer (&(data->err_source), g_source_unref);
+    }
+
+    _exec_async_return (task);
+}
+
+static void _exec_async_child_exited (GPid pid G_GNUC_UNUSED, gint wait_status, gpointer user_data) {
+    GTask *task = user_data;
+    ExecAsyncData *data = g_task_get_task_data (task);
+
+    g_mutex_lock (&(data->lock));
+    data->exited = TRUE;
+    data->wait_status = wait_status;
+    g_mutex_unlock (&(data->lock));
+
+    _exec_async_process_exited (task);
+}
+
+static gboolean _exec_async_pidfd_ready (gint fd G_GNUC_UNUSED, GIOCondition condition G_GNUC_UNUSED, gpointer user_data) {
+    GTask *task = user_data;
+    ExecAsyncData *data = g_task_get_task_data (task);
+    gint wait_status = 0;
+    pid_t ret = 0;
+
+    /* reap the process with the lock held so that it cannot be killed by
+       _exec_async_kill() after its PID has been released */
+    g_mutex_lock (&(data->lock));
+    ret = waitpid (data->pid, &wait_status, WNOHANG);
+    if (ret == 0) {
+        /* not really exited yet */
+        g_mutex_unlock (&(data->lock));
+        return G_SOURCE_CONTINUE;
+    }
+    if (ret < 0) {
+        bd_utils_log_format (BD_UTILS_LOG_WARNING, "Failed to get the exit status of the process %d: %m", data->pid);
+        /* reported as killed with a signal */
+        wait_status = SIGKILL;
+    }
+    data->exited = TRUE;
+    data->wait_status = wait_status;
+    g_mutex_unlock (&(data->lock));
+
+    _exec_async_process_exited (task);
+
+    return G_SOURCE_REMOVE;
+}
+
+static GSource* _exec_async_attach_timeout_source (GTask *task, guint timeout);
+
+static gboolean _exec_async_timed_out (gpointer user_data) {
+    GTask *task = user_data;
+    ExecAsyncData *data = g_task_get_task_data (task);
+    gint kill_signal = data->timed_out ? SIGKILL : SIGTERM;
+
+    /* terminate the whole process group, kill it if it's still running after the grace period */
+    g_mutex_lock (&(data->lock));
+    if (!data->exited) {
+        bd_utils_log_format (BD_UTILS_LOG_WARNING, "Process %d timed out, sending signal %d to its process group",
+                             data->pid, kill_signal);
+        _exec_async_kill (data, kill_signal);
+    }
+    g_mutex_unlock (&(data->lock));
+
+    g_clear_pointer (&(data->timeout_source), g_source_unref);
+    if (!data->timed_out) {
+        data->timed_out = TRUE;
+        data->timeout_source = _exec_async_attach_timeout_source (task, _EXEC_KILL_GRACE_PERIOD);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
+static GSource* _exec_async_attach_timeout_source (GTask *task, guint timeout) {
+    GSource *source = NULL;
+
+    source = g_timeout_source_new (timeout);
+    g_source_set_callback (source, _exec_async_timed_out, g_object_ref (task), g_object_unref);
+    g_source_attach (source, g_task_get_context (task));
+
+    return source;
+}
+
+static GSource* _exec_async_attach_fd_source (GTask *task, gint fd) {
+    GSource *source = NULL;
+
+    source = g_unix_fd_source_new (fd, G_IO_IN | G_IO_HUP | G_IO_ERR);
+    g_source_set_callback (source, G_SOURCE_FUNC (_exec_async_fd_ready), g_object_ref (task), g_object_unref);
+    g_source_attach (source, g_task_get_context (task));
+
+    return source;
+}
+
+static void _utils_exec_async (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, GCancellable *cancellable,
+                               GAsyncReadyCallback callback, gpointer user_data, gpointer source_tag) {
+    GTask *task = NULL;
+    ExecAsyncData *data = NULL;
+    const gchar **args = NULL;
+    gchar *args_str = NULL;
+    gchar *msg = NULL;
+    gchar **new_env = NULL;
+    gint flags;
+    GError *l_error = NULL;
+
+    task = g_task_new (NULL, cancellable, callback, user_data);
+    g_task_set_source_tag (task, source_tag);
 
-        if (num_written < 0) {
-            g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                         "Failed to write to stdin of the process: %m");
-            bd_utils_report_finished (progress_id, l_error->message);
-            g_propagate_error (error, l_error);
-            /* would overwrite errno, need to close as a last step */
-            close (in_fd);
-            close (out_fd);
-            close (err_fd);
-            waitpid (pid, NULL, 0);
-            return FALSE;
-        }
-        close (in_fd);
-        g_warn_if_fail (len - num_written_total == 0);
-    }
+    data = g_new0 (ExecAsyncData, 1);
+    data->pidfd = -1;
+    data->out_fd = -1;
+    data->err_fd = -1;
+    data->prog_extract = prog_extract;
+    data->timeout = thread_exec_timeout;
+    g_mutex_init (&(data->lock));
+    g_task_set_task_data (task, data, (GDestroyNotify) _exec_async_data_free);
 
-    stdout_data = g_string_new (NULL);
-    stdout_buffer = g_string_new (NULL);
-    stderr_data = g_string_new (NULL);
-    stderr_buffer = g_string_new (NULL);
+    args = _append_extra_args (argv, extra);
 
-    fds[0].fd = out_fd;
-    fds[1].fd = err_fd;
-    fds[0].events = POLLIN | POLLHUP | POLLERR;
-    fds[1].events = POLLIN | POLLHUP | POLLERR;
-    while (! (out_done && err_done)) {
-        poll_status = poll (fds, 2, -1 /* timeout */);
-        g_warn_if_fail (poll_status != 0);  /* no timeout specified, zero should never be returned */
-        if (poll_status < 0) {
-            if (errno == EAGAIN || errno == EINTR)
-                continue;
-            g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                         "Failed to poll output FDs: %m");
-            bd_utils_report_finished (progress_id, l_error->message);
-            g_propagate_error (error, l_error);
-            success = FALSE;
-            break;
-        }
+    data->util = g_strdup (argv[0]);
+    data->task_id = log_running (args ? args : argv, &(data->start_time));
 
-        if (!out_done) {
-            if (! _process_fd_event (out_fd, &fds[0], stdout_buffer, stdout_data, &stdout_buffer_pos, &out_done, progress_id, &completion, prog_extract, &l_error)) {
-                bd_utils_report_finished (progress_id, l_error->message);
-                g_propagate_error (error, l_error);
-                success = FALSE;
-                break;
-            }
-        }
+    new_env = _get_exec_env ();
 
-        if (!err_done) {
-            if (! _process_fd_event (err_fd, &fds[1], stderr_buffer, stderr_data, &stderr_buffer_pos, &err_done, progress_id, &completion, prog_extract, &l_error)) {
-                bd_utils_report_finished (progress_id, l_error->message);
-                g_propagate_error (error, l_error);
-                success = FALSE;
-                break;
-            }
-        }
+    /* new process group so that the process can be killed together with its children on cancellation or timeout */
+    if (!_spawn_with_pipes (args ? args : argv, new_env, TRUE, &(data->pid), NULL, &(data->out_fd), &(data->err_fd), &l_error)) {
+        log_done (data->task_id, data->util, data->start_time, -1, 0);
+        g_strfreev (new_env);
+        g_free (args);
+        g_task_return_error (task, l_error);
+        g_object_unref (task);
+        return;
     }
+    g_strfreev (new_env);
+    BD_PROBE3 (exec_spawn, data->task_id, argv[0], data->pid);
 
-    g_string_free (stdout_buffer, TRUE);
-    g_string_free (stderr_buffer, TRUE);
-    close (out_fd);
-    close (err_fd);
+    args_str = g_strjoinv (" ", args ? (gchar **) args : (gchar **) argv);
+    msg = g_strdup_printf ("Started '%s'", args_str);
+    data->progress_id = bd_utils_report_started (msg);
+    g_free (args_str);
+    g_free (args);
+    g_free (msg);
 
-    child_ret = waitpid (pid, &status, 0);
-    if (success) {
-        if (child_ret > 0) {
-            if (WIFSIGNALED (status)) {
-                *proc_status = 128 + WTERMSIG (status);
-                g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                             "Process killed with a signal");
-                bd_utils_report_finished (progress_id, l_error->message);
-                g_propagate_error (error, l_error);
-                success = FALSE;
-            } else if (WIFEXITED (status) && WEXITSTATUS (status) != 0) {
-                *proc_status = WEXITSTATUS (status);
-                msg = stderr_data->len > 0 ? stderr_data->str : stdout_data->str;
-                g_set_error (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                             "Process reported exit code %d: %s", *proc_status, msg);
-                bd_utils_report_finished (progress_id, l_error->message);
-                g_propagate_error (error, l_error);
-                success = FALSE;
-            } else {
-                *proc_status = WIFEXITED (status) ? WEXITSTATUS (status) : 0;
-            }
-        } else if (child_ret == -1) {
-            if (errno != ECHILD) {
-                errno = 0;
-                g_set_error_literal (&l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                                     "Failed to wait for the process");
-                bd_utils_report_finished (progress_id, l_error->message);
-                g_propagate_error (error, l_error);
-                success = FALSE;
-            } else {
-                /* no such process (the child exited before we tried to wait for it) */
-                errno = 0;
-            }
-        }
-        if (success)
-            bd_utils_report_finished (progress_id, "Completed");
+    /* set both fds for non-blocking read */
+    flags = fcntl (data->out_fd, F_GETFL, 0);
+    if (fcntl (data->out_fd, F_SETFL, flags | O_NONBLOCK))
+        bd_utils_log_format (BD_UTILS_LOG_WARNING,
+                             "_utils_exec_async: Failed to set out_fd non-blocking: %m");
+    flags = fcntl (data->err_fd, F_GETFL, 0);
+    if (fcntl (data->err_fd, F_SETFL, flags | O_NONBLOCK))
+        bd_utils_log_format (BD_UTILS_LOG_WARNING,
+                             "_utils_exec_async: Failed to set err_fd non-blocking: %m");
+
+    data->stdout_buffer = g_string_new (NULL);
+    data->stderr_buffer = g_string_new (NULL);
+    data->stdout_data = g_string_new (NULL);
+    data->stderr_data = g_string_new (NULL);
+
+    data->out_source = _exec_async_attach_fd_source (task, data->out_fd);
+    data->err_source = _exec_async_attach_fd_source (task, data->err_fd);
+
+    /* reaps the process, with a pidfd we reap it ourselves so that it cannot
+       be reaped (and its PID reused) while it's being killed on cancellation
+       or timeout, GLib's child watch is only used if pidfds are not supported */
+    data->pidfd = _pidfd_open (data->pid);
+    if (data->pidfd >= 0) {
+        data->child_source = g_unix_fd_source_new (data->pidfd, G_IO_IN);
+        g_source_set_callback (data->child_source, G_SOURCE_FUNC (_exec_async_pidfd_ready), g_object_ref (task), g_object_unref);
+    } else {
+        data->child_source = g_child_watch_source_new (data->pid);
+        g_source_set_callback (data->child_source, G_SOURCE_FUNC (_exec_async_child_exited), g_object_ref (task), g_object_unref);
     }
-    log_out (task_id, stdout_data->str, stderr_data->str);
-    log_done (task_id, *proc_status);
+    g_source_attach (data->child_source, g_task_get_context (task));
 
-    if (success && stdout)
-        *stdout = g_string_free (stdout_data, FALSE);
-    else
-        g_string_free (stdout_data, TRUE);
-    if (success && stderr)
-        *stderr = g_string_free (stderr_data, FALSE);
-    else
-        g_string_free (stderr_data, TRUE);
+    if (data->timeout > 0)
+        data->timeout_source = _exec_async_attach_timeout_source (task, (guint) MIN (data->timeout, G_MAXUINT));
 
-    return success;
+    if (cancellable)
+        data->cancel_id = g_cancellable_connect (cancellable, G_CALLBACK (_exec_async_cancelled), data, NULL);
+
+    /* the sources keep the task alive */
+    g_object_unref (task);
 }
 
 /**
- * bd_utils_exec_and_report_progress:
+ * bd_utils_exec_and_report_error_async:
  * @argv: (array zero-terminated=1): the argv array for the call
  * @extra: (nullable) (array zero-terminated=1): extra arguments
- * @prog_extract: (scope notified) (nullable): function for extracting progress information
- * @proc_status: (out): place to store the process exit status
- * @error: (out) (optional): place to store error (if any)
+ * @cancellable: (nullable): a #GCancellable to cancel the call (kills the process
+ *                           together with all processes in its process group)
+ * @callback: (scope async): callback to call when the process finishes
+ * @user_data: (closure): data to pass to @callback
  *
- * Note that any NULL bytes read from standard output and standard error
- * output are treated as separators similar to newlines and @prog_extract
- * will be called with the respective chunk.
+ * Asynchronous version of bd_utils_exec_and_report_error(). The process is watched
+ * by the thread-default main context of the calling thread and @callback is called
+ * in the same context. Call bd_utils_exec_and_report_error_finish() from
+ * @callback to get the result.
+ */
+void bd_utils_exec_and_report_error_async (const gchar **argv, const BDExtraArg **extra, GCancellable *cancellable,
+                                           GAsyncReadyCallback callback, gpointer user_data) {
+    _utils_exec_async (argv, extra, NULL, cancellable, callback, user_data, bd_utils_exec_and_report_error_async);
+}
+
+/**
+ * bd_utils_exec_and_report_error_finish:
+ * @result: the #GAsyncResult passed to the callback of bd_utils_exec_and_report_error_async()
+ * @error: (out) (optional): place to store error (if any)
  *
- * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ * Returns: whether the process was successfully executed (no error and exit code 0) or not
  */
-gboolean bd_utils_exec_and_report_progress (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, gint *proc_status, GError **error) {
-    return _utils_exec_and_report_progress (argv, extra, prog_extract, NULL, proc_status, NULL, NULL, error);
+gboolean bd_utils_exec_and_report_error_finish (GAsyncResult *result, GError **error) {
+    g_return_val_if_fail (g_task_is_valid (result, NULL), FALSE);
+
+    return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 /**
- * bd_utils_exec_with_input:
+ * bd_utils_exec_and_report_progress_async:
  * @argv: (array zero-terminated=1): the argv array for the call
- * @input: (nullable): input for the executed program
  * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @prog_extract: (scope forever) (nullable): function for extracting progress information
+ * @cancellable: (nullable): a #GCancellable to cancel the call (kills the process
+ *                           together with all processes in its process group)
+ * @callback: (scope async): callback to call when the process finishes
+ * @user_data: (closure): data to pass to @callback
+ *
+ * Asynchronous version of bd_utils_exec_and_report_progress(). The progress is
+ * reported using bd_utils_report_progress() from the thread-default main context
+ * of the calling thread. Call bd_utils_exec_and_report_progress_finish() from
+ * @callback to get the result.
+ */
+void bd_utils_exec_and_report_progress_async (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract,
+                                              GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data) {
+    _utils_exec_async (argv, extra, prog_extract, cancellable, callback, user_data, bd_utils_exec_and_report_progress_async);
+}
+
+/**
+ * bd_utils_exec_and_report_progress_finish:
+ * @result: the #GAsyncResult passed to the callback of bd_utils_exec_and_report_progress_async()
+ * @proc_status: (out): place to store the process exit status
  * @error: (out) (optional): place to store error (if any)
  *
- * Returns: whether the @argv was successfully executed (no error and exit code 0) or not
+ * Returns: whether the process was successfully executed (no error and exit code 0) or not
  */
-gboolean bd_utils_exec_with_input (const gchar **argv, const gchar *input, const BDExtraArg **extra, GError **error) {
-    gint status = 0;
-    /* just use the "stronger" function providing dumb progress reporting (just
-       'started' and 'finished') and throw away the returned status */
-    return _utils_exec_and_report_progress (argv, extra, NULL, input, &status, NULL, NULL, error);
+gboolean bd_utils_exec_and_report_progress_finish (GAsyncResult *result, gint *proc_status, GError **error) {
+    ExecAsyncData *data = NULL;
+
+    g_return_val_if_fail (g_task_is_valid (result, NULL), FALSE);
+
+    data = g_task_get_task_data (G_TASK (result));
+    *proc_status = data->proc_status;
+
+    return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 /**
- * bd_utils_exec_and_capture_output:
+ * bd_utils_exec_and_capture_output_async:
  * @argv: (array zero-terminated=1): the argv array for the call
  * @extra: (nullable) (array zero-terminated=1): extra arguments
+ * @cancellable: (nullable): a #GCancellable to cancel the call (kills the process
+ *                           together with all processes in its process group)
+ * @callback: (scope async): callback to call when the process finishes
+ * @user_data: (closure): data to pass to @callback
+ *
+ * Asynchronous version of bd_utils_exec_and_capture_output(). Call
+ * bd_utils_exec_and_capture_output_finish() from @callback to get the result.
+ */
+void bd_utils_exec_and_capture_output_async (const gchar **argv, const BDExtraArg **extra, GCancellable *cancellable,
+                                             GAsyncReadyCallback callback, gpointer user_data) {
+    _utils_exec_async (argv, extra, NULL, cancellable, callback, user_data, bd_utils_exec_and_capture_output_async);
+}
+
+/**
+ * bd_utils_exec_and_capture_output_finish:
+ * @result: the #GAsyncResult passed to the callback of bd_utils_exec_and_capture_output_async()
  * @output: (out): variable to store output to
  * @error: (out) (optional): place to store error (if any)
  *
- * Note that any NULL bytes read from standard output and standard error
- * output will be discarded.
- *
- * Returns: whether the @argv was successfully executed capturing the output or not
+ * Returns: whether the process was successfully executed capturing the output or not
  */
-gboolean bd_utils_exec_and_capture_output (const gchar **argv, const BDExtraArg **extra, gchar **output, GError **error) {
-    gint status = 0;
+gboolean bd_utils_exec_and_capture_output_finish (GAsyncResult *result, gchar **output, GError **error) {
+    ExecAsyncData *data = NULL;
     gchar *stdout = NULL;
     gchar *stderr = NULL;
-    gboolean ret = FALSE;
 
-    ret = _utils_exec_and_report_progress (argv, extra, NULL, NULL, &status, &stdout, &stderr, error);
-    if (!ret)
-        return ret;
+    g_return_val_if_fail (g_task_is_valid (result, NULL), FALSE);
 
-    if ((status != 0) || (g_strcmp0 ("", stdout) == 0)) {
-        if (status != 0)
-            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
-                         "Process reported exit code %d: %s%s", status,
-                         stdout ? stdout : "",
-                         stderr ? stderr : "");
-        else
-            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_NOOUT,
-                         "Process didn't provide any data on standard output. "
-                         "Error output: %s", stderr ? stderr : "");
-        g_free (stderr);
-        g_free (stdout);
+    if (!g_task_propagate_boolean (G_TASK (result), error))
         return FALSE;
-    } else {
-        *output = stdout;
-        g_free (stderr);
-        return TRUE;
+
+    data = g_task_get_task_data (G_TASK (result));
+    stdout = g_string_free (data->stdout_data, FALSE);
+    stderr = g_string_free (data->stderr_data, FALSE);
+    data->stdout_data = NULL;
+    data->stderr_data = NULL;
+
+    return _check_captured_output (data->proc_status, stdout, stderr, output, error);
+}
+
+/**
+ * bd_utils_set_exec_timeout_thread:
+ * @timeout: timeout (in milliseconds) for utilities executed from the current
+ *           thread or 0 for no timeout (the default)
+ *
+ * Utilities executed by the exec functions (including all plugin functions running
+ * utilities) from the current thread that don't finish within @timeout are terminated
+ * together with all processes in their process group using SIGTERM, followed by
+ * SIGKILL if they don't exit within 5 seconds. The exec functions then fail with
+ * the %BD_UTILS_EXEC_ERROR_TIMEOUT error.
+ *
+ * The asynchronous exec functions use the timeout set for the thread they are
+ * called from.
+ */
+void bd_utils_set_exec_timeout_thread (guint64 timeout) {
+    thread_exec_timeout = timeout;
+}
+
+/**
+ * bd_utils_get_exec_timeout_thread:
+ *
+ * Returns: timeout (in milliseconds) for utilities executed from the current
+ *          thread or 0 if not set, see bd_utils_set_exec_timeout_thread()
+ */
+guint64 bd_utils_get_exec_timeout_thread (void) {
+    return thread_exec_timeout;
+}
+
+/**
+ * bd_utils_get_exec_stats:
+ *
+ * Statistics are collected for all utilities run by the library (aggregated
+ * per the utility name, i.e. `argv[0]` without the path) since the process
+ * start or the last call of bd_utils_reset_exec_stats().
+ *
+ * Returns: (transfer full) (array zero-terminated=1): snapshot of execution
+ *          statistics for all utilities run so far
+ */
+BDUtilsExecStats** bd_utils_get_exec_stats (void) {
+    BDUtilsExecStats **ret = NULL;
+    GHashTableIter iter;
+    gpointer value = NULL;
+    guint i = 0;
+
+    g_mutex_lock (&exec_stats_lock);
+    ret = g_new0 (BDUtilsExecStats*, (exec_stats ? g_hash_table_size (exec_stats) : 0) + 1);
+    if (exec_stats) {
+        g_hash_table_iter_init (&iter, exec_stats);
+        while (g_hash_table_iter_next (&iter, NULL, &value))
+            ret[i++] = bd_utils_exec_stats_copy ((BDUtilsExecStats *) value);
     }
+    g_mutex_unlock (&exec_stats_lock);
+
+    return ret;
+}
+
+/**
+ * bd_utils_reset_exec_stats:
+ *
+ * Resets execution statistics for all utilities, see bd_utils_get_exec_stats().
+ */
+void bd_utils_reset_exec_stats (void) {
+    g_mutex_lock (&exec_stats_lock);
+    if (exec_stats)
+        g_hash_table_remove_all (exec_stats);
+    g_mutex_unlock (&exec_stats_lock);
 }
 
 /**
@@ -726,6 +1899,178 @@ gint bd_utils_version_cmp (const gchar *ver_string1, const gchar *ver_string2, G
     return ret;
 }
 
+/* other users must not be able to tamper with the cached versions */
+static gboolean _version_cache_dir_safe (const struct stat *st) {
+    return S_ISDIR (st->st_mode) && st->st_uid == geteuid () && !(st->st_mode & (S_IWGRP | S_IWOTH));
+}
+
+/**
+ * bd_utils_set_version_cache_dir:
+ * @cache_dir: (nullable): directory to store the cached version information in
+ *             or %NULL to disable the cache (the default)
+ * @error: (out) (optional): place to store error (if any)
+ *
+ * Enables caching of the version information of the utilities checked by
+ * bd_utils_check_util_version() (and thus by the plugins' dependency checks)
+ * in @cache_dir so that the utilities don't need to be run again by other
+ * processes. The cached information is only used if the path, device, inode,
+ * size and modification time of the utility's binary match the cached values.
+ *
+ * @cache_dir is created if it doesn't exist and it has to be owned by the
+ * current user and not writable by anybody else. A runtime directory (e.g.
+ * `$XDG_RUNTIME_DIR/libblockdev` or `/run/libblockdev`) is a good choice so
+ * that the cache doesn't survive reboots.
+ *
+ * Returns: whether the cache directory was successfully set or not
+ */
+gboolean bd_utils_set_version_cache_dir (const gchar *cache_dir, GError **error) {
+    struct stat st;
+
+    if (cache_dir) {
+        if (g_mkdir_with_parents (cache_dir, 0700) != 0) {
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Failed to create the version cache directory '%s': %s", cache_dir, g_strerror (errno));
+            return FALSE;
+        }
+        if (stat (cache_dir, &st) != 0) {
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "Failed to stat the version cache directory '%s': %s", cache_dir, g_strerror (errno));
+            return FALSE;
+        }
+        if (!_version_cache_dir_safe (&st)) {
+            g_set_error (error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED,
+                         "'%s' is not a directory owned by the current user and writable only by it", cache_dir);
+            return FALSE;
+        }
+    }
+
+    g_mutex_lock (&version_cache_lock);
+    g_free (version_cache_dir);
+    version_cache_dir = g_strdup (cache_dir);
+    g_mutex_unlock (&version_cache_lock);
+
+    return TRUE;
+}
+
+/**
+ * bd_utils_get_version_cache_dir:
+ *
+ * Returns: (transfer full): directory the version information of utilities is
+ *                           cached in or %NULL if the cache is disabled, see
+ *                           bd_utils_set_version_cache_dir()
+ */
+gchar* bd_utils_get_version_cache_dir (void) {
+    gchar *ret = NULL;
+
+    g_mutex_lock (&version_cache_lock);
+    ret = g_strdup (version_cache_dir);
+    g_mutex_unlock (&version_cache_lock);
+
+    return ret;
+}
+
+#define _VERSION_CACHE_GROUP "Version"
+
+/**
+ * _version_cache_entry_path: (skip)
+ *
+ * Returns: path of the cache file for the output of `$util_path $version_arg`
+ *          or %NULL if the cache is disabled or the cache directory is not safe
+ *          to use
+ *
+ * The cache directory is checked every time because its ownership and
+ * permissions may have changed since it was set with
+ * bd_utils_set_version_cache_dir().
+ */
+static gchar* _version_cache_entry_path (const gchar *util_path, const gchar *version_arg) {
+    g_autofree gchar *cache_dir = NULL;
+    g_autofree gchar *key = NULL;
+    g_autofree gchar *checksum = NULL;
+    struct stat st;
+
+    cache_dir = bd_utils_get_version_cache_dir ();
+    if (!cache_dir)
+        return NULL;
+
+    if (stat (cache_dir, &st) != 0 || !_version_cache_dir_safe (&st)) {
+        bd_utils_log_format (BD_UTILS_LOG_DEBUG, "Not using the version cache directory '%s', it is not "
+                             "a directory owned by the current user and writable only by it", cache_dir);
+        return NULL;
+    }
+
+    key = g_strdup_printf ("%s %s", util_path, version_arg);
+    checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA256, key, -1);
+
+    return g_strdup_printf ("%s/%s.version", cache_dir, checksum);
+}
+
+/**
+ * _version_cache_lookup: (skip)
+ *
+ * Returns: cached output of `$util_path $version_arg` or %NULL if there is no
+ *          valid cache entry for the binary described by @st
+ */
+static gchar* _version_cache_lookup (const gchar *entry_path, const gchar *util_path, const gchar *version_arg, const struct stat *st) {
+    GKeyFile *key_file = NULL;
+    g_autofree gchar *path = NULL;
+    g_autofree gchar *arg = NULL;
+    gchar *output = NULL;
+
+    key_file = g_key_file_new ();
+    if (!g_key_file_load_from_file (key_file, entry_path, G_KEY_FILE_NONE, NULL)) {
+        g_key_file_free (key_file);
+        return NULL;
+    }
+
+    path = g_key_file_get_string (key_file, _VERSION_CACHE_GROUP, "Path", NULL);
+    arg = g_key_file_get_string (key_file, _VERSION_CACHE_GROUP, "Arg", NULL);
+
+    if (g_strcmp0 (path, util_path) == 0 && g_strcmp0 (arg, version_arg) == 0 &&
+        g_key_file_get_uint64 (key_file, _VERSION_CACHE_GROUP, "Device", NULL) == (guint64) st->st_dev &&
+        g_key_file_get_uint64 (key_file, _VERSION_CACHE_GROUP, "Inode", NULL) == (guint64) st->st_ino &&
+        g_key_file_get_uint64 (key_file, _VERSION_CACHE_GROUP, "Size", NULL) == (guint64) st->st_size &&
+        g_key_file_get_int64 (key_file, _VERSION_CACHE_GROUP, "MTime", NULL) == (gint64) st->st_mtim.tv_sec &&
+        g_key_file_get_int64 (key_file, _VERSION_CACHE_GROUP, "MTimeNSec", NULL) == (gint64) st->st_mtim.tv_nsec)
+        output = g_key_file_get_string (key_file, _VERSION_CACHE_GROUP, "Output", NULL);
+
+    g_key_file_free (key_file);
+
+    return output;
+}
+
+/**
+ * _version_cache_store: (skip)
+ *
+ * Stores @output of `$util_path $version_arg` for the binary described by @st
+ * in the cache. Failures are not fatal, the cache is just not updated then.
+ */
+static void _version_cache_store (const gchar *entry_path, const gchar *util_path, const gchar *version_arg, const struct stat *st, const gchar *output) {
+    GKeyFile *key_file = NULL;
+    g_autofree gchar *data = NULL;
+    gsize data_len = 0;
+    GError *l_error = NULL;
+
+    key_file = g_key_file_new ();
+    g_key_file_set_string (key_file, _VERSION_CACHE_GROUP, "Path", util_path);
+    g_key_file_set_string (key_file, _VERSION_CACHE_GROUP, "Arg", version_arg);
+    g_key_file_set_uint64 (key_file, _VERSION_CACHE_GROUP, "Device", (guint64) st->st_dev);
+    g_key_file_set_uint64 (key_file, _VERSION_CACHE_GROUP, "Inode", (guint64) st->st_ino);
+    g_key_file_set_uint64 (key_file, _VERSION_CACHE_GROUP, "Size", (guint64) st->st_size);
+    g_key_file_set_int64 (key_file, _VERSION_CACHE_GROUP, "MTime", (gint64) st->st_mtim.tv_sec);
+    g_key_file_set_int64 (key_file, _VERSION_CACHE_GROUP, "MTimeNSec", (gint64) st->st_mtim.tv_nsec);
+    g_key_file_set_string (key_file, _VERSION_CACHE_GROUP, "Output", output);
+
+    data = g_key_file_to_data (key_file, &data_len, NULL);
+    g_key_file_free (key_file);
+
+    /* g_file_set_contents() writes a temporary file and renames it so readers
+       never see a partially written entry */
+    if (!g_file_set_contents (entry_path, data, data_len, &l_error)) {
+        bd_utils_log_format (BD_UTILS_LOG_DEBUG, "Failed to cache version of %s: %s", util_path, l_error->message);
+        g_clear_error (&l_error);
+    }
+}
+
 /**
  * bd_utils_check_util_version:
  * @util: name of the utility to check
@@ -753,6 +2098,8 @@ gboolean bd_utils_check_util_version (const gchar *util, const gchar *version, c
     GMatchInfo *match_info = NULL;
     gchar *version_str = NULL;
     GError *l_error = NULL;
+    gchar *cache_entry = NULL;
+    struct stat st = ZERO_INIT;
 
     util_path = g_find_program_in_path (util);
     if (!util_path) {
@@ -760,24 +2107,43 @@ gboolean bd_utils_check_util_version (const gchar *util, const gchar *version, c
                      "The '%s' utility is not available", util);
         return FALSE;
     }
-    g_free (util_path);
 
-    if (!version)
+    if (!version) {
         /* nothing more to do here */
+        g_free (util_path);
         return TRUE;
+    }
 
-    succ = bd_utils_exec_and_capture_output (argv, NULL, &output, &l_error);
-    if (!succ) {
-        /* if we got nothing on STDOUT, try using STDERR data from error message */
-        if (g_error_matches (l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_NOOUT)) {
-            output = g_strdup (l_error->message);
-            g_clear_error (&l_error);
-        } else if (g_error_matches (l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED)) {
-            /* exit status != 0, try using the output anyway */
-            output = g_strdup (l_error->message);
-            g_clear_error (&l_error);
+    cache_entry = _version_cache_entry_path (util_path, argv[1]);
+    if (cache_entry) {
+        if (stat (util_path, &st) == 0)
+            output = _version_cache_lookup (cache_entry, util_path, argv[1], &st);
+        else
+            g_clear_pointer (&cache_entry, g_free);
+    }
+
+    if (!output) {
+        succ = bd_utils_exec_and_capture_output (argv, NULL, &output, &l_error);
+        if (!succ) {
+            /* if we got nothing on STDOUT, try using STDERR data from error message */
+            if (g_error_matches (l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_NOOUT)) {
+                output = g_strdup (l_error->message);
+                g_clear_error (&l_error);
+            } else if (g_error_matches (l_error, BD_UTILS_EXEC_ERROR, BD_UTILS_EXEC_ERROR_FAILED)) {
+                /* exit status != 0, try using the output anyway */
+                output = g_strdup (l_error->message);
+                g_clear_error (&l_error);
+            }
         }
+
+        /* the stat() results are from before the utility was run so if it has been
+           replaced in the meantime, the entry won't match the new binary, error
+           messages are not cached as they may be caused by a transient failure */
+        if (cache_entry && succ && output)
+            _version_cache_store (cache_entry, util_path, argv[1], &st, output);
     }
+    g_free (cache_entry);
+    g_free (util_path);
 
     if (version_regexp) {
         regex = g_regex_new (version_regexp, 0, 0, error);
@@ -865,6 +2231,21 @@ gboolean bd_utils_init_prog_reporting_thread (BDUtilsProgFunc new_prog_func, GEr
     return TRUE;
 }
 
+/**
+ * bd_utils_get_prog_reporting_thread: (skip)
+ *
+ * Returns: progress reporting function set for the current thread with
+ *          bd_utils_init_prog_reporting_thread() (or
+ *          bd_utils_mute_prog_reporting_thread()) or %NULL if none is set
+ *
+ * Note: The returned function can be passed to
+ *       bd_utils_init_prog_reporting_thread() in a different thread to make it
+ *       report progress the same way as the current thread.
+ */
+BDUtilsProgFunc bd_utils_get_prog_reporting_thread (void) {
+    return thread_prog_func;
+}
+
 static void thread_progress_muted (guint64 task_id G_GNUC_UNUSED, BDUtilsProgStatus status G_GNUC_UNUSED,
                                    guint8 completion G_GNUC_UNUSED, gchar *msg G_GNUC_UNUSED) {
     /* This function serves as a special value for the progress reporting
@@ -1,4 +1,5 @@
 #include <glib.h>
+#include <gio/gio.h>
 #include "extra_arg.h"
 
 #ifndef BD_UTILS_EXEC
@@ -48,6 +49,48 @@ typedef void (*BDUtilsProgFunc) (guint64 task_id, BDUtilsProgStatus status, guin
  */
 typedef gboolean (*BDUtilsProgExtract) (const gchar *line, guint8 *completion);
 
+/**
+ * BDUtilsLineFunc:
+ * @line: line from the standard output of the spawned command (usually with the
+ *        trailing newline character which may be absent for the last line)
+ * @user_data: (closure): arbitrary data passed to the exec function
+ *
+ * Callback function used to process the standard output of a spawned command
+ * line by line while the command is still running.
+ */
+typedef void (*BDUtilsLineFunc) (const gchar *line, gpointer user_data);
+
+#define BD_UTILS_TYPE_EXEC_STATS (bd_utils_exec_stats_get_type ())
+GType bd_utils_exec_stats_get_type (void);
+
+/* number of buckets in the run time histogram of #BDUtilsExecStats */
+#define BD_UTILS_EXEC_STATS_BUCKETS 20
+
+/**
+ * BDUtilsExecStats:
+ * @util: name of the utility the statistics are for
+ * @runs: number of runs of the utility
+ * @failures: number of runs that failed (non-zero exit code, timeout, signal,...)
+ * @total_time: total run time of all the runs (in microseconds)
+ * @max_time: run time of the longest run (in microseconds)
+ * @output_size: total size of the output (both standard and error) of all the runs
+ * @histogram: run time histogram, bucket 0 counts runs shorter than 1 ms, bucket
+ *             N counts runs taking from 2^(N-1) ms to 2^N ms (the last bucket
+ *             counts all the longer runs too)
+ */
+typedef struct BDUtilsExecStats {
+    gchar *util;
+    guint64 runs;
+    guint64 failures;
+    guint64 total_time;
+    guint64 max_time;
+    guint64 output_size;
+    guint64 histogram[BD_UTILS_EXEC_STATS_BUCKETS];
+} BDUtilsExecStats;
+
+BDUtilsExecStats* bd_utils_exec_stats_copy (BDUtilsExecStats *stats);
+void bd_utils_exec_stats_free (BDUtilsExecStats *stats);
+
 GQuark bd_utils_exec_error_quark (void);
 #define BD_UTILS_EXEC_ERROR bd_utils_exec_error_quark ()
 typedef enum {
@@ -60,6 +103,7 @@ typedef enum {
     BD_UTILS_EXEC_ERROR_UTIL_CHECK_ERROR,
     BD_UTILS_EXEC_ERROR_UTIL_FEATURE_CHECK_ERROR,
     BD_UTILS_EXEC_ERROR_UTIL_FEATURE_UNAVAILABLE,
+    BD_UTILS_EXEC_ERROR_TIMEOUT,
 } BDUtilsExecError;
 
 gboolean bd_utils_exec_and_report_error (const gchar **argv, const BDExtraArg **extra, GError **error);
@@ -68,12 +112,29 @@ gboolean bd_utils_exec_and_report_status_error (const gchar **argv, const BDExtr
 gboolean bd_utils_exec_and_capture_output (const gchar **argv, const BDExtraArg **extra, gchar **output, GError **error);
 gboolean bd_utils_exec_and_capture_output_no_progress (const gchar **argv, const BDExtraArg **extra, gchar **output, gchar **stderr, gint *status, GError **error);
 gboolean bd_utils_exec_and_report_progress (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, gint *proc_status, GError **error);
+gboolean bd_utils_exec_and_stream_output (const gchar **argv, const BDExtraArg **extra, BDUtilsLineFunc line_func, gpointer line_data, GError **error);
 gboolean bd_utils_exec_with_input (const gchar **argv, const gchar *input, const BDExtraArg **extra, GError **error);
+gboolean bd_utils_spawn_with_fds (const gchar **argv, const gchar **env_vars, const gint *fds, guint n_fds, gboolean new_pgroup, GPid *pid, guint64 *task_id, gint64 *start_time, GError **error);
+guint64 bd_utils_exec_log_running (const gchar **argv, gint64 *start_time);
+void bd_utils_exec_log_done (guint64 task_id, const gchar *util, gint64 start_time, gint exit_code, gsize output_size);
+void bd_utils_exec_and_report_error_async (const gchar **argv, const BDExtraArg **extra, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data);
+gboolean bd_utils_exec_and_report_error_finish (GAsyncResult *result, GError **error);
+void bd_utils_exec_and_report_progress_async (const gchar **argv, const BDExtraArg **extra, BDUtilsProgExtract prog_extract, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data);
+gboolean bd_utils_exec_and_report_progress_finish (GAsyncResult *result, gint *proc_status, GError **error);
+void bd_utils_exec_and_capture_output_async (const gchar **argv, const BDExtraArg **extra, GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data);
+gboolean bd_utils_exec_and_capture_output_finish (GAsyncResult *result, gchar **output, GError **error);
+void bd_utils_set_exec_timeout_thread (guint64 timeout);
+guint64 bd_utils_get_exec_timeout_thread (void);
 gint bd_utils_version_cmp (const gchar *ver_string1, const gchar *ver_string2, GError **error);
+gboolean bd_utils_set_version_cache_dir (const gchar *cache_dir, GError **error);
+gchar* bd_utils_get_version_cache_dir (void);
+BDUtilsExecStats** bd_utils_get_exec_stats (void);
+void bd_utils_reset_exec_stats (void);
 gboolean bd_utils_check_util_version (const gchar *util, const gchar *version, const gchar *version_arg, const gchar *version_regexp, GError **error);
 
 gboolean bd_utils_init_prog_reporting (BDUtilsProgFunc new_prog_func, GError **error);
 gboolean bd_utils_init_prog_reporting_thread (BDUtilsProgFunc new_prog_func, GError **error);
+BDUtilsProgFunc bd_utils_get_prog_reporting_thread (void);
 gboolean bd_utils_mute_prog_reporting_thread (GError **error);
 gboolean bd_utils_prog_reporting_initialized (void);
 guint64 bd_utils_report_started (const gchar *msg);
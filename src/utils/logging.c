@@ -18,6 +18,7 @@
  */
 
 #include <glib.h>
+#include <glib-object.h>
 #include <glib/gprintf.h>
 #include <stdarg.h>
 
@@ -140,3 +141,243 @@ void bd_utils_log_stdout (gint level, const gchar *msg) {
             break;
     }
 }
+
+/* Tracing is done into per-thread ring buffers with a single producer (the
+ * thread itself) and a single consumer (bd_utils_trace_dump() holding the
+ * trace_rings_lock) so recording an event needs no locking, no allocation
+ * (except for the first event in a thread) and no formatting. Strings are
+ * copied (and truncated) into fixed-size fields of the entries. */
+typedef struct TraceEntry {
+    guint64 task_id;
+    gint64 start_time;
+    gint64 end_time;
+    gint exit_code;
+    gchar plugin[16];
+    gchar function[48];
+} TraceEntry;
+
+typedef struct TraceRing {
+    guint thread;
+    gint head;          /* only written by the producer */
+    gint tail;          /* only written by the consumer */
+    gint dropped;
+    gint orphaned;      /* the producer thread has finished */
+    TraceEntry entries[BD_UTILS_TRACE_RING_SIZE];
+} TraceRing;
+
+static void _trace_ring_orphan (gpointer ring);
+
+static gint trace_enabled = 0;
+static GPrivate trace_ring_key = G_PRIVATE_INIT (_trace_ring_orphan);
+static GMutex trace_rings_lock;
+static GSList *trace_rings = NULL;
+static guint trace_threads = 0;
+
+/**
+ * _trace_ring_orphan: (skip)
+ *
+ * Called when a thread with a trace ring finishes, the events are kept until
+ * they are dumped.
+ */
+static void _trace_ring_orphan (gpointer ring) {
+    g_atomic_int_set (&(((TraceRing *) ring)->orphaned), 1);
+}
+
+/**
+ * bd_utils_trace_event_copy: (skip)
+ * @event: (nullable): %BDUtilsTraceEvent to copy
+ *
+ * Creates a new copy of @event.
+ */
+BDUtilsTraceEvent* bd_utils_trace_event_copy (BDUtilsTraceEvent *event) {
+    BDUtilsTraceEvent *ret = NULL;
+
+    if (event == NULL)
+        return NULL;
+
+    ret = g_new0 (BDUtilsTraceEvent, 1);
+    *ret = *event;
+    ret->plugin = g_strdup (event->plugin);
+    ret->function = g_strdup (event->function);
+
+    return ret;
+}
+
+/**
+ * bd_utils_trace_event_free: (skip)
+ * @event: (nullable): %BDUtilsTraceEvent to free
+ *
+ * Frees @event.
+ */
+void bd_utils_trace_event_free (BDUtilsTraceEvent *event) {
+    if (event == NULL)
+        return;
+
+    g_free (event->plugin);
+    g_free (event->function);
+    g_free (event);
+}
+
+GType bd_utils_trace_event_get_type (void) {
+    static GType type = 0;
+
+    if (G_UNLIKELY (!type))
+        type = g_boxed_type_register_static ("BDUtilsTraceEvent",
+                                             (GBoxedCopyFunc) bd_utils_trace_event_copy,
+                                             (GBoxedFreeFunc) bd_utils_trace_event_free);
+
+    return type;
+}
+
+/**
+ * bd_utils_set_tracing:
+ * @enabled: whether to enable or disable tracing
+ *
+ * Enables or disables recording of trace events (see bd_utils_trace_record()).
+ * With tracing enabled, an event is recorded for every executed utility and
+ * for every plugin function called through the library.
+ * Events are recorded into per-thread ring buffers holding up to
+ * %BD_UTILS_TRACE_RING_SIZE events each, events recorded into a full buffer
+ * are dropped. Use bd_utils_trace_dump() to get (and remove) the recorded
+ * events. Disabling tracing keeps the already recorded events.
+ */
+void bd_utils_set_tracing (gboolean enabled) {
+    g_atomic_int_set (&trace_enabled, enabled ? 1 : 0);
+}
+
+/**
+ * bd_utils_get_tracing:
+ *
+ * Returns: whether tracing is enabled or not, see bd_utils_set_tracing()
+ */
+gboolean bd_utils_get_tracing (void) {
+    return g_atomic_int_get (&trace_enabled) != 0;
+}
+
+/**
+ * bd_utils_trace_record:
+ * @task_id: ID of the task the event is for
+ * @plugin: name of the plugin the event is for
+ * @function: name of the function the event is for
+ * @start_time: monotonic time the operation started (see g_get_monotonic_time())
+ * @end_time: monotonic time the operation finished (see g_get_monotonic_time())
+ * @exit_code: exit code of the operation (-1 if it failed without an exit code)
+ *
+ * Records a trace event if tracing is enabled (see bd_utils_set_tracing()),
+ * does nothing otherwise. Unlike the logging functions, this function never
+ * blocks nor formats anything. @plugin and @function are truncated to 15
+ * and 47 characters respectively.
+ */
+void bd_utils_trace_record (guint64 task_id, const gchar *plugin, const gchar *function, gint64 start_time, gint64 end_time, gint exit_code) {
+    TraceRing *ring = NULL;
+    TraceEntry *entry = NULL;
+    guint head = 0;
+
+    if (G_LIKELY (!g_atomic_int_get (&trace_enabled)))
+        return;
+
+    ring = g_private_get (&trace_ring_key);
+    if (G_UNLIKELY (!ring)) {
+        ring = g_new0 (TraceRing, 1);
+        g_mutex_lock (&trace_rings_lock);
+        ring->thread = trace_threads++;
+        trace_rings = g_slist_prepend (trace_rings, ring);
+        g_mutex_unlock (&trace_rings_lock);
+        g_private_set (&trace_ring_key, ring);
+    }
+
+    head = (guint) ring->head;
+    if (head - (guint) g_atomic_int_get (&(ring->tail)) >= BD_UTILS_TRACE_RING_SIZE) {
+        g_atomic_int_inc (&(ring->dropped));
+        return;
+    }
+
+    entry = &(ring->entries[head % BD_UTILS_TRACE_RING_SIZE]);
+    entry->task_id = task_id;
+    entry->start_time = start_time;
+    entry->end_time = end_time;
+    entry->exit_code = exit_code;
+    g_strlcpy (entry->plugin, plugin ? plugin : "", sizeof (entry->plugin));
+    g_strlcpy (entry->function, function ? function : "", sizeof (entry->function));
+
+    /* publish the entry */
+    g_atomic_int_set (&(ring->head), (gint) (head + 1));
+}
+
+static gint _trace_event_cmp (gconstpointer a, gconstpointer b) {
+    const BDUtilsTraceEvent *event1 = *((const BDUtilsTraceEvent **) a);
+    const BDUtilsTraceEvent *event2 = *((const BDUtilsTraceEvent **) b);
+
+    if (event1->start_time != event2->start_time)
+        return event1->start_time < event2->start_time ? -1 : 1;
+    return 0;
+}
+
+/**
+ * bd_utils_trace_dump:
+ * @dropped: (out) (optional): place to store the number of events dropped
+ *                             because of full buffers since the last dump
+ *
+ * Gets and removes all the trace events recorded so far by all threads.
+ *
+ * Returns: (transfer full) (array zero-terminated=1): the recorded trace events
+ *          ordered by their start time
+ */
+BDUtilsTraceEvent** bd_utils_trace_dump (guint64 *dropped) {
+    GPtrArray *events = NULL;
+    BDUtilsTraceEvent *event = NULL;
+    TraceRing *ring = NULL;
+    TraceEntry *entry = NULL;
+    GSList *it = NULL;
+    GSList *next = NULL;
+    guint64 n_dropped = 0;
+    gint ring_dropped = 0;
+    guint head = 0;
+    guint tail = 0;
+    gboolean orphaned = FALSE;
+
+    events = g_ptr_array_new ();
+
+    g_mutex_lock (&trace_rings_lock);
+    for (it = trace_rings; it; it = next) {
+        next = it->next;
+        ring = (TraceRing *) it->data;
+
+        /* check before reading head so that no event can be missed */
+        orphaned = g_atomic_int_get (&(ring->orphaned)) != 0;
+
+        tail = (guint) ring->tail;
+        head = (guint) g_atomic_int_get (&(ring->head));
+        for (; tail != head; tail++) {
+            entry = &(ring->entries[tail % BD_UTILS_TRACE_RING_SIZE]);
+            event = g_new0 (BDUtilsTraceEvent, 1);
+            event->task_id = entry->task_id;
+            event->thread = ring->thread;
+            event->plugin = g_strdup (entry->plugin);
+            event->function = g_strdup (entry->function);
+            event->start_time = entry->start_time;
+            event->end_time = entry->end_time;
+            event->exit_code = entry->exit_code;
+            g_ptr_array_add (events, event);
+        }
+        g_atomic_int_set (&(ring->tail), (gint) tail);
+
+        ring_dropped = g_atomic_int_get (&(ring->dropped));
+        g_atomic_int_add (&(ring->dropped), -ring_dropped);
+        n_dropped += ring_dropped;
+
+        if (orphaned) {
+            trace_rings = g_slist_delete_link (trace_rings, it);
+            g_free (ring);
+        }
+    }
+    g_mutex_unlock (&trace_rings_lock);
+
+    g_ptr_array_sort (events, _trace_event_cmp);
+    g_ptr_array_add (events, NULL);
+
+    if (dropped)
+        *dropped = n_dropped;
+
+    return (BDUtilsTraceEvent **) g_ptr_array_free (events, FALSE);
+}
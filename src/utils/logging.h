@@ -1,4 +1,5 @@
 #include <glib.h>
+#include <glib-object.h>
 #include <syslog.h>
 
 #ifndef BD_UTILS_LOGGING
@@ -35,4 +36,39 @@ void bd_utils_log (gint level, const gchar *msg);
 void bd_utils_log_format (gint level, const gchar *format, ...) G_GNUC_PRINTF (2, 3);
 void bd_utils_log_stdout (gint level, const gchar *msg);
 
+#define BD_UTILS_TYPE_TRACE_EVENT (bd_utils_trace_event_get_type ())
+GType bd_utils_trace_event_get_type (void);
+
+/* number of events buffered per thread before new events are dropped */
+#define BD_UTILS_TRACE_RING_SIZE 1024
+
+/**
+ * BDUtilsTraceEvent:
+ * @task_id: ID of the task the event is for (see bd_utils_get_next_task_id())
+ * @thread: sequential number of the thread the event was recorded in
+ * @plugin: name of the plugin the event is for ("utils" for executed utilities)
+ * @function: name of the plugin function (or the executed utility) the event is for
+ * @start_time: monotonic time the operation started (in microseconds)
+ * @end_time: monotonic time the operation finished (in microseconds)
+ * @exit_code: exit code of the operation (-1 if it failed without an exit code,
+ *             plugin functions record 0 on success and -1 on failure)
+ */
+typedef struct BDUtilsTraceEvent {
+    guint64 task_id;
+    guint thread;
+    gchar *plugin;
+    gchar *function;
+    gint64 start_time;
+    gint64 end_time;
+    gint exit_code;
+} BDUtilsTraceEvent;
+
+BDUtilsTraceEvent* bd_utils_trace_event_copy (BDUtilsTraceEvent *event);
+void bd_utils_trace_event_free (BDUtilsTraceEvent *event);
+
+void bd_utils_set_tracing (gboolean enabled);
+gboolean bd_utils_get_tracing (void);
+void bd_utils_trace_record (guint64 task_id, const gchar *plugin, const gchar *function, gint64 start_time, gint64 end_time, gint exit_code);
+BDUtilsTraceEvent** bd_utils_trace_dump (guint64 *dropped);
+
 #endif  /* BD_UTILS_LOGGING */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Red Hat, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BD_UTILS_PROBES
+#define BD_UTILS_PROBES
+
+/* Static (USDT) probes in the "libblockdev" provider, compiled out if
+ * sys/sdt.h is not available. Calls into the libraries are wrapped with
+ * BD_PROBE_CALL() which fires the "<name>_entry" probe with the name of the
+ * calling function and the "<name>_return" probe with the name of the calling
+ * function and the return value of the call, e.g.
+ *
+ *   bpftrace -e 'usdt:/usr/lib64/libbd_dm.so.3:libblockdev:dm_task_run_entry { ... }'
+ *
+ * BD_PROBE3() and BD_PROBE4() fire the <name> probe with the given arguments
+ * (used by the exec functions).
+ *
+ * Private header shared by the utils library and the plugins, not installed.
+ */
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+
+#define BD_PROBE3(name, a1, a2, a3) DTRACE_PROBE3 (libblockdev, name, a1, a2, a3)
+#define BD_PROBE4(name, a1, a2, a3, a4) DTRACE_PROBE4 (libblockdev, name, a1, a2, a3, a4)
+
+#define BD_PROBE_CALL(name, call) ({                                    \
+            __typeof__ (call) _bd_probe_ret;                            \
+            DTRACE_PROBE1 (libblockdev, name##_entry, __func__);        \
+            _bd_probe_ret = (call);                                     \
+            DTRACE_PROBE2 (libblockdev, name##_return, __func__, _bd_probe_ret); \
+            _bd_probe_ret;                                              \
+        })
+#else
+#define BD_PROBE3(name, a1, a2, a3) do {} while (0)
+#define BD_PROBE4(name, a1, a2, a3, a4) do {} while (0)
+#define BD_PROBE_CALL(name, call) (call)
+#endif
+
+#endif  /* BD_UTILS_PROBES */
@@ -703,6 +703,7 @@ class LvmTestVGs(LvmPVVGTestCase):
         self.assertEqual(info.free_count, info.extent_count)
         self.assertEqual(info.size, info.extent_count * info.extent_size)
         self.assertFalse(info.exported)
+        self.assertGreater(info.seqno, 0)
 
         # check PV info when PV is part of a VG
         pv_info = BlockDev.lvm_pvinfo(self.loop_dev)
@@ -983,6 +984,53 @@ class LvmTestLVs(LvmPVVGLVTestCase):
         with self.assertRaises(GLib.GError):
             BlockDev.lvm_lvremove("testVG", "testLV", True, None)
 
+    def test_lvcreate_lvremove_many(self):
+        """Verify that it's possible to create/destroy multiple LVs in one call"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev, self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_thpoolcreate("testVG", "testPool", 256 * 1024**2, 4 * 1024**2, 512 * 1024, None, None)
+        self.assertTrue(succ)
+
+        specs = [BlockDev.LVMLVSpec("testLV1", 100 * 1024**2),
+                 BlockDev.LVMLVSpec("testLV2", 100 * 1024**2, None, [self.loop_dev2]),
+                 # not enough space
+                 BlockDev.LVMLVSpec("testLV3", 2048 * 1024**2),
+                 BlockDev.LVMLVSpec("testThLV", 1024**3, pool_name="testPool"),
+                 # already exists
+                 BlockDev.LVMLVSpec("testLV1", 100 * 1024**2)]
+        results = BlockDev.lvm_lvcreate_many("testVG", specs)
+        self.assertEqual([r.lv_name for r in results], ["testLV1", "testLV2", "testLV3", "testThLV", "testLV1"])
+        self.assertEqual([r.success for r in results], [True, True, False, True, False])
+        self.assertIsNone(results[0].error_message)
+        self.assertIsNotNone(results[2].error_message)
+        self.assertIsNotNone(results[4].error_message)
+
+        info = BlockDev.lvm_lvinfo("testVG", "testLV2")
+        self.assertEqual(info.size, 100 * 1024**2)
+        info = BlockDev.lvm_lvinfo("testVG", "testThLV")
+        self.assertEqual(info.segtype, "thin")
+        self.assertEqual(info.pool_lv, "testPool")
+
+        results = BlockDev.lvm_lvremove_many("testVG", ["testLV1", "nonexistingLV", "testThLV", "testLV2"], True)
+        self.assertEqual([r.lv_name for r in results], ["testLV1", "nonexistingLV", "testThLV", "testLV2"])
+        self.assertEqual([r.success for r in results], [True, False, True, True])
+        self.assertIsNotNone(results[1].error_message)
+
+        lvs = BlockDev.lvm_lvs("testVG")
+        self.assertEqual([lv.lv_name for lv in lvs if not lv.lv_name.startswith("[")], ["testPool"])
+
+        # nothing to do
+        self.assertEqual(BlockDev.lvm_lvcreate_many("testVG", []), [])
+        self.assertEqual(BlockDev.lvm_lvremove_many("testVG", []), [])
+
     def test_lvactivate_lvdeactivate(self):
         """Verify it's possible to (de)actiavate an LV"""
 
@@ -1080,6 +1128,66 @@ class LvmTestLVs(LvmPVVGLVTestCase):
         succ = BlockDev.lvm_lvresize("testVG", "testLV", 400 * 1024**2, None)
         self.assertTrue(succ)
 
+    def test_watcher(self):
+        """Verify that LVM changes are reported by the LVM watcher"""
+
+        watcher = BlockDev.lvm_watcher_new()
+        self.assertIsNotNone(watcher)
+        self.assertGreaterEqual(BlockDev.lvm_watcher_get_fd(watcher), 0)
+
+        def wait_for_events(expected):
+            # udev events are processed asynchronously, wait for all the expected ones
+            seen = set()
+            deadline = time.time() + 10
+            while time.time() < deadline and not expected.issubset(seen):
+                for event in BlockDev.lvm_watcher_process(watcher, 1000):
+                    if event.vg_name == "testVG":
+                        seen.add((event.type, event.lv_name))
+            self.assertTrue(expected.issubset(seen), "%s not in %s" % (expected, seen))
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev, self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.VG_ADDED, None)})
+        self.assertIn("testVG", [vg.name for vg in BlockDev.lvm_watcher_get_vgs(watcher)])
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 512 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.LV_ADDED, "testLV"),
+                         (BlockDev.LVMEventType.LV_ACTIVATED, "testLV"),
+                         (BlockDev.LVMEventType.VG_CHANGED, None)})
+        lvs = BlockDev.lvm_watcher_get_lvs(watcher, "testVG")
+        self.assertEqual([lv.lv_name for lv in lvs], ["testLV"])
+        self.assertEqual(lvs[0].size, 512 * 1024**2)
+
+        succ = BlockDev.lvm_lvresize("testVG", "testLV", 768 * 1024**2, None)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.LV_RESIZED, "testLV")})
+        self.assertEqual(BlockDev.lvm_watcher_get_lvs(watcher, "testVG")[0].size, 768 * 1024**2)
+
+        succ = BlockDev.lvm_lvdeactivate("testVG", "testLV", None)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.LV_DEACTIVATED, "testLV")})
+
+        succ = BlockDev.lvm_lvactivate("testVG", "testLV", True)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.LV_ACTIVATED, "testLV")})
+
+        succ = BlockDev.lvm_lvremove("testVG", "testLV", True, None)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.LV_REMOVED, "testLV")})
+        self.assertEqual(BlockDev.lvm_watcher_get_lvs(watcher, "testVG"), [])
+
+        succ = BlockDev.lvm_vgremove("testVG", None)
+        self.assertTrue(succ)
+        wait_for_events({(BlockDev.LVMEventType.VG_REMOVED, None)})
+        self.assertNotIn("testVG", [vg.name for vg in BlockDev.lvm_watcher_get_vgs(watcher)])
+
     def test_lvrename(self):
         """Verify that it's possible to rename an LV"""
 
@@ -1277,6 +1385,95 @@ class LvmTestLVs(LvmPVVGLVTestCase):
             self.assertEqual(lv.segs[0].pvdev, self.loop_dev)
             self.assertGreater(lv.segs[0].size_pe, 0)
 
+    def test_full_report(self):
+        """Verify that it's possible to gather info about PVs, VGs and LVs at once"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 12 * 1024**2)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV2", 12 * 1024**2)
+        self.assertTrue(succ)
+        self.addCleanup(self._lvremove, "testVG", "testLV2")
+
+        report = BlockDev.lvm_full_report()
+
+        # should be the same as from the separate calls
+        self.assertCountEqual([pv.pv_uuid for pv in report.pvs], [pv.pv_uuid for pv in BlockDev.lvm_pvs()])
+        self.assertCountEqual([vg.uuid for vg in report.vgs], [vg.uuid for vg in BlockDev.lvm_vgs()])
+        self.assertCountEqual([lv.uuid for lv in report.lvs], [lv.uuid for lv in BlockDev.lvm_lvs_tree(None)])
+
+        vg = next(vg for vg in report.vgs if vg.name == "testVG")
+        self.assertEqual(vg.pv_count, 1)
+
+        pvs = {pv.pv_name: pv for pv in report.pvs}
+        self.assertEqual(pvs[self.loop_dev].vg_name, "testVG")
+        self.assertEqual(pvs[self.loop_dev].vg_uuid, vg.uuid)
+        self.assertFalse(pvs[self.loop_dev2].vg_name)
+
+        lvs = [lv for lv in report.lvs if lv.vg_name == "testVG"]
+        self.assertCountEqual([lv.lv_name for lv in lvs], ["testLV", "testLV2"])
+        for lv in lvs:
+            self.assertEqual(lv.segtype, "linear")
+            self.assertEqual(lv.size, 12 * 1024**2)
+            self.assertEqual(len(lv.segs), 1)
+            self.assertEqual(lv.segs[0].pvdev, self.loop_dev)
+            self.assertGreater(lv.segs[0].size_pe, 0)
+
+    def test_state_snapshot(self):
+        """Verify that looking up PVs, VGs and LVs in a state snapshot works as expected"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "test-LV", 12 * 1024**2)
+        self.assertTrue(succ)
+        self.addCleanup(self._lvremove, "testVG", "test-LV")
+
+        snapshot = BlockDev.lvm_state_snapshot_new()
+        self.assertCountEqual([lv.uuid for lv in snapshot.lvs], [lv.uuid for lv in BlockDev.lvm_lvs_tree(None)])
+
+        pv = BlockDev.lvm_state_snapshot_get_pv(snapshot, self.loop_dev)
+        self.assertEqual(pv.vg_name, "testVG")
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_pv(snapshot, pv.pv_uuid).pv_name, self.loop_dev)
+        self.assertFalse(BlockDev.lvm_state_snapshot_get_pv(snapshot, self.loop_dev2).vg_name)
+
+        vg = BlockDev.lvm_state_snapshot_get_vg(snapshot, "testVG")
+        self.assertEqual(vg.uuid, pv.vg_uuid)
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_vg(snapshot, vg.uuid).name, "testVG")
+
+        lv = BlockDev.lvm_state_snapshot_get_lv(snapshot, "testVG", "test-LV")
+        self.assertEqual(lv.size, 12 * 1024**2)
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_lv(snapshot, None, lv.uuid).lv_name, "test-LV")
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_lv(snapshot, None, "/dev/testVG/test-LV").uuid, lv.uuid)
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_lv(snapshot, None, "/dev/mapper/testVG-test--LV").uuid, lv.uuid)
+
+        self.assertEqual([lv.lv_name for lv in BlockDev.lvm_state_snapshot_get_pv_lvs(snapshot, self.loop_dev)], ["test-LV"])
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_pv_lvs(snapshot, self.loop_dev2), [])
+
+        with self.assertRaisesRegex(GLib.GError, "not found"):
+            BlockDev.lvm_state_snapshot_get_lv(snapshot, "otherVG", "test-LV")
+
+        with self.assertRaisesRegex(GLib.GError, "not found"):
+            BlockDev.lvm_state_snapshot_get_vg(snapshot, "otherVG")
+
+        with self.assertRaisesRegex(GLib.GError, "not found"):
+            BlockDev.lvm_state_snapshot_get_pv(snapshot, "/dev/nonexisting")
+
     @tag_test(TestTags.SLOW)
     def test_create_cached_lv(self):
         """Verify that it is possible to create a cached LV in a single step"""
@@ -1353,6 +1550,21 @@ class LvmTestLVs(LvmPVVGLVTestCase):
         self.assertIsNotNone(info)
         self.assertEqual(info.segtype, "writecache")
 
+        stats = BlockDev.lvm_writecache_stats("testVG", "testLV")
+        self.assertIsNotNone(stats)
+        self.assertEqual(stats.error, 0)
+        self.assertIn(stats.block_size, (512, 4096))
+        self.assertGreater(stats.total_blocks, 0)
+        self.assertEqual(stats.cache_size, stats.total_blocks * stats.block_size)
+        self.assertLessEqual(stats.cache_size, 256 * 1024**2)
+        self.assertLessEqual(stats.free_blocks, stats.total_blocks)
+        self.assertLessEqual(stats.writeback_blocks, stats.total_blocks)
+        self.assertEqual(stats.cache_used, (stats.total_blocks - stats.free_blocks) * stats.block_size)
+
+        # not a RAID LV
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_raid_stats("testVG", "testLV")
+
     @tag_test(TestTags.SLOW)
     def test_cache_get_stats(self):
         """Verify that it is possible to get stats for a cached LV"""
@@ -1503,6 +1715,20 @@ class LvmTestLVcreateType(LvmPVVGLVTestCase):
         info = BlockDev.lvm_lvinfo("testVG", "testLV")
         self.assertEqual(info.segtype, "raid1")
 
+        # the LV is fully synced now (see wait_for_sync above)
+        stats = BlockDev.lvm_raid_stats("testVG", "testLV")
+        self.assertEqual(stats.raid_type, "raid1")
+        self.assertEqual(stats.dev_count, 2)
+        self.assertEqual(stats.dev_health, "AA")
+        self.assertEqual(stats.insync_regions, stats.total_regions)
+        self.assertAlmostEqual(stats.sync_ratio, 1.0)
+        self.assertEqual(stats.sync_action, "idle")
+        self.assertEqual(stats.mismatch_count, 0)
+
+        # not a writecache LV
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_writecache_stats("testVG", "testLV")
+
         succ = BlockDev.lvm_lvremove("testVG", "testLV", True, None)
         self.assertTrue(succ)
 
@@ -1659,6 +1885,88 @@ class LvmTestPVmove(LvmPVVGLVTestCase):
         self.assertEqual(len(info.segs), 1)
         self.assertEqual(info.segs[0].pvdev, self.loop_dev2)
 
+    @tag_test(TestTags.CORE)
+    def test_pvmove_start(self):
+        """Verify that it's possible to move extents in the background"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev, self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 10 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        job = BlockDev.lvm_pvmove_start(self.loop_dev, self.loop_dev2, None)
+        self.assertIsNotNone(job)
+
+        progress = BlockDev.lvm_job_get_progress(job)
+        self.assertGreaterEqual(progress, 0)
+        self.assertLessEqual(progress, 100)
+
+        idx = BlockDev.lvm_job_wait_any([job], -1)
+        self.assertEqual(idx, 0)
+
+        # finished jobs are reported right away
+        idx = BlockDev.lvm_job_wait_any([job], 0)
+        self.assertEqual(idx, 0)
+
+        succ = BlockDev.lvm_job_wait(job, 0)
+        self.assertTrue(succ)
+        self.assertEqual(BlockDev.lvm_job_get_progress(job), 100)
+
+        # nothing to cancel anymore
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_job_cancel(job)
+
+        info = BlockDev.lvm_lvinfo_tree("testVG", "testLV")
+        self.assertIsNotNone(info)
+        self.assertEqual(len(info.segs), 1)
+        self.assertEqual(info.segs[0].pvdev, self.loop_dev2)
+
+        # failures are reported either when starting or when waiting for the job
+        with self.assertRaises(GLib.GError):
+            job = BlockDev.lvm_lvresize_start("testVG", "nonexistingLV", 20 * 1024**2, None)
+            BlockDev.lvm_job_wait(job, -1)
+
+        job = BlockDev.lvm_lvresize_start("testVG", "testLV", 16 * 1024**2, None)
+        self.assertIsNotNone(job)
+        succ = BlockDev.lvm_job_wait(job, -1)
+        self.assertTrue(succ)
+
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 16 * 1024**2)
+
+        # multiple jobs running at the same time
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV2", 4 * 1024**2, None, None, None)
+        self.assertTrue(succ)
+
+        jobs = [BlockDev.lvm_lvresize_start("testVG", "testLV", 20 * 1024**2, None),
+                BlockDev.lvm_lvresize_start("testVG", "testLV2", 8 * 1024**2, None)]
+        running = list(jobs)
+        while running:
+            idx = BlockDev.lvm_job_wait_any(running, -1)
+            self.assertGreaterEqual(idx, 0)
+            self.assertLess(idx, len(running))
+            succ = BlockDev.lvm_job_wait(running[idx], 0)
+            self.assertTrue(succ)
+            del running[idx]
+
+        for job in jobs:
+            self.assertEqual(BlockDev.lvm_job_get_progress(job), 100)
+
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 20 * 1024**2)
+        info = BlockDev.lvm_lvinfo("testVG", "testLV2")
+        self.assertEqual(info.size, 8 * 1024**2)
+
+        succ = BlockDev.lvm_lvremove("testVG", "testLV2", True, None)
+        self.assertTrue(succ)
+
 
 class LvmPVVGthpoolTestCase(LvmPVVGTestCase):
     def _clean_up(self):
@@ -1855,6 +2163,62 @@ class LvmTestThLV(LvmPVVGLVthLVTestCase):
         self.assertEqual(info.origin, "testThLV")
         self.assertEqual(info.pool_lv, "testPool")
 
+    def test_thpool_thlv_stats(self):
+        """Verify that it is possible to get stats of a thin pool and a thin LV"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev, self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_thpoolcreate("testVG", "testPool", 512 * 1024**2, 4 * 1024**2, 512 * 1024, None, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_thlvcreate("testVG", "testPool", "testThLV", 1024**3, None)
+        self.assertTrue(succ)
+
+        stats = BlockDev.lvm_thlv_stats("testVG", "testThLV")
+        self.assertEqual(stats.mapped_size, 0)
+        self.assertFalse(stats.failed)
+
+        # write 2 MiB of data at the beginning of the thin LV
+        with open("/dev/testVG/testThLV", "wb") as f:
+            f.write(b"\xff" * 2 * 1024**2)
+            f.flush()
+            os.fsync(f.fileno())
+
+        stats = BlockDev.lvm_thlv_stats("testVG", "testThLV")
+        self.assertEqual(stats.mapped_size, 2 * 1024**2)
+        self.assertEqual(stats.highest_mapped, 2 * 1024**2)
+        self.assertFalse(stats.failed)
+
+        stats = BlockDev.lvm_thpool_stats("testVG", "testPool")
+        self.assertEqual(stats.block_size, 512 * 1024)
+        self.assertEqual(stats.data_size, 512 * 1024**2)
+        self.assertEqual(stats.data_total_blocks, 1024)
+        self.assertEqual(stats.data_used_blocks, 4)
+        self.assertEqual(stats.data_used, 2 * 1024**2)
+        self.assertEqual(stats.md_block_size, 4096)
+        self.assertEqual(stats.md_size, stats.md_total_blocks * 4096)
+        self.assertGreater(stats.md_used_blocks, 0)
+        self.assertGreater(stats.transaction_id, 0)
+        self.assertFalse(stats.needs_check)
+        self.assertEqual(stats.mode, BlockDev.LVMThPoolMode.READ_WRITE)
+
+        # not a thin LV/pool
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_thlv_stats("testVG", "testPool")
+
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_thpool_stats("testVG", "testThLV")
+
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_thpool_stats("testVG", "nonexistingPool")
+
 
 
 class LvmPVVGLVcachePoolTestCase(LvmPVVGLVTestCase):
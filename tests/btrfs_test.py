@@ -636,3 +636,26 @@ class BTRFSSkipTest(BtrfsTest):
             avail = BlockDev.btrfs_is_tech_avail(BlockDev.BtrfsTech.FS, 0)
             self.assertTrue(avail)
 
+    @tag_test(TestTags.NOSTORAGE)
+    def test_dependencies_timeout(self):
+        """Verify that the parallel dependency checks use the caller's exec timeout"""
+
+        self.addCleanup(BlockDev.reinit, self.requested_plugins, True, None)
+        self.addCleanup(BlockDev.utils_set_exec_timeout_thread, 0)
+
+        with fake_utils("tests/fake_utils/btrfs_slow_version/"):
+            # reload the plugin to drop the results of the previous checks
+            self.assertTrue(BlockDev.reinit(self.requested_plugins, True, None))
+            BlockDev.utils_set_exec_timeout_thread(500)
+
+            # both btrfs versions are checked in parallel by other threads
+            start = time.time()
+            BlockDev.prewarm_deps()
+            self.assertLess(time.time() - start, 5)
+
+            # nothing was found out, the check runs (and times out) again
+            start = time.time()
+            with self.assertRaises(GLib.GError):
+                BlockDev.btrfs_is_tech_avail(BlockDev.BtrfsTech.FS, 0)
+            self.assertLess(time.time() - start, 5)
+
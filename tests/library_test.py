@@ -165,6 +165,60 @@ class LibraryOpsTestCase(unittest.TestCase):
         self.assertIn("bd_try_init() called more than once", self.log)
         self.log = ""
 
+    @tag_test(TestTags.CORE)
+    def test_lazy_loading(self):
+        """Verify that lazy loading of plugins works as expected"""
+
+        self.addCleanup(BlockDev.reinit, self.requested_plugins, True, None)
+        self.addCleanup(BlockDev.set_lazy_loading, False)
+        BlockDev.set_lazy_loading(True)
+        self.assertTrue(BlockDev.reinit(self.requested_plugins, True, None))
+
+        # plugins waiting to be loaded are reported as available
+        self.assertEqual(set(BlockDev.get_available_plugin_names()),
+                         set(["crypto", "dm", "loop", "mdraid", "part", "swap"]))
+
+        # the plugin is loaded on the first call of its function
+        self.assertTrue(BlockDev.md_canonicalize_uuid("3386ff85:f5012621:4a435f06:1eb47236"))
+        self.assertTrue(BlockDev.is_plugin_available(BlockDev.Plugin.MDRAID))
+
+        # or when its availability is queried
+        self.assertTrue(BlockDev.is_plugin_available(BlockDev.Plugin.SWAP))
+        self.assertEqual(set(BlockDev.get_available_plugin_names()),
+                         set(["crypto", "dm", "loop", "mdraid", "part", "swap"]))
+
+        # non-existing shared objects are not deferred, failure is reported right away
+        ps = BlockDev.PluginSpec(name=BlockDev.Plugin.SWAP, so_name="libbd_swap.so.1234567890")
+        self.assertFalse(BlockDev.reinit([ps], True, None))
+        with self.assertRaisesRegex(GLib.GError, r"The function 'bd_swap_swapstatus' called, but not implemented"):
+            BlockDev.swap_swapstatus("/dev/libblockdev-nonexistent")
+        self.assertFalse(BlockDev.is_plugin_available(BlockDev.Plugin.SWAP))
+        self.assertEqual(BlockDev.get_available_plugin_names(), [])
+
+    @tag_test(TestTags.CORE)
+    def test_prewarm_deps(self):
+        """Verify that pre-warming the dependency checks works as expected"""
+
+        def _swap_avail():
+            try:
+                return BlockDev.swap_is_tech_avail(BlockDev.SwapTech.SWAP, BlockDev.SwapTechMode.CREATE)
+            except GLib.GError:
+                return False
+
+        self.assertTrue(BlockDev.reinit(self.requested_plugins, True, None))
+        expected = _swap_avail()
+
+        # reload the plugins to drop the results of the previous checks
+        self.assertTrue(BlockDev.reinit(self.requested_plugins, True, None))
+        BlockDev.prewarm_deps()
+        self.assertEqual(_swap_avail(), expected)
+
+        # nothing to do with no plugins loaded
+        self.assertTrue(BlockDev.reinit([], True, None))
+        BlockDev.prewarm_deps()
+
+        self.assertTrue(BlockDev.reinit(self.requested_plugins, True, None))
+
     def test_non_en_init(self):
         """Verify that the library initializes with lang different from en_US"""
 
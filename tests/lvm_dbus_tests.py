@@ -1,3 +1,7 @@
+import os
+import subprocess
+import sys
+import time
 import unittest
 from itertools import chain
 
@@ -46,6 +50,17 @@ class LvmNoDevTestCase(_lvm_cases.LvmNoDevTestCase, LvmDBusTestCase):
     def test_plugin_version(self):
         self.assertEqual(BlockDev.get_plugin_soname(BlockDev.Plugin.LVM), "libbd_lvm-dbus.so.3")
 
+    @tag_test(TestTags.NOSTORAGE)
+    def test_shell_mode(self):
+        """Verify that the shell mode is not supported with lvmdbusd"""
+
+        self.assertFalse(BlockDev.lvm_get_shell_mode())
+
+        with self.assertRaisesRegex(GLib.GError, "not supported"):
+            BlockDev.lvm_set_shell_mode(True)
+
+        self.assertTrue(BlockDev.lvm_set_shell_mode(False))
+
     @tag_test(TestTags.NOSTORAGE)
     def test_empty_device(self):
         """Verify that passing an empty device string returns a proper error"""
@@ -94,6 +109,64 @@ class LvmNoDevTestCase(_lvm_cases.LvmNoDevTestCase, LvmDBusTestCase):
                 BlockDev.lvm_is_tech_avail(BlockDev.LVMTech.DEVICES, 0)
 
 
+JOB_CLIENT = """
+import time
+import overrides_hack
+import gi
+gi.require_version('BlockDev', '3.0')
+from gi.repository import BlockDev
+
+BlockDev.init([BlockDev.PluginSpec(name=BlockDev.Plugin.LVM, so_name="libbd_lvm-dbus.so.3")], None)
+start = time.monotonic()
+BlockDev.lvm_pvscan()
+print(time.monotonic() - start)
+"""
+
+
+@required_plugins(("lvm-dbus",))
+class LvmDBusMockJobTest(unittest.TestCase):
+    """Tests for waiting for lvmdbusd jobs using a mock lvmdbusd on a private bus"""
+
+    # how long the mock job runs
+    job_time = 0.2
+
+    def setUp(self):
+        self._dbus = subprocess.Popen(["dbus-daemon", "--session", "--nofork", "--print-address=1"],
+                                      stdout=subprocess.PIPE, universal_newlines=True)
+        self.addCleanup(self._dbus.terminate)
+        self.bus_address = self._dbus.stdout.readline().strip()
+
+        self.env = dict(os.environ, DBUS_SYSTEM_BUS_ADDRESS=self.bus_address)
+        self.tests_dir = os.path.dirname(os.path.abspath(__file__))
+        self._mock = subprocess.Popen([sys.executable, os.path.join(self.tests_dir, "lvmdbusd_mock.py"),
+                                       str(self.job_time)], env=self.env)
+        self.addCleanup(self._mock.terminate)
+
+        bus = dbus.bus.BusConnection(self.bus_address)
+        for _ in range(50):
+            if bus.name_has_owner("com.redhat.lvmdbus1"):
+                break
+            time.sleep(0.1)
+        else:
+            self.fail("Mock lvmdbusd failed to start")
+
+    @tag_test(TestTags.NOSTORAGE)
+    def test_job_wait_latency(self):
+        """Verify that job completion is noticed as soon as lvmdbusd announces it"""
+
+        # the client needs to run in a separate process, the GLib system bus
+        # singleton in this process is already connected to the real system bus
+        out = subprocess.check_output([sys.executable, "-c", JOB_CLIENT], env=self.env,
+                                      cwd=self.tests_dir, universal_newlines=True)
+        elapsed = float(out.strip().splitlines()[-1])
+
+        self.assertGreaterEqual(elapsed, self.job_time)
+        # waiting used to be done by polling every 500 ms, now we should only
+        # be delayed by the DBus round trips
+        latency = elapsed - self.job_time
+        self.assertLess(latency, 0.25, "Job completion noticed %.3f s after it finished" % latency)
+
+
 class LvmVDOTest(_lvm_cases.LvmVDOTest, LvmDBusTestCase):
     @classmethod
     def setUpClass(cls):
@@ -114,6 +187,35 @@ class LvmTestPVmove(_lvm_cases.LvmTestPVmove, LvmDBusTestCase):
         _lvm_cases.LvmTestPVmove.setUpClass()
         LvmDBusTestCase.setUpClass()
 
+    def test_job_cancel(self):
+        """Verify that cancelling lvmdbusd jobs is reported as not supported"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev, self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 10 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        job = BlockDev.lvm_pvmove_start(self.loop_dev, self.loop_dev2, None)
+        self.assertIsNotNone(job)
+
+        with self.assertRaisesRegex(GLib.GError, "not supported by lvmdbusd") as cm:
+            BlockDev.lvm_job_cancel(job)
+        self.assertTrue(cm.exception.matches(BlockDev.lvm_error_quark(), BlockDev.LVMError.NOT_SUPPORTED))
+
+        # the job is not affected
+        succ = BlockDev.lvm_job_wait(job, -1)
+        self.assertTrue(succ)
+
+        info = BlockDev.lvm_lvinfo_tree("testVG", "testLV")
+        self.assertEqual(info.segs[0].pvdev, self.loop_dev2)
+
 
 class LvmTestVGs(_lvm_cases.LvmTestVGs, LvmDBusTestCase):
     @classmethod
@@ -128,6 +230,154 @@ class LvmTestLVs(_lvm_cases.LvmTestLVs, LvmDBusTestCase):
         _lvm_cases.LvmTestLVs.setUpClass()
         LvmDBusTestCase.setUpClass()
 
+    def test_dbus_cache(self):
+        """Verify that queries are answered from the DBus object cache"""
+
+        self.assertFalse(BlockDev.lvm_get_dbus_cache())
+
+        succ = BlockDev.lvm_set_dbus_cache(True)
+        self.assertTrue(succ)
+        self.addCleanup(BlockDev.lvm_set_dbus_cache, False)
+        self.assertTrue(BlockDev.lvm_get_dbus_cache())
+
+        stats = BlockDev.lvm_get_dbus_cache_stats()
+        self.assertTrue(stats.enabled)
+        self.assertEqual(stats.refreshes, 1)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 128 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        # the new objects get into the cache either from the signals or by
+        # refilling it after a miss
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 128 * 1024**2)
+
+        stats = BlockDev.lvm_get_dbus_cache_stats()
+        self.assertGreater(stats.n_objects, 0)
+
+        # repeated queries are answered from the cache
+        for _ in range(10):
+            info = BlockDev.lvm_lvinfo("testVG", "testLV")
+            self.assertEqual(info.lv_name, "testLV")
+            vg_info = BlockDev.lvm_vginfo("testVG")
+            self.assertEqual(vg_info.name, "testVG")
+        new_stats = BlockDev.lvm_get_dbus_cache_stats()
+        self.assertGreaterEqual(new_stats.hits - stats.hits, 20)
+        self.assertEqual(new_stats.misses, stats.misses)
+        self.assertEqual(new_stats.stale, stats.stale)
+        self.assertEqual(new_stats.refreshes, stats.refreshes)
+
+        # changes are reflected in the cache
+        succ = BlockDev.lvm_lvresize("testVG", "testLV", 256 * 1024**2, None)
+        self.assertTrue(succ)
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 256 * 1024**2)
+
+        succ = BlockDev.lvm_lvremove("testVG", "testLV", True, None)
+        self.assertTrue(succ)
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_lvinfo("testVG", "testLV")
+
+        succ = BlockDev.lvm_set_dbus_cache(False)
+        self.assertTrue(succ)
+        self.assertFalse(BlockDev.lvm_get_dbus_cache_stats().enabled)
+
+    def test_lvs_match_lvinfo(self):
+        """Verify that listing LVs in bulk gives the same information as querying them one by one"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 128 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_thpoolcreate("testVG", "testPool", 256 * 1024**2, 4 * 1024**2, 512 * 1024, None, None)
+        self.assertTrue(succ)
+
+        lvs = BlockDev.lvm_lvs_tree("testVG")
+        self.assertTrue(any(lv.lv_name == "testLV" for lv in lvs))
+        self.assertTrue(any(lv.lv_name == "testPool" for lv in lvs))
+
+        for lv in lvs:
+            info = BlockDev.lvm_lvinfo_tree("testVG", lv.lv_name)
+            self.assertEqual(lv.vg_name, "testVG")
+            self.assertEqual(lv.uuid, info.uuid)
+            self.assertEqual(lv.size, info.size)
+            self.assertEqual(lv.segtype, info.segtype)
+            self.assertEqual(lv.data_lv, info.data_lv)
+            self.assertEqual(lv.metadata_lv, info.metadata_lv)
+            self.assertEqual(lv.data_lvs, info.data_lvs)
+            self.assertEqual(lv.metadata_lvs, info.metadata_lvs)
+            self.assertEqual(len(lv.segs or []), len(info.segs or []))
+
+        pool = next(lv for lv in lvs if lv.lv_name == "testPool")
+        self.assertEqual(pool.data_lv, "testPool_tdata")
+        self.assertEqual(pool.metadata_lv, "testPool_tmeta")
+
+    def test_lv_objects_match_per_call(self):
+        """Verify that getting the LV objects in parallel gives the same information as getting them one by one"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 128 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_thpoolcreate("testVG", "testPool", 256 * 1024**2, 4 * 1024**2, 512 * 1024, None, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_thlvcreate("testVG", "testPool", "testThLV", 512 * 1024**2, None)
+        self.assertTrue(succ)
+
+        def _infos():
+            ret = dict()
+            for lv_name in ("testLV", "testPool", "testThLV"):
+                ret[lv_name] = (BlockDev.lvm_lvinfo("testVG", lv_name),
+                                BlockDev.lvm_lvinfo_tree("testVG", lv_name))
+            return ret
+
+        # without the DBus object cache the LV objects are fetched in parallel rounds
+        self.assertFalse(BlockDev.lvm_get_dbus_cache())
+        parallel = _infos()
+
+        # with the cache every property is looked up one by one
+        succ = BlockDev.lvm_set_dbus_cache(True)
+        self.assertTrue(succ)
+        self.addCleanup(BlockDev.lvm_set_dbus_cache, False)
+        per_call = _infos()
+
+        for lv_name in parallel:
+            for info, ref in zip(parallel[lv_name], per_call[lv_name]):
+                self.assertEqual(info.lv_name, ref.lv_name)
+                self.assertEqual(info.uuid, ref.uuid)
+                self.assertEqual(info.size, ref.size)
+                self.assertEqual(info.attr, ref.attr)
+                self.assertEqual(info.segtype, ref.segtype)
+                self.assertEqual(info.origin, ref.origin)
+                self.assertEqual(info.pool_lv, ref.pool_lv)
+                self.assertEqual(info.data_lv, ref.data_lv)
+                self.assertEqual(info.metadata_lv, ref.metadata_lv)
+                self.assertEqual(info.data_lvs, ref.data_lvs)
+                self.assertEqual(info.metadata_lvs, ref.metadata_lvs)
+                self.assertEqual([(seg.pvdev, seg.pv_start_pe, seg.size_pe) for seg in info.segs or []],
+                                 [(seg.pvdev, seg.pv_start_pe, seg.size_pe) for seg in ref.segs or []])
+
+        self.assertEqual(parallel["testPool"][0].data_lv, "testPool_tdata")
+        self.assertEqual(parallel["testPool"][0].metadata_lv, "testPool_tmeta")
+        self.assertEqual(parallel["testThLV"][0].pool_lv, "testPool")
+
 
 class LvmDBusTestLVcreateType(_lvm_cases.LvmTestLVcreateType, LvmDBusTestCase):
     @classmethod
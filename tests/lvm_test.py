@@ -1,6 +1,9 @@
+import threading
+import time
+
 import _lvm_cases
 
-from utils import TestTags, tag_test, required_plugins, fake_path
+from utils import TestTags, tag_test, required_plugins, fake_path, fake_utils, run_command
 
 import gi
 gi.require_version('GLib', '2.0')
@@ -39,6 +42,79 @@ class LvmNoDevTestCase(_lvm_cases.LvmNoDevTestCase, LvmTestCase):
     def test_plugin_version(self):
         self.assertEqual(BlockDev.get_plugin_soname(BlockDev.Plugin.LVM), "libbd_lvm.so.3")
 
+    @tag_test(TestTags.NOSTORAGE, TestTags.SLOW)
+    def test_many_lvs(self):
+        """Verify that getting information about 10k LVs works as expected"""
+
+        # 10 VGs with LVs named lv0 - lv999 in each of them, two segments per LV
+        with fake_utils("tests/fake_utils/lvm_many_lvs/"):
+            lvs = BlockDev.lvm_lvs(None)
+            self.assertEqual(len(lvs), 10000)
+            self.assertEqual(len([lv for lv in lvs if lv.lv_name == "lv0"]), 10)
+
+            lvs = BlockDev.lvm_lvs_tree(None)
+            self.assertEqual(len(lvs), 10000)
+            self.assertTrue(all(len(lv.segs) == 2 for lv in lvs))
+
+            snapshot = BlockDev.lvm_state_snapshot_new()
+            self.assertEqual(len(snapshot.lvs), 10000)
+            self.assertEqual(len(snapshot.vgs), 10)
+            self.assertEqual(len(snapshot.pvs), 20)
+
+        for vg in range(10):
+            for lv in range(1000):
+                info = BlockDev.lvm_state_snapshot_get_lv(snapshot, "vg%d" % vg, "lv%d" % lv)
+                self.assertEqual(info.uuid, "lv-uuid-%d-%d" % (vg, lv))
+
+        self.assertEqual(len(BlockDev.lvm_state_snapshot_get_pv_lvs(snapshot, "/dev/fake0")), 1000)
+        self.assertEqual(BlockDev.lvm_state_snapshot_get_pv(snapshot, "/dev/fake19").vg_name, "vg9")
+
+    @tag_test(TestTags.NOSTORAGE)
+    def test_dbus_cache(self):
+        """Verify that the DBus object cache is not supported by the CLI plugin"""
+
+        self.assertFalse(BlockDev.lvm_get_dbus_cache())
+
+        with self.assertRaisesRegex(GLib.GError, "only supported by the LVM DBus plugin"):
+            BlockDev.lvm_set_dbus_cache(True)
+
+        self.assertTrue(BlockDev.lvm_set_dbus_cache(False))
+
+        stats = BlockDev.lvm_get_dbus_cache_stats()
+        self.assertFalse(stats.enabled)
+        self.assertEqual(stats.hits, 0)
+
+    @tag_test(TestTags.NOSTORAGE, TestTags.SLOW)
+    def test_parallel_queries(self):
+        """Verify that independent LVM queries run in parallel"""
+
+        n_threads = 8
+        results = []
+
+        def query():
+            pvs = BlockDev.lvm_pvs()
+            results.append(pvs[0].pv_name)
+
+        # make sure the global config is used (and copied) by all the queries
+        succ = BlockDev.lvm_set_global_config("backup {backup=0}")
+        self.assertTrue(succ)
+        self.addCleanup(BlockDev.lvm_set_global_config, None)
+
+        # every pvs call takes one second
+        with fake_utils("tests/fake_utils/lvm_slow_report/"):
+            start = time.monotonic()
+            threads = [threading.Thread(target=query) for _ in range(n_threads)]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            elapsed = time.monotonic() - start
+
+        self.assertEqual(results, ["/dev/fake0"] * n_threads)
+
+        # serialized queries would take (at least) n_threads seconds
+        self.assertLess(elapsed, n_threads / 2)
+
     def test_tech_available(self):
         """Verify that checking lvm tool availability by technology works as expected"""
 
@@ -89,6 +165,68 @@ class LvmTestPVmove(_lvm_cases.LvmTestPVmove, LvmTestCase):
         _lvm_cases.LvmTestPVmove.setUpClass()
         LvmTestCase.setUpClass()
 
+    def test_job_timeout_cancel(self):
+        """Verify that running lvm jobs can be waited for with a timeout and cancelled"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev, self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 10 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        job = BlockDev.lvm_pvmove_start(self.loop_dev, self.loop_dev2, None)
+        self.assertIsNotNone(job)
+
+        # the lvm process cannot even start in 1 ms, the timeout expires with
+        # the job still running which is not an error
+        start = time.monotonic()
+        succ = BlockDev.lvm_job_wait(job, 1)
+        self.assertFalse(succ)
+        self.assertLess(time.monotonic() - start, 1)
+        self.assertEqual(BlockDev.lvm_job_wait_any([job], 1), -1)
+
+        succ = BlockDev.lvm_job_wait(job, -1)
+        self.assertTrue(succ)
+
+        info = BlockDev.lvm_lvinfo_tree("testVG", "testLV")
+        self.assertEqual(info.segs[0].pvdev, self.loop_dev2)
+
+        # the process is still starting when it gets interrupted, but the
+        # operation may have already been done anyway
+        job = BlockDev.lvm_lvresize_start("testVG", "testLV", 16 * 1024**2, None)
+        succ = BlockDev.lvm_job_cancel(job)
+        self.assertTrue(succ)
+
+        try:
+            succ = BlockDev.lvm_job_wait(job, -1)
+        except GLib.GError:
+            succ = False
+
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 16 * 1024**2 if succ else 12 * 1024**2)
+
+        # nothing to cancel anymore
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_job_cancel(job)
+
+        # the exec timeout of the starting thread applies to the job
+        self.addCleanup(BlockDev.utils_set_exec_timeout_thread, 0)
+        with fake_utils("tests/fake_utils/lvm_slow_job/"):
+            BlockDev.utils_set_exec_timeout_thread(500)
+            job = BlockDev.lvm_lvresize_start("testVG", "testLV", 20 * 1024**2, None)
+            BlockDev.utils_set_exec_timeout_thread(0)
+
+            start = time.monotonic()
+            with self.assertRaisesRegex(GLib.GError, r"didn't finish within 500 ms"):
+                BlockDev.lvm_job_wait(job, -1)
+            self.assertLess(time.monotonic() - start, 5)
+
 
 class LvmTestVGs(_lvm_cases.LvmTestVGs, LvmTestCase):
     @classmethod
@@ -103,6 +241,163 @@ class LvmTestLVs(_lvm_cases.LvmTestLVs, LvmTestCase):
         _lvm_cases.LvmTestLVs.setUpClass()
         LvmTestCase.setUpClass()
 
+    def test_shell_mode(self):
+        """Verify that running LVM commands in the lvm shell works as expected"""
+
+        self.assertFalse(BlockDev.lvm_get_shell_mode())
+
+        succ = BlockDev.lvm_set_shell_mode(True)
+        self.assertTrue(succ)
+        self.addCleanup(BlockDev.lvm_set_shell_mode, False)
+        self.assertTrue(BlockDev.lvm_get_shell_mode())
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 12 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        # reports are read from the shell too
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 12 * 1024**2)
+        self.assertIn("testLV", [lv.lv_name for lv in BlockDev.lvm_lvs("testVG")])
+
+        # errors are reported the same way as without the shell
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_lvcreate("testVG", "testLV", 12 * 1024**2, None, [self.loop_dev], None)
+
+        with self.assertRaises(GLib.GError):
+            BlockDev.lvm_lvinfo("testVG", "nonexistingLV")
+
+        # the config string with quotes is passed to the shell as well
+        self.addCleanup(BlockDev.lvm_set_global_config, None)
+        succ = BlockDev.lvm_set_global_config("backup {backup=0 archive=0} report {time_format=\"%Y\"}")
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvresize("testVG", "testLV", 16 * 1024**2, None)
+        self.assertTrue(succ)
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(info.size, 16 * 1024**2)
+
+        succ = BlockDev.lvm_set_global_config(None)
+        self.assertTrue(succ)
+
+        # disabling stops the shell, commands run as separate processes again
+        succ = BlockDev.lvm_set_shell_mode(False)
+        self.assertTrue(succ)
+        self.assertFalse(BlockDev.lvm_get_shell_mode())
+
+        succ = BlockDev.lvm_lvremove("testVG", "testLV", True, None)
+        self.assertTrue(succ)
+
+    def test_watcher_refresh_failure(self):
+        """Verify that no changes are lost when the LVM watcher fails to refresh a VG"""
+
+        def _remove_vg2():
+            try:
+                BlockDev.lvm_vgremove("testVG2", None)
+            except GLib.GError:
+                pass
+
+        watcher = BlockDev.lvm_watcher_new()
+        self.assertIsNotNone(watcher)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev2, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG2", [self.loop_dev2], 0, None)
+        self.assertTrue(succ)
+        self.addCleanup(_remove_vg2)
+
+        # make sure all the udev events are there to be consumed by the failing call
+        run_command("udevadm settle")
+
+        # refreshing testVG2 fails, testVG may or may not be refreshed before that
+        with fake_utils("tests/fake_utils/lvm_fail_vg/"):
+            with self.assertRaises(GLib.GError):
+                BlockDev.lvm_watcher_process(watcher, 0)
+        vg_names = [vg.name for vg in BlockDev.lvm_watcher_get_vgs(watcher)]
+        self.assertNotIn("testVG", vg_names)
+        self.assertNotIn("testVG2", vg_names)
+
+        # no new udev events, both VGs are reported by the next call
+        events = BlockDev.lvm_watcher_process(watcher, 0)
+        seen = {(event.type, event.vg_name) for event in events}
+        self.assertIn((BlockDev.LVMEventType.VG_ADDED, "testVG"), seen)
+        self.assertIn((BlockDev.LVMEventType.VG_ADDED, "testVG2"), seen)
+
+        vg_names = [vg.name for vg in BlockDev.lvm_watcher_get_vgs(watcher)]
+        self.assertIn("testVG", vg_names)
+        self.assertIn("testVG2", vg_names)
+
+    def test_query_fields(self):
+        """Verify that it's possible to query only some fields of PVs, VGs and LVs"""
+
+        succ = BlockDev.lvm_pvcreate(self.loop_dev, 0, 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_vgcreate("testVG", [self.loop_dev], 0, None)
+        self.assertTrue(succ)
+
+        succ = BlockDev.lvm_lvcreate("testVG", "testLV", 12 * 1024**2, None, [self.loop_dev], None)
+        self.assertTrue(succ)
+
+        # names and UUIDs only
+        pvs = BlockDev.lvm_pvs_with_fields(BlockDev.LVMQueryFields.BASIC)
+        pv = next(pv for pv in pvs if pv.pv_name == self.loop_dev)
+        self.assertTrue(pv.pv_uuid)
+        self.assertEqual(pv.pv_size, 0)
+        self.assertIsNone(pv.vg_name)
+
+        pvs = BlockDev.lvm_pvs_with_fields(BlockDev.LVMQueryFields.VG)
+        pv = next(pv for pv in pvs if pv.pv_name == self.loop_dev)
+        self.assertEqual(pv.vg_name, "testVG")
+        self.assertEqual(pv.pv_size, 0)
+
+        vgs = BlockDev.lvm_vgs_with_fields(BlockDev.LVMQueryFields.SIZE)
+        vg = next(vg for vg in vgs if vg.name == "testVG")
+        self.assertTrue(vg.uuid)
+        self.assertGreater(vg.size, 0)
+        self.assertEqual(vg.pv_count, 0)
+
+        # no device-mapper status
+        lvs = BlockDev.lvm_lvs_with_fields("testVG", BlockDev.LVMQueryFields.SIZE)
+        self.assertEqual(len(lvs), 1)
+        self.assertEqual(lvs[0].lv_name, "testLV")
+        self.assertEqual(lvs[0].vg_name, "testVG")
+        self.assertTrue(lvs[0].uuid)
+        self.assertEqual(lvs[0].size, 12 * 1024**2)
+        self.assertIsNone(lvs[0].attr)
+        self.assertIsNone(lvs[0].segtype)
+
+        lvs = BlockDev.lvm_lvs_with_fields("testVG", BlockDev.LVMQueryFields.SIZE | BlockDev.LVMQueryFields.ATTRS | BlockDev.LVMQueryFields.TAGS)
+        self.assertEqual(len(lvs), 1)
+        self.assertEqual(lvs[0].segtype, "linear")
+        self.assertTrue(lvs[0].attr)
+
+        # segments are always there in the tree variant
+        lvs = BlockDev.lvm_lvs_tree_with_fields("testVG", BlockDev.LVMQueryFields.BASIC)
+        self.assertEqual(len(lvs), 1)
+        self.assertEqual(lvs[0].segtype, "linear")
+        self.assertEqual(lvs[0].size, 0)
+        self.assertEqual(len(lvs[0].segs), 1)
+        self.assertEqual(lvs[0].segs[0].pvdev, self.loop_dev)
+
+        # everything is the same as without the fields
+        lvs = BlockDev.lvm_lvs_with_fields("testVG", BlockDev.LVMQueryFields.ALL)
+        info = BlockDev.lvm_lvinfo("testVG", "testLV")
+        self.assertEqual(lvs[0].attr, info.attr)
+        self.assertEqual(lvs[0].roles, info.roles)
+
 
 class LvmCLITestLVcreateType(_lvm_cases.LvmTestLVcreateType, LvmTestCase):
     @classmethod
@@ -0,0 +1,130 @@
+#!/usr/bin/python3
+
+"""A minimal mock of the lvmdbusd service
+
+Only the parts of the API needed to test the job handling in the lvm-dbus
+plugin are implemented: the Manager object with the 'Version' property and the
+'PvScan' method which always starts a job. The job runs for JOB_TIME seconds
+(can be changed with the first command line argument), reports progress in
+PROGRESS_STEPS steps and announces all changes with the PropertiesChanged
+signal just like lvmdbusd does.
+
+The service connects to the bus specified by DBUS_SYSTEM_BUS_ADDRESS.
+"""
+
+import os
+import sys
+
+import gi
+gi.require_version('GLib', '2.0')
+gi.require_version('Gio', '2.0')
+from gi.repository import GLib, Gio
+
+BUS_NAME = "com.redhat.lvmdbus1"
+MANAGER_OBJ = "/com/redhat/lvmdbus1/Manager"
+JOB_OBJ_PREFIX = "/com/redhat/lvmdbus1/Job/"
+MANAGER_INTF = "com.redhat.lvmdbus1.Manager"
+JOB_INTF = "com.redhat.lvmdbus1.Job"
+
+JOB_TIME = 0.1
+PROGRESS_STEPS = 4
+
+NODE_INFO = Gio.DBusNodeInfo.new_for_xml("""
+<node>
+  <interface name="com.redhat.lvmdbus1.Manager">
+    <property name="Version" type="s" access="read"/>
+    <method name="PvScan">
+      <arg name="activate" type="b" direction="in"/>
+      <arg name="cache" type="b" direction="in"/>
+      <arg name="device_paths" type="as" direction="in"/>
+      <arg name="major_minors" type="a(ii)" direction="in"/>
+      <arg name="tmo" type="i" direction="in"/>
+      <arg name="scan_options" type="a{sv}" direction="in"/>
+      <arg name="job" type="o" direction="out"/>
+    </method>
+  </interface>
+  <interface name="com.redhat.lvmdbus1.Job">
+    <property name="Percent" type="d" access="read"/>
+    <property name="Complete" type="b" access="read"/>
+    <property name="Result" type="o" access="read"/>
+    <property name="GetError" type="(is)" access="read"/>
+    <method name="Remove"/>
+  </interface>
+</node>
+""")
+
+
+class Job():
+    def __init__(self, conn, num, job_time):
+        self.conn = conn
+        self.path = JOB_OBJ_PREFIX + str(num)
+        self.percent = 0.0
+        self.complete = False
+        self.reg_id = conn.register_object(self.path, NODE_INFO.lookup_interface(JOB_INTF),
+                                           self._method_call, self._get_property, None)
+        GLib.timeout_add(int(job_time * 1000 / PROGRESS_STEPS), self._step)
+
+    def _step(self):
+        self.percent += 100.0 / PROGRESS_STEPS
+        changed = {"Percent": GLib.Variant("d", self.percent)}
+        if self.percent >= 100.0:
+            self.complete = True
+            changed["Complete"] = GLib.Variant("b", True)
+        self.conn.emit_signal(None, self.path, "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                              GLib.Variant("(sa{sv}as)", (JOB_INTF, changed, [])))
+        return not self.complete
+
+    def _get_property(self, _conn, _sender, _path, _iface, prop):
+        if prop == "Percent":
+            return GLib.Variant("d", self.percent)
+        elif prop == "Complete":
+            return GLib.Variant("b", self.complete)
+        elif prop == "Result":
+            return GLib.Variant("o", "/")
+        elif prop == "GetError":
+            return GLib.Variant("(is)", (0, ""))
+        return None
+
+    def _method_call(self, conn, _sender, _path, _iface, method, _params, invocation):
+        if method == "Remove":
+            conn.unregister_object(self.reg_id)
+            invocation.return_value(None)
+
+
+class Manager():
+    def __init__(self, conn, job_time):
+        self.conn = conn
+        self.job_time = job_time
+        self.jobs = []
+        conn.register_object(MANAGER_OBJ, NODE_INFO.lookup_interface(MANAGER_INTF),
+                             self._method_call, self._get_property, None)
+
+    def _get_property(self, _conn, _sender, _path, _iface, prop):
+        if prop == "Version":
+            return GLib.Variant("s", "1.1.0")
+        return None
+
+    def _method_call(self, conn, _sender, _path, _iface, method, _params, invocation):
+        if method == "PvScan":
+            job = Job(conn, len(self.jobs), self.job_time)
+            self.jobs.append(job)
+            invocation.return_value(GLib.Variant("(o)", (job.path,)))
+
+
+def main():
+    job_time = float(sys.argv[1]) if len(sys.argv) > 1 else JOB_TIME
+    loop = GLib.MainLoop()
+
+    conn = Gio.DBusConnection.new_for_address_sync(os.environ["DBUS_SYSTEM_BUS_ADDRESS"],
+                                                   Gio.DBusConnectionFlags.AUTHENTICATION_CLIENT |
+                                                   Gio.DBusConnectionFlags.MESSAGE_BUS_CONNECTION,
+                                                   None, None)
+    _manager = Manager(conn, job_time)
+
+    Gio.bus_own_name_on_connection(conn, BUS_NAME, Gio.BusNameOwnerFlags.NONE, None,
+                                   lambda *args: loop.quit())
+    loop.run()
+
+
+if __name__ == "__main__":
+    main()
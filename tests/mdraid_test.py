@@ -78,6 +78,26 @@ class MDNoDevTestCase(MDTest):
         with self.assertRaisesRegex(GLib.GError, r'malformed or invalid'):
             BlockDev.md_canonicalize_uuid("malformed-uuid-example")
 
+    @tag_test(TestTags.NOSTORAGE)
+    def test_tracing(self):
+        """Verify that calls of plugin functions are recorded when tracing"""
+
+        self.addCleanup(BlockDev.utils_set_tracing, False)
+        BlockDev.utils_trace_dump()
+        BlockDev.utils_set_tracing(True)
+
+        BlockDev.md_canonicalize_uuid("3386ff85:f5012621:4a435f06:1eb47236")
+        with self.assertRaises(GLib.GError):
+            BlockDev.md_canonicalize_uuid("malformed-uuid-example")
+
+        events, _dropped = BlockDev.utils_trace_dump()
+        events = [ev for ev in events if ev.function == "bd_md_canonicalize_uuid"]
+        self.assertEqual(len(events), 2)
+        self.assertEqual(events[0].plugin, "mdraid")
+        self.assertEqual(events[0].exit_code, 0)
+        self.assertEqual(events[1].exit_code, -1)
+        self.assertLess(events[0].task_id, events[1].task_id)
+
     @tag_test(TestTags.NOSTORAGE)
     def test_get_md_uuid(self):
         """Verify that getting UUID in MD RAID format works as expected"""
@@ -2,13 +2,17 @@ import unittest
 import re
 import os
 import glob
+import time
+import shutil
+import tempfile
 import overrides_hack
 from utils import fake_utils, create_sparse_tempfile, create_lio_device, delete_lio_device, run_command, TestTags, tag_test, read_file
 
 import gi
 gi.require_version('GLib', '2.0')
+gi.require_version('Gio', '2.0')
 gi.require_version('BlockDev', '3.0')
-from gi.repository import GLib, BlockDev
+from gi.repository import GLib, Gio, BlockDev
 
 
 class UtilsTestCase(unittest.TestCase):
@@ -143,6 +147,59 @@ class UtilsExecLoggingTest(UtilsTestCase):
         BlockDev.utils_log(BlockDev.UTILS_LOG_INFO, "info message")
         self.assertIn("info message", self.log)
 
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_tracing(self):
+        """Verify that recording trace events works as expected"""
+
+        self.addCleanup(BlockDev.utils_set_tracing, False)
+
+        # throw away whatever was recorded before
+        BlockDev.utils_trace_dump()
+
+        # nothing recorded with tracing disabled (the default)
+        self.assertFalse(BlockDev.utils_get_tracing())
+        BlockDev.utils_exec_and_report_error(["true"])
+        events, dropped = BlockDev.utils_trace_dump()
+        self.assertEqual(events, [])
+        self.assertEqual(dropped, 0)
+
+        BlockDev.utils_set_tracing(True)
+        self.assertTrue(BlockDev.utils_get_tracing())
+
+        BlockDev.utils_exec_and_report_error(["true"])
+        with self.assertRaises(GLib.GError):
+            BlockDev.utils_exec_and_report_error(["/bin/false"])
+        BlockDev.utils_trace_record(42, "plugin", "function", 10, 20, 0)
+
+        events, dropped = BlockDev.utils_trace_dump()
+        self.assertEqual(dropped, 0)
+        self.assertEqual(len(events), 3)
+
+        # ordered by start time
+        self.assertEqual(events[0].task_id, 42)
+        self.assertEqual(events[0].plugin, "plugin")
+        self.assertEqual(events[0].function, "function")
+        self.assertEqual((events[0].start_time, events[0].end_time), (10, 20))
+
+        self.assertEqual(events[1].plugin, "utils")
+        self.assertEqual(events[1].function, "true")
+        self.assertEqual(events[1].exit_code, 0)
+        self.assertLessEqual(events[1].start_time, events[1].end_time)
+        self.assertEqual(events[2].function, "false")
+        self.assertEqual(events[2].exit_code, 1)
+        self.assertLess(events[1].task_id, events[2].task_id)
+
+        # events are removed by the dump
+        events, dropped = BlockDev.utils_trace_dump()
+        self.assertEqual(events, [])
+
+        # full buffer -> new events are dropped
+        for i in range(BlockDev.UTILS_TRACE_RING_SIZE + 10):
+            BlockDev.utils_trace_record(i, "plugin", "function", i, i, 0)
+        events, dropped = BlockDev.utils_trace_dump()
+        self.assertEqual(len(events), BlockDev.UTILS_TRACE_RING_SIZE)
+        self.assertEqual(dropped, 10)
+
     @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
     def test_version_cmp(self):
         """Verify that version comparison works as expected"""
@@ -220,6 +277,68 @@ class UtilsExecLoggingTest(UtilsTestCase):
             # exit code != 0
             self.assertTrue(BlockDev.utils_check_util_version("libblockdev-fake-util-fail", "1.1", "version", "Version:\\s(.*)"))
 
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_util_version_cache(self):
+        """Verify that caching utility versions works as expected"""
+
+        self.assertIsNone(BlockDev.utils_get_version_cache_dir())
+
+        tmp_dir = tempfile.mkdtemp(prefix="libblockdev.", suffix="utils_test")
+        self.addCleanup(shutil.rmtree, tmp_dir)
+        cache_dir = os.path.join(tmp_dir, "cache")
+        util_dir = os.path.join(tmp_dir, "utils")
+        os.mkdir(util_dir)
+        util = os.path.join(util_dir, "libblockdev-fake-util")
+        with open(util, "w") as f:
+            f.write("#!/bin/sh\necho 1.2.3\n")
+        os.chmod(util, 0o755)
+
+        self.addCleanup(BlockDev.utils_set_version_cache_dir, None)
+        self.assertTrue(BlockDev.utils_set_version_cache_dir(cache_dir))
+        self.assertEqual(BlockDev.utils_get_version_cache_dir(), cache_dir)
+
+        with fake_utils(util_dir):
+            self.assertTrue(BlockDev.utils_check_util_version("libblockdev-fake-util", "1.2", None, None))
+            self.assertEqual(len(os.listdir(cache_dir)), 1)
+
+            # same size and mtime -> cached version should be used
+            st = os.stat(util)
+            with open(util, "w") as f:
+                f.write("#!/bin/sh\necho 0.0.1\n")
+            os.utime(util, ns=(st.st_atime_ns, st.st_mtime_ns))
+            self.assertTrue(BlockDev.utils_check_util_version("libblockdev-fake-util", "1.2", None, None))
+
+            # different mtime -> the utility needs to be run again
+            os.utime(util, ns=(st.st_atime_ns, st.st_mtime_ns + 1000000000))
+            with self.assertRaisesRegex(GLib.GError, r"Too low version"):
+                BlockDev.utils_check_util_version("libblockdev-fake-util", "1.2", None, None)
+
+            # cached entries are only used if the cache directory is still safe
+            entry = os.path.join(cache_dir, os.listdir(cache_dir)[0])
+            with open(entry, "r") as f:
+                data = f.read()
+            with open(entry, "w") as f:
+                f.write(data.replace("Output=0.0.1", "Output=1.2.3"))
+            self.assertTrue(BlockDev.utils_check_util_version("libblockdev-fake-util", "1.2", None, None))
+            os.chmod(cache_dir, 0o777)
+            with self.assertRaisesRegex(GLib.GError, r"Too low version"):
+                BlockDev.utils_check_util_version("libblockdev-fake-util", "1.2", None, None)
+            os.chmod(cache_dir, 0o700)
+
+            # output of failed runs is not cached
+            fail_util = os.path.join(util_dir, "libblockdev-fake-util-fail")
+            with open(fail_util, "w") as f:
+                f.write("#!/bin/sh\necho Version: 1.2.3\nexit 1\n")
+            os.chmod(fail_util, 0o755)
+            n_entries = len(os.listdir(cache_dir))
+            self.assertTrue(BlockDev.utils_check_util_version("libblockdev-fake-util-fail", "1.2", None, "Version:\\s(.*)"))
+            self.assertEqual(len(os.listdir(cache_dir)), n_entries)
+
+        # cache directory writable by others is refused
+        os.chmod(cache_dir, 0o777)
+        with self.assertRaises(GLib.GError):
+            BlockDev.utils_set_version_cache_dir(cache_dir)
+
     @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
     def test_exec_locale(self):
         """Verify that setting locale for exec functions works as expected"""
@@ -274,6 +393,115 @@ class UtilsExecLoggingTest(UtilsTestCase):
         self.assertEqual(len(out), 0)
         self.assertGreater(len(stderr), cnt)
 
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_exec_spawn(self):
+        """Verify that spawning processes works as expected"""
+
+        with self.assertRaisesRegex(GLib.GError, r"Failed to execute child process"):
+            BlockDev.utils_exec_and_report_error(["libblockdev-no-such-util"])
+
+        with self.assertRaisesRegex(GLib.GError, r"Failed to execute child process"):
+            BlockDev.utils_exec_and_capture_output_no_progress(["libblockdev-no-such-util"])
+
+        # stdin of the process should be /dev/null
+        succ, out = BlockDev.utils_exec_and_capture_output(["bash", "-c", "cat; echo done"])
+        self.assertTrue(succ)
+        self.assertEqual(out, "done\n")
+
+        # no FDs other than stdin, stdout and stderr should be inherited
+        fd = os.open("/dev/null", os.O_RDONLY)
+        os.set_inheritable(fd, True)
+        self.addCleanup(os.close, fd)
+        succ, out = BlockDev.utils_exec_and_capture_output(["bash", "-c", "[ -e /proc/self/fd/%d ] && echo leaked || echo ok" % fd])
+        self.assertTrue(succ)
+        self.assertEqual(out, "ok\n")
+
+        # background children keeping stdout open shouldn't block us
+        start = time.time()
+        succ, out = BlockDev.utils_exec_and_capture_output(["bash", "-c", "sleep 10 & echo hi"])
+        self.assertTrue(succ)
+        self.assertEqual(out, "hi\n")
+        self.assertLess(time.time() - start, 5)
+
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_exec_timeout(self):
+        """Verify that timeout for exec functions works as expected"""
+
+        self.addCleanup(BlockDev.utils_set_exec_timeout_thread, 0)
+        BlockDev.utils_set_exec_timeout_thread(500)
+        self.assertEqual(BlockDev.utils_get_exec_timeout_thread(), 500)
+
+        # fast enough
+        succ = BlockDev.utils_exec_and_report_error(["true"])
+        self.assertTrue(succ)
+
+        start = time.time()
+        with self.assertRaisesRegex(GLib.GError, r"didn't finish within 500 ms"):
+            BlockDev.utils_exec_and_report_error(["bash", "-c", "sleep 30; echo done"])
+        self.assertLess(time.time() - start, 5)
+
+        with self.assertRaisesRegex(GLib.GError, r"didn't finish within 500 ms"):
+            BlockDev.utils_exec_and_capture_output_no_progress(["sleep", "30"])
+
+        # SIGTERM ignored, should be killed after the grace period
+        start = time.time()
+        with self.assertRaisesRegex(GLib.GError, r"didn't finish within 500 ms"):
+            BlockDev.utils_exec_and_capture_output(["bash", "-c", "trap '' TERM; sleep 30"])
+        self.assertLess(time.time() - start, 15)
+
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_exec_stream_output(self):
+        """Verify that streaming output line by line works as expected"""
+
+        lines = []
+        succ = BlockDev.utils_exec_and_stream_output(["bash", "-c", "echo line1; echo line2 >&2; printf 'line3\\nline4'"],
+                                                     None, lines.append)
+        self.assertTrue(succ)
+        self.assertEqual(lines, ["line1\n", "line3\n", "line4"])
+
+        # no output is not an error here
+        lines = []
+        succ = BlockDev.utils_exec_and_stream_output(["true"], None, lines.append)
+        self.assertTrue(succ)
+        self.assertEqual(lines, [])
+
+        # lines should be processed even if the process eventually fails
+        lines = []
+        with self.assertRaisesRegex(GLib.GError, r"Process reported exit code 1"):
+            BlockDev.utils_exec_and_stream_output(["bash", "-c", "echo out; exit 1"], None, lines.append)
+        self.assertEqual(lines, ["out\n"])
+
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_exec_stats(self):
+        """Verify that execution statistics are collected"""
+
+        BlockDev.utils_reset_exec_stats()
+        self.assertEqual(BlockDev.utils_get_exec_stats(), [])
+
+        for _i in range(3):
+            BlockDev.utils_exec_and_report_error(["true"])
+        with self.assertRaises(GLib.GError):
+            BlockDev.utils_exec_and_report_error(["false"])
+        BlockDev.utils_exec_and_capture_output(["/bin/echo", "hello"])
+
+        stats = {s.util: s for s in BlockDev.utils_get_exec_stats()}
+        self.assertEqual(set(stats.keys()), {"true", "false", "echo"})
+
+        self.assertEqual(stats["true"].runs, 3)
+        self.assertEqual(stats["true"].failures, 0)
+        self.assertEqual(sum(stats["true"].histogram), 3)
+        self.assertGreaterEqual(stats["true"].total_time, stats["true"].max_time)
+
+        self.assertEqual(stats["false"].runs, 1)
+        self.assertEqual(stats["false"].failures, 1)
+
+        # path is stripped, output is counted
+        self.assertEqual(stats["echo"].runs, 1)
+        self.assertEqual(stats["echo"].output_size, len("hello\n"))
+
+        BlockDev.utils_reset_exec_stats()
+        self.assertEqual(BlockDev.utils_get_exec_stats(), [])
+
     EXEC_PROGRESS_MSG = "Aloha, I'm the progress line you should match."
 
     def my_exec_progress_func_concat(self, line):
@@ -406,6 +634,65 @@ class UtilsExecLoggingTest(UtilsTestCase):
         self.assertTrue(status)
 
 
+class UtilsExecAsyncTest(UtilsTestCase):
+
+    def _run_async(self, calls, cancellable=None, cancel_after=None):
+        loop = GLib.MainLoop()
+        results = [None] * len(calls)
+        pending = [len(calls)]
+
+        def _done(_source, res, data):
+            idx, finish = data
+            try:
+                results[idx] = finish(res)
+            except GLib.GError as e:
+                results[idx] = e
+            pending[0] -= 1
+            if pending[0] == 0:
+                loop.quit()
+
+        for idx, (start, finish, args) in enumerate(calls):
+            start(*args, cancellable, _done, (idx, finish))
+
+        if cancel_after is not None:
+            GLib.timeout_add(cancel_after, lambda: cancellable.cancel() and False)
+        loop.run()
+
+        return results
+
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_exec_async(self):
+        """Verify that asynchronous exec functions work as expected"""
+
+        ret = self._run_async([(BlockDev.utils_exec_and_report_error_async, BlockDev.utils_exec_and_report_error_finish, (["true"], None)),
+                               (BlockDev.utils_exec_and_report_error_async, BlockDev.utils_exec_and_report_error_finish, (["false"], None)),
+                               (BlockDev.utils_exec_and_capture_output_async, BlockDev.utils_exec_and_capture_output_finish, (["echo", "hi"], None)),
+                               (BlockDev.utils_exec_and_report_progress_async, BlockDev.utils_exec_and_report_progress_finish, (["bash", "-c", "exit 0"], None, None))])
+        self.assertTrue(ret[0])
+        self.assertIsInstance(ret[1], GLib.GError)
+        self.assertIn("Process reported exit code 1", str(ret[1]))
+        self.assertEqual(ret[2], (True, "hi\n"))
+        self.assertEqual(ret[3], (True, 0))
+
+        # all processes should run in parallel
+        start = time.time()
+        ret = self._run_async([(BlockDev.utils_exec_and_report_error_async, BlockDev.utils_exec_and_report_error_finish, (["sleep", "2"], None))] * 5)
+        self.assertTrue(all(ret))
+        self.assertLess(time.time() - start, 8)
+
+    @tag_test(TestTags.NOSTORAGE, TestTags.CORE)
+    def test_exec_async_cancel(self):
+        """Verify that asynchronous exec functions can be cancelled"""
+
+        cancellable = Gio.Cancellable()
+        start = time.time()
+        ret = self._run_async([(BlockDev.utils_exec_and_report_error_async, BlockDev.utils_exec_and_report_error_finish, (["bash", "-c", "sleep 30; echo done"], None))],
+                              cancellable=cancellable, cancel_after=500)
+        self.assertLess(time.time() - start, 10)
+        self.assertIsInstance(ret[0], GLib.GError)
+        self.assertTrue(ret[0].matches(Gio.io_error_quark(), Gio.IOErrorEnum.CANCELLED))
+
+
 class UtilsStorageTestCase(UtilsTestCase):
     def setUp(self):
         self.addCleanup(self._clean_up)
@@ -9,7 +9,8 @@
 
 void print_usage (const char *cmd) {
     fprintf (stderr,
-             "Usage: %s CACHED_LV [CACHED_LV2...]\n"
+             "Usage: %s LV [LV2...]\n"
+             "Prints stats of cached (dm-cache or dm-writecache) and RAID LVs.\n"
              "-h    --help   Print this usage info\n"
              "-j    --json   Print stats as JSON\n"
              "Options need to be specified before LVs.\n",
@@ -24,15 +25,17 @@ void print_size (guint64 bytes, gboolean newline) {
     bs_size_free (size);
 }
 
+/* 0 if @total is 0 so that neither nan nor inf is ever printed */
+double get_ratio (guint64 part, guint64 total) {
+    return total > 0 ? (double) part / total : 0.0;
+}
+
 void print_ratio (guint64 part, guint64 total, gboolean space, gboolean newline) {
-    float percent = ((float) part / total) * 100;
+    double percent = get_ratio (part, total) * 100;
     printf ("%s[%6.2f%%]%s", space ? " " : "", percent, newline ? "\n" : "");
 }
 
-gboolean print_lv_stats (const char *vg_name, const char *lv_name, GError **error) {
-    BDLVMLVdata *lv_data = bd_lvm_lvinfo (vg_name, lv_name, error);
-    if (!lv_data)
-        return FALSE;
+gboolean print_cache_stats (const char *vg_name, const char *lv_name, BDLVMLVdata *lv_data, GError **error) {
     BDLVMCacheStats *stats = bd_lvm_cache_stats (vg_name, lv_name, error);
     if (!stats)
         return FALSE;
@@ -47,16 +50,68 @@ gboolean print_lv_stats (const char *vg_name, const char *lv_name, GError **erro
     printf ("  write misses: %10"G_GUINT64_FORMAT"\n", stats->write_misses);
     printf ("  write hits:   %10"G_GUINT64_FORMAT, stats->write_hits); print_ratio (stats->write_hits, stats->write_hits + stats->write_misses, TRUE, TRUE);
 
-    bd_lvm_lvdata_free (lv_data);
     bd_lvm_cache_stats_free (stats);
 
     return TRUE;
 }
 
-gboolean print_lv_stats_json(const char *vg_name, const char *lv_name, GError **error) {
+gboolean print_writecache_stats (const char *vg_name, const char *lv_name, BDLVMLVdata *lv_data, GError **error) {
+    BDLVMWritecacheStats *stats = bd_lvm_writecache_stats (vg_name, lv_name, error);
+    if (!stats)
+        return FALSE;
+
+    printf ("%s/%s:\n", vg_name, lv_name);
+    printf ("  mode:      %13s\n", "writecache");
+    printf ("  state:     %13s\n", stats->error ? "error" : "ok");
+    printf ("  LV size:      "); print_size (lv_data->size, TRUE);
+    printf ("  cache size:   "); print_size (stats->cache_size, FALSE); print_ratio (stats->cache_size, lv_data->size, TRUE, TRUE);
+    printf ("  cache used:   "); print_size (stats->cache_used, FALSE); print_ratio (stats->cache_used, stats->cache_size, TRUE, TRUE);
+    printf ("  total blocks: %10"G_GUINT64_FORMAT"\n", stats->total_blocks);
+    printf ("  free blocks:  %10"G_GUINT64_FORMAT, stats->free_blocks); print_ratio (stats->free_blocks, stats->total_blocks, TRUE, TRUE);
+    printf ("  writeback:    %10"G_GUINT64_FORMAT, stats->writeback_blocks); print_ratio (stats->writeback_blocks, stats->total_blocks, TRUE, TRUE);
+
+    bd_lvm_writecache_stats_free (stats);
+
+    return TRUE;
+}
+
+gboolean print_raid_stats (const char *vg_name, const char *lv_name, BDLVMLVdata *lv_data, GError **error) {
+    BDLVMRAIDStats *stats = bd_lvm_raid_stats (vg_name, lv_name, error);
+    if (!stats)
+        return FALSE;
+
+    printf ("%s/%s:\n", vg_name, lv_name);
+    printf ("  type:      %13s\n", stats->raid_type);
+    printf ("  LV size:      "); print_size (lv_data->size, TRUE);
+    printf ("  health:    %13s\n", stats->dev_health);
+    printf ("  action:    %13s\n", stats->sync_action);
+    printf ("  in sync:      %10"G_GUINT64_FORMAT, stats->insync_regions); print_ratio (stats->insync_regions, stats->total_regions, TRUE, TRUE);
+    printf ("  mismatches:   %10"G_GUINT64_FORMAT"\n", stats->mismatch_count);
+
+    bd_lvm_raid_stats_free (stats);
+
+    return TRUE;
+}
+
+gboolean print_lv_stats (const char *vg_name, const char *lv_name, GError **error) {
+    gboolean ret = FALSE;
     BDLVMLVdata *lv_data = bd_lvm_lvinfo (vg_name, lv_name, error);
     if (!lv_data)
         return FALSE;
+
+    if (g_strcmp0 (lv_data->segtype, "writecache") == 0)
+        ret = print_writecache_stats (vg_name, lv_name, lv_data, error);
+    else if (lv_data->segtype && g_str_has_prefix (lv_data->segtype, "raid"))
+        ret = print_raid_stats (vg_name, lv_name, lv_data, error);
+    else
+        ret = print_cache_stats (vg_name, lv_name, lv_data, error);
+
+    bd_lvm_lvdata_free (lv_data);
+
+    return ret;
+}
+
+gboolean print_cache_stats_json (const char *vg_name, const char *lv_name, BDLVMLVdata *lv_data, GError **error) {
     BDLVMCacheStats *stats = bd_lvm_cache_stats (vg_name, lv_name, error);
     if (!stats)
         return FALSE;
@@ -66,23 +121,84 @@ gboolean print_lv_stats_json(const char *vg_name, const char *lv_name, GError **
     printf ("  \"mode\": \"%s\",\n", bd_lvm_cache_get_mode_str (stats->mode, error)); /* ignoring 'error', must be a valid mode */
     printf ("  \"lv-size\": %"G_GUINT64_FORMAT",\n", lv_data->size);
     printf ("  \"cache-size\": %"G_GUINT64_FORMAT",\n", stats->cache_size);
-    printf ("  \"cache-size-pct\": %0.2f,\n", (double) stats->cache_size / lv_data->size);
-    printf ("  \"cache-used\": %"G_GUINT64_FORMAT",\n", stats->cache_size);
-    printf ("  \"cache-used-pct\": %0.2f,\n", (double) stats->cache_used / stats->cache_size);
+    printf ("  \"cache-size-pct\": %0.2f,\n", 100.0 * get_ratio (stats->cache_size, lv_data->size));
+    printf ("  \"cache-used\": %"G_GUINT64_FORMAT",\n", stats->cache_used);
+    printf ("  \"cache-used-pct\": %0.2f,\n", 100.0 * get_ratio (stats->cache_used, stats->cache_size));
     printf ("  \"read-misses\": %"G_GUINT64_FORMAT",\n", stats->read_misses);
     printf ("  \"read-hits\": %"G_GUINT64_FORMAT",\n", stats->read_hits);
-    printf ("  \"read-hit-ratio\": %0.2f,\n", (double)stats->read_hits / (stats->read_hits + stats->read_misses));
+    printf ("  \"read-hit-ratio\": %0.2f,\n", get_ratio (stats->read_hits, stats->read_hits + stats->read_misses));
     printf ("  \"write-misses\": %"G_GUINT64_FORMAT",\n", stats->write_misses);
     printf ("  \"write-hits\": %"G_GUINT64_FORMAT",\n", stats->write_hits);
-    printf ("  \"write-hit-ratio\": %0.2f\n", (double)stats->write_hits / (stats->write_hits + stats->write_misses));
+    printf ("  \"write-hit-ratio\": %0.2f\n", get_ratio (stats->write_hits, stats->write_hits + stats->write_misses));
     printf ("}\n");
 
-    bd_lvm_lvdata_free (lv_data);
     bd_lvm_cache_stats_free (stats);
 
     return TRUE;
 }
 
+gboolean print_writecache_stats_json (const char *vg_name, const char *lv_name, BDLVMLVdata *lv_data, GError **error) {
+    BDLVMWritecacheStats *stats = bd_lvm_writecache_stats (vg_name, lv_name, error);
+    if (!stats)
+        return FALSE;
+
+    printf ("{\n");
+    printf ("  \"lv\": \"%s/%s\",\n", vg_name, lv_name);
+    printf ("  \"mode\": \"writecache\",\n");
+    printf ("  \"error\": %"G_GUINT64_FORMAT",\n", stats->error);
+    printf ("  \"lv-size\": %"G_GUINT64_FORMAT",\n", lv_data->size);
+    printf ("  \"cache-size\": %"G_GUINT64_FORMAT",\n", stats->cache_size);
+    printf ("  \"cache-used\": %"G_GUINT64_FORMAT",\n", stats->cache_used);
+    printf ("  \"cache-used-pct\": %0.2f,\n", 100.0 * get_ratio (stats->cache_used, stats->cache_size));
+    printf ("  \"total-blocks\": %"G_GUINT64_FORMAT",\n", stats->total_blocks);
+    printf ("  \"free-blocks\": %"G_GUINT64_FORMAT",\n", stats->free_blocks);
+    printf ("  \"writeback-blocks\": %"G_GUINT64_FORMAT"\n", stats->writeback_blocks);
+    printf ("}\n");
+
+    bd_lvm_writecache_stats_free (stats);
+
+    return TRUE;
+}
+
+gboolean print_raid_stats_json (const char *vg_name, const char *lv_name, BDLVMLVdata *lv_data, GError **error) {
+    BDLVMRAIDStats *stats = bd_lvm_raid_stats (vg_name, lv_name, error);
+    if (!stats)
+        return FALSE;
+
+    printf ("{\n");
+    printf ("  \"lv\": \"%s/%s\",\n", vg_name, lv_name);
+    printf ("  \"type\": \"%s\",\n", stats->raid_type);
+    printf ("  \"lv-size\": %"G_GUINT64_FORMAT",\n", lv_data->size);
+    printf ("  \"dev-count\": %"G_GUINT64_FORMAT",\n", stats->dev_count);
+    printf ("  \"dev-health\": \"%s\",\n", stats->dev_health);
+    printf ("  \"sync-action\": \"%s\",\n", stats->sync_action);
+    printf ("  \"sync-ratio\": %0.2f,\n", stats->sync_ratio);
+    printf ("  \"mismatch-count\": %"G_GUINT64_FORMAT"\n", stats->mismatch_count);
+    printf ("}\n");
+
+    bd_lvm_raid_stats_free (stats);
+
+    return TRUE;
+}
+
+gboolean print_lv_stats_json (const char *vg_name, const char *lv_name, GError **error) {
+    gboolean ret = FALSE;
+    BDLVMLVdata *lv_data = bd_lvm_lvinfo (vg_name, lv_name, error);
+    if (!lv_data)
+        return FALSE;
+
+    if (g_strcmp0 (lv_data->segtype, "writecache") == 0)
+        ret = print_writecache_stats_json (vg_name, lv_name, lv_data, error);
+    else if (lv_data->segtype && g_str_has_prefix (lv_data->segtype, "raid"))
+        ret = print_raid_stats_json (vg_name, lv_name, lv_data, error);
+    else
+        ret = print_cache_stats_json (vg_name, lv_name, lv_data, error);
+
+    bd_lvm_lvdata_free (lv_data);
+
+    return ret;
+}
+
 int main (int argc, char *argv[]) {
     gboolean ret = FALSE;
     GError *error = NULL;
@@ -102,7 +218,7 @@ int main (int argc, char *argv[]) {
     }
 
     if (first_lv_arg >= argc) {
-        fprintf (stderr, "No cached LV to get the stats for specified!\n");
+        fprintf (stderr, "No LV to get the stats for specified!\n");
         print_usage (argv[0]);
         return 1;
     }